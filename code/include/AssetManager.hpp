@@ -0,0 +1,269 @@
+#ifndef ASSET_MANAGER_HPP
+#define ASSET_MANAGER_HPP
+
+/**@file
+ * @brief Shared cache of the meshes and textures loaded from the disk.
+ *
+ * Several renderables use the same assets (the instanced renderables of the
+ * trees and of the carrots, the 2D boid renderables, ...). This file defines
+ * an asset manager that decodes each file once and hands out shared handles
+ * on the resulting CPU or GPU data.
+ *
+ * The decoding of the images and the parsing of the meshes are performed by
+ * a pool of worker threads, so that they do not delay the first frame. The
+ * decoded images are then sent to the GPU by the main thread, the one owning
+ * the OpenGL context, through AssetManager::processUploads().
+ *
+ * Textures may also be loaded from KTX containers (see texturing/KtxFile.hpp),
+ * which hold every mip map level, possibly compressed, in a single file.
+ */
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <glm/glm.hpp>
+
+/**
+ * @brief Mesh data read from an OBJ file.
+ *
+ * The content is the one filled by read_obj(). It is shared between every
+ * renderable built from the same file, hence it must not be modified.
+ */
+struct MeshData
+{
+    std::vector< glm::vec3 > positions; /*!< Vertex positions. */
+    std::vector< unsigned int > indices; /*!< Vertex indices of the faces. */
+    std::vector< glm::vec3 > normals; /*!< Vertex normals. */
+    std::vector< glm::vec2 > texCoords; /*!< Vertex texture coordinates. */
+};
+
+typedef std::shared_ptr<const MeshData> MeshDataPtr; /*!< Typedef for a smart pointer of MeshData */
+
+/**
+ * @brief How the texels of a texture are filtered.
+ */
+enum TextureFiltering
+{
+    NEAREST_FILTERING, /*!< Nearest texel of the base level, for the sprites and atlases. */
+    LINEAR_FILTERING, /*!< Bilinear filtering of the base level. */
+    TRILINEAR_FILTERING /*!< Trilinear filtering between the levels of a mip map chain. */
+};
+
+/**
+ * @brief A 2D texture, or a 2D texture array, stored on the GPU.
+ *
+ * The texture is deleted on the GPU when the last handle on it is released.
+ * While its images are still being decoded, a texture is not loaded and a
+ * 1x1 white placeholder is used instead.
+ */
+class Texture
+{
+public:
+    /**
+     * @brief Constructor of a texture which is not loaded yet.
+     * @param target GL_TEXTURE_2D or GL_TEXTURE_2D_ARRAY.
+     */
+    explicit Texture(unsigned int target);
+
+    /**
+     * @brief Constructor.
+     *
+     * Take the ownership of an already created texture.
+     *
+     * @param id The texture identifier on the GPU.
+     * @param width The width of the base level.
+     * @param height The height of the base level.
+     */
+    Texture(unsigned int id, unsigned int width, unsigned int height);
+
+    /**
+     * @brief Destructor, releases the texture on the GPU.
+     */
+    ~Texture();
+
+    /**
+     * @brief Getter for the texture identifier on the GPU.
+     *
+     * Must be called from the thread owning the OpenGL context.
+     *
+     * @return The identifier to use with glBindTexture, the one of the
+     * placeholder if the texture is not loaded yet.
+     */
+    unsigned int getId() const;
+
+    /**
+     * @brief Getter for the target to bind the texture to.
+     * @return GL_TEXTURE_2D or GL_TEXTURE_2D_ARRAY.
+     */
+    unsigned int getTarget() const;
+
+    /**
+     * @brief Tell whether the images of the texture are on the GPU.
+     * @return True if the texture is loaded.
+     */
+    bool isLoaded() const;
+
+    /**
+     * @brief Getter for the width of the base level.
+     * @return The width, in texels.
+     */
+    unsigned int getWidth() const;
+
+    /**
+     * @brief Getter for the height of the base level.
+     * @return The height, in texels.
+     */
+    unsigned int getHeight() const;
+
+private:
+    Texture(const Texture&);
+    Texture& operator=(const Texture&);
+
+    friend class AssetManager;
+
+    unsigned int m_id; /*!< Identifier of the texture on the GPU. */
+    unsigned int m_target; /*!< Target of the texture, GL_TEXTURE_2D or GL_TEXTURE_2D_ARRAY. */
+    unsigned int m_width; /*!< Width of the base level. */
+    unsigned int m_height; /*!< Height of the base level. */
+    bool m_loaded; /*!< True once the images have been sent to the GPU. */
+};
+
+typedef std::shared_ptr<Texture> TexturePtr; /*!< Typedef for a smart pointer of Texture */
+
+/**
+ * @brief Cache of the assets, indexed by their path.
+ *
+ * The cache only keeps weak references: an asset is loaded again if every
+ * handle on it has been released in the meantime. This way, the GPU
+ * resources are released with the renderables, while the OpenGL context is
+ * still alive.
+ */
+class AssetManager
+{
+public:
+    /**
+     * @brief Get the mesh stored in an OBJ file.
+     *
+     * The file is only parsed the first time it is requested. If it is
+     * being parsed by a worker thread, wait for the result.
+     *
+     * @param filename The path to the mesh file.
+     * @return The mesh data, nullptr if the file could not be read.
+     */
+    static MeshDataPtr getMesh(const std::string& filename);
+
+    /**
+     * @brief Start parsing an OBJ file on a worker thread.
+     *
+     * A later call to getMesh() with the same file will not parse it again.
+     *
+     * @param filename The path to the mesh file.
+     */
+    static void prefetchMesh(const std::string& filename);
+
+    /**
+     * @brief Get a texture loaded from an image file.
+     *
+     * The first time a file is requested, the image is decoded on a worker
+     * thread and the returned texture is not loaded: it is sent to the GPU
+     * later by processUploads(). It is stored with 8 bits per channel
+     * (GL_RGBA8, or GL_SRGB8_ALPHA8 if \a sRGB is set). With a trilinear
+     * filtering, a full mip map chain is generated by the GPU.
+     *
+     * A KTX file (".ktx" extension) is loaded as it is stored, with the
+     * mip map levels and the internal format of the file.
+     *
+     * Mip mapping blends the texels of neighbouring regions, so the atlases
+     * (e.g. the faces of the skybox) and the pixel art sprites should rather
+     * be sampled with a nearest filtering.
+     *
+     * @param filename The path to the image file.
+     * @param sRGB True if the texels are sRGB encoded colors, ignored for KTX files.
+     * @param filtering How the texels are filtered.
+     * @return The texture.
+     */
+    static TexturePtr getTexture(const std::string& filename, bool sRGB = false,
+                                 TextureFiltering filtering = TRILINEAR_FILTERING);
+
+    /**
+     * @brief Get a repeated texture built from a mip map chain of images.
+     *
+     * Each file holds a level of the mip map, starting by the finest one.
+     * As for getTexture(), the images are decoded on a worker thread.
+     *
+     * If the chain has been packed by texconvert in a KTX file named after
+     * the images without their level number ("grass.ktx" for "grass1.png",
+     * "grass2.png", ...), this file is loaded instead.
+     *
+     * @param filenames The paths to the images of the levels.
+     * @return The texture.
+     */
+    static TexturePtr getMipMapTexture(const std::vector<std::string>& filenames);
+
+    /**
+     * @brief Get a repeated 2D texture array stored in a KTX file.
+     *
+     * The texture is bound to GL_TEXTURE_2D_ARRAY and sampled with a
+     * sampler2DArray. The file is read on a worker thread.
+     *
+     * If the file does not exist, the array is built from the mip map
+     * chains given instead, one chain per layer. Every layer must have
+     * the same size.
+     *
+     * @param filename The path to the KTX file.
+     * @param chains The paths to the images of the levels of each layer,
+     * starting by the finest level.
+     * @return The texture array.
+     */
+    static TexturePtr getTextureArray(
+        const std::string& filename,
+        const std::vector< std::vector<std::string> >& chains = std::vector< std::vector<std::string> >()
+    );
+
+    /**
+     * @brief Send the decoded images to the GPU.
+     *
+     * Must be called regularly by the thread owning the OpenGL context
+     * (the Viewer does it before drawing each frame). The images are
+     * streamed through pixel buffer objects.
+     *
+     * @param maxBytes Upper bound for the amount of texels to send, so as
+     * to spread a lot of uploads over several frames. At least one texture
+     * is sent at each call.
+     */
+    static void processUploads(std::size_t maxBytes = 64 << 20);
+
+    /**
+     * @brief Tell whether some assets are still being loaded.
+     * @return True if some textures are not loaded yet.
+     */
+    static bool isLoading();
+
+    /**
+     * @brief Forget every cached asset.
+     *
+     * Assets still referenced somewhere are not released, but they will
+     * be loaded again at the next request. The placeholders of the textures
+     * not loaded are released on the GPU, hence this must be called by the
+     * thread owning the OpenGL context (the Viewer does it when destroyed).
+     */
+    static void clear();
+
+private:
+    static TexturePtr requestTexture(
+        const std::string& key,
+        unsigned int target,
+        const std::vector< std::vector<std::string> >& chains,
+        const std::string& container,
+        bool sRGB,
+        bool repeat,
+        TextureFiltering filtering = TRILINEAR_FILTERING
+    );
+
+    static std::unordered_map< std::string, std::weak_ptr<const MeshData> > m_meshes;
+    static std::unordered_map< std::string, std::weak_ptr<Texture> > m_textures;
+};
+
+#endif
@@ -6,6 +6,9 @@
  */
 
 #include <chrono>
+#include <mutex>
+#include <string>
+#include <vector>
 
 /** @brief Compute an averaged FPS.
  *
@@ -22,10 +25,34 @@
  *   // slowly change such that we can still read it correctly.
  * }
  * \endcode
+ *
+ * An average hides the stutters, so the counter also keeps the duration of
+ * each frame, and of each simulation step reported by addSimulationStep().
+ * At each refresh, the statistics of the durations measured during the
+ * interval are computed, and appended to a history which can be exported
+ * in a CSV file. The durations of the last frames are kept to be drawn.
  */
 class FPSCounter
 {
 public:
+  /** @brief Statistics of the durations measured during a refresh interval.
+   *
+   * The durations are in milliseconds, the percentiles are the smallest
+   * durations greater than or equal to the given proportion of the durations.
+   */
+  struct Statistics
+  {
+    Statistics();
+
+    float min;  /*!< Shortest duration. */
+    float mean; /*!< Average duration. */
+    float p50;  /*!< Median duration. */
+    float p95;  /*!< 95th percentile of the durations. */
+    float p99;  /*!< 99th percentile of the durations. */
+    float max;  /*!< Longest duration. */
+    unsigned int count; /*!< Number of durations measured. */
+  };
+
   /** @brief Build a FPS counter with a specific refresh interval.
    *
    * Create a FPS counter that will be refreshed every displayInterval
@@ -50,16 +77,58 @@ public:
    * ago, a new averaged fps count is computed. This is this averaged fps count
    * that is returned in all cases.
    *
+   * It must be called once per frame: the time elapsed since the last call is
+   * the duration of a frame.
+   *
    * @return The averaged FPS count.
    */
   float getFPS();
 
+  /** @brief Report the duration of a simulation step.
+   *
+   * This function can be called from any thread, e.g. the one stepping the
+   * boids. The durations reported are taken into account at the next refresh.
+   *
+   * @param duration The duration of the step in seconds.
+   */
+  void addSimulationStep( double duration );
+
+  /** @brief Get the statistics of the frame durations.
+   *
+   * @return The statistics of the frames of the last refresh interval.
+   */
+  const Statistics& getFrameTimeStatistics() const;
+
+  /** @brief Get the statistics of the simulation step durations.
+   *
+   * @return The statistics of the steps of the last refresh interval.
+   */
+  const Statistics& getSimulationStepStatistics() const;
+
+  /** @brief Get the durations of the last frames.
+   *
+   * @param frameTimes Filled with the durations of the last frames in
+   * milliseconds, the oldest first.
+   */
+  void getFrameTimes( std::vector<float>& frameTimes ) const;
+
+  /** @brief Export the statistics of each refresh interval in a CSV file.
+   *
+   * Write one line per refresh since the construction of the counter, with
+   * its time in seconds, the averaged FPS, and the statistics of the frames
+   * and of the simulation steps.
+   *
+   * @param filename The path of the CSV file.
+   * @return True if the file was written.
+   */
+  bool exportCSV( const std::string& filename ) const;
+
 private:
-  /** We use the system_clock of std::chrono to compute durations.
-   * chrono is a nice addition to the c++ std, go have a look there:
-   * http://www.cplusplus.com/reference/chrono/
+  /** We use the steady_clock of std::chrono to compute durations, as it
+   * never goes backward. chrono is a nice addition to the c++ std, go have
+   * a look there: http://www.cplusplus.com/reference/chrono/
    */
-  typedef std::chrono::system_clock clock;
+  typedef std::chrono::steady_clock clock;
   /** We use a double precision duration type to have a precise FPS estimation.
    */
   typedef std::chrono::duration<double> Duration;
@@ -68,8 +137,19 @@ private:
    */
   typedef std::chrono::time_point< clock, Duration > TimePoint;
 
+  /** @brief The statistics of a refresh interval, for the CSV export. */
+  struct Record
+  {
+    double time; /*!< Time of the refresh since the construction, in seconds. */
+    float fps; /*!< Averaged FPS count of the interval. */
+    Statistics frames; /*!< Statistics of the frame durations. */
+    Statistics steps; /*!< Statistics of the simulation step durations. */
+  };
+
   /** Duration between two refresh of FPSCounter::m_fps. */
   Duration m_refreshInterval;
+  /** Time this counter was built, origin of the times of the history. */
+  TimePoint m_startTime;
   /** Last time the FPSCounter::m_fps was refreshed. */
   TimePoint m_lastRefreshTime;
   /** Last time getFPS() was called. */
@@ -81,6 +161,25 @@ private:
   float m_fps;
   /** The number of FPS computed by each call to getFPS() since last refresh. */
   unsigned int m_numberOfSamples;
+
+  /** The number of calls to getFPS() since the construction. */
+  unsigned long m_numberOfFrames;
+  /** Ring buffer of the durations of the last frames, in milliseconds. */
+  std::vector<float> m_frameTimes;
+  /** The durations of the frames since last refresh, in milliseconds. */
+  std::vector<float> m_intervalFrameTimes;
+  /** The durations of the simulation steps since last refresh, in milliseconds. */
+  std::vector<float> m_intervalStepTimes;
+  /** Protect FPSCounter::m_intervalStepTimes, reported by other threads. */
+  std::mutex m_stepTimesMutex;
+  /** The simulation step durations of the interval being refreshed, sorted out of the lock. */
+  std::vector<float> m_refreshedStepTimes;
+  /** Statistics of the frame durations of the last refresh interval. */
+  Statistics m_frameStatistics;
+  /** Statistics of the simulation step durations of the last refresh interval. */
+  Statistics m_stepStatistics;
+  /** Statistics of every refresh interval since the construction. */
+  std::vector<Record> m_history;
 };
 
 #endif /* ATUIN_FPSCOUNTER_H_ */
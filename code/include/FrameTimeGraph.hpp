@@ -0,0 +1,95 @@
+#ifndef FRAMETIMEGRAPH_HPP_
+#define FRAMETIMEGRAPH_HPP_
+
+/** @file
+ * @brief Define a graph of the frame durations.
+ *
+ * This file define an object that can display the durations of the last
+ * frames on screen thanks to OpenGL. That object is FrameTimeGraph.
+ */
+
+# include <vector>
+# include <glm/glm.hpp>
+# include "ShaderProgram.hpp"
+
+/** @brief Draw the durations of the last frames as bars on the screen.
+ *
+ * Each frame is drawn as a vertical bar, whose height is proportional to its
+ * duration, over a translucent background. The graph spans twice the frame
+ * time budget, marked by a line: the bars within the budget are green, the
+ * ones above are orange, and the ones above twice the budget are clamped and
+ * drawn in red. Like TextEngine, the positions are given in pixels.
+ */
+class FrameTimeGraph
+{
+public:
+  /** @brief Construction
+   *
+   * Build a graph, which still needs to be initialized.
+   */
+  FrameTimeGraph();
+
+  /** @brief Instance destruction.
+   *
+   * Release the vertex buffer from the GPU.
+   */
+  ~FrameTimeGraph();
+
+  /** @brief Initialize the graph.
+   *
+   * Load the shader program and create the vertex buffer. As for TextEngine,
+   * this must be done after the creation of the OpenGL context.
+   */
+  void init();
+
+  /** @brief Notify the graph a change in the window size.
+   *
+   * @param width Width in pixels of the window we are rendering to
+   * @param height Height in pixels of the window we are rendering to
+   */
+  void setWindowDimensions( float width, float height );
+
+  /** @brief Render the durations of frames on the screen.
+   *
+   * @param frameTimes The durations of the frames in milliseconds, the oldest
+   * first, see FPSCounter::getFrameTimes().
+   * @param pixelCoordinates Position of the lower left corner of the graph
+   * @param size Size of the graph in pixels
+   * @param budget The frame time budget in milliseconds
+   */
+  void render( const std::vector<float>& frameTimes, const glm::vec2& pixelCoordinates,
+               const glm::vec2& size, float budget );
+
+private:
+  /** @brief Append a quad of a single color to the vertices.
+   */
+  void addQuad( const glm::vec2& lowerLeft, const glm::vec2& upperRight, const glm::vec4& color );
+
+  /** How to project pixel coordinates onto the screen.
+   */
+  glm::mat4 m_projection;
+  /** Process the vertices to display the graph on the screen.
+   */
+  ShaderProgram m_program;
+  /** Name of the buffer containing the vertex info
+   */
+  unsigned int m_vboVertices;
+  /** Where to bind the vertex positions on the GPU to be used by the shader
+   * program.
+   */
+  int m_vertexLocation;
+  /** Where to bind the vertex colors on the GPU to be used by the shader
+   * program.
+   */
+  int m_colorLocation;
+  /** Where to send the values of the projection matrix on the GPU to be
+   * used by the shader program.
+   */
+  int m_projectionLocation;
+  /** The positions and colors of the vertices, kept between the frames to
+   * avoid an allocation each time.
+   */
+  std::vector< float > m_vertices;
+};
+
+#endif
@@ -91,16 +91,18 @@ public :
      *
      * Since a model matrix is the transformation from the object coordinates to the world
      * coordinates, it should be computed thanks to the hierarchy and the
-     * matrices \ref m_parentTransform. This computation is done in this function and should be
-     * typically applied before drawing a hierarchical renderable. The result is stored
-     * in \ref m_model.
+     * matrices \ref m_parentTransform. This function updates the model matrices of
+     * the whole hierarchy containing this instance, see updateHierarchy(). The result
+     * is stored in \ref m_model. It is automatically called when the root of the
+     * hierarchy is added to the render queue.
      */
     void updateModelMatrix();
 
     /** @brief Compute the total parent transformation.
      *
      * This function computes recursively the total parent transformation until
-     * it reaches the root of the hierarchy.
+     * it reaches the root of the hierarchy. Prefer updateModelMatrix(), which
+     * reuses the transformations that did not change since the last update.
      *
      * \return The total parent transformation matrix.
      */
@@ -182,14 +184,42 @@ private:
      */
     glm::mat4 m_localTransform;
 
-    /**\brief Perform computations before do_draw()
+    /**@brief Instances of the hierarchy, parents before children.
+     *
+     * Only filled for the root of the hierarchy, rebuilt when a child is added.
+     */
+    std::vector< HierarchicalRenderable* > m_hierarchy;
+
+    /**@brief Total parent transformation, cached since the last update. */
+    glm::mat4 m_totalParentTransform;
+
+    bool m_hierarchyChanged; /*!< True if \ref m_hierarchy must be rebuilt. */
+    bool m_parentTransformDirty; /*!< True if \ref m_parentTransform changed since the last update. */
+    bool m_localTransformDirty; /*!< True if \ref m_localTransform changed since the last update. */
+    bool m_totalParentTransformChanged; /*!< True if \ref m_totalParentTransform changed during the last update. */
+
+    /**\brief Update the model matrices of the hierarchy.
+     *
+     * Called on the root of the hierarchy. The instances are visited in one
+     * linear pass over \ref m_hierarchy: the total parent transformation of an
+     * instance is only computed again if its parent transformation or the one
+     * of an ancestor changed, and is computed from the cached one of its parent.
+     */
+    void updateHierarchy();
+
+    /**\brief Append this instance and its descendants to a hierarchy, parents first.
+     * \param hierarchy The array to fill.
+     */
+    void flattenHierarchy( std::vector< HierarchicalRenderable* >& hierarchy );
+
+    /**\brief Update the model matrices before adding the root to the render queue
      */
-    virtual void beforeDraw();
+    virtual void beforeEnqueue( RenderQueue& queue );
 
     /**
-     * \brief Perform computations after do_draw()
+     * \brief Add the children to the render queue after this instance
      */
-    virtual void afterDraw();
+    virtual void afterEnqueue( RenderQueue& queue );
 
     /**
      * \brief Perform computations after do_animate()
@@ -0,0 +1,127 @@
+#ifndef PROFILER_HPP
+#define PROFILER_HPP
+
+/** @file
+ * @brief Define a hierarchical CPU profiler exporting Chrome traces
+ *
+ * The major stages of the application are timed by scoped markers:
+ * \code{.cpp}
+ * void Viewer::draw()
+ * {
+ *   PROFILE_SCOPE("Viewer::draw");
+ *   // The duration of the rest of the function is recorded
+ * }
+ * \endcode
+ * Each thread records its markers in a ring buffer of its own, without
+ * locks. The last markers of every thread are exported on demand in the
+ * JSON format of Chrome about:tracing (or https://ui.perfetto.dev), which
+ * displays the nested markers of each thread as a flame graph.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+/** @brief Record the duration of the enclosing scope under a name.
+ *
+ * The name must be a string literal, or any string living until the export.
+ */
+#define PROFILE_SCOPE( name ) ProfileScope PROFILE_CONCAT( profileScope, __LINE__ )( name )
+#define PROFILE_CONCAT( a, b ) PROFILE_CONCAT_IMPL( a, b )
+#define PROFILE_CONCAT_IMPL( a, b ) a##b
+
+/** @brief Collect the timing markers of all the threads.
+ */
+class Profiler
+{
+public:
+  /** We use the steady_clock of std::chrono, which never goes backward. */
+  typedef std::chrono::steady_clock clock;
+
+  /** @brief Enable or disable the recording of the markers.
+   *
+   * The recording is enabled by default, a disabled marker costs a single
+   * atomic load.
+   * @param enabled True to record the markers.
+   */
+  static void setEnabled( bool enabled );
+
+  /** @brief Check if the markers are recorded.
+   * @return True if the markers are recorded.
+   */
+  static bool isEnabled();
+
+  /** @brief Name the calling thread in the exported traces.
+   * @param name The name of the thread.
+   */
+  static void setThreadName( const std::string& name );
+
+  /** @brief Record a marker of the calling thread.
+   *
+   * Only called by ProfileScope.
+   * @param name The name of the marker.
+   * @param start The time the marked scope was entered.
+   * @param end The time the marked scope was left.
+   */
+  static void record( const char* name, const clock::time_point& start, const clock::time_point& end );
+
+  /** @brief Export the recorded markers as a Chrome trace.
+   *
+   * Write the last markers recorded by each thread in a JSON file, which can
+   * be loaded in Chrome about:tracing. The threads may keep recording during
+   * the export: the markers they overwrite meanwhile are left out.
+   * @param filename The path of the JSON file.
+   * @return True if the file was written.
+   */
+  static bool exportChromeTrace( const std::string& filename );
+};
+
+/** @brief Record the duration of a scope, see PROFILE_SCOPE.
+ */
+class ProfileScope
+{
+public:
+  /** @brief Start timing the scope, if the profiler is enabled.
+   * @param name The name of the marker.
+   */
+  explicit ProfileScope( const char* name )
+    : m_name( Profiler::isEnabled() ? name : nullptr )
+  {
+    if( m_name )
+      m_start = Profiler::clock::now();
+  }
+
+  /** @brief Record the marker of the scope.
+   */
+  ~ProfileScope()
+  {
+    if( m_name )
+      Profiler::record( m_name, m_start, Profiler::clock::now() );
+  }
+
+  /** @brief Record the marker so far, and start a new one.
+   *
+   * Split a long function in consecutive phases without nesting them in blocks.
+   * @param name The name of the next marker.
+   */
+  void next( const char* name )
+  {
+    if( m_name )
+    {
+      const Profiler::clock::time_point now = Profiler::clock::now();
+      Profiler::record( m_name, m_start, now );
+      m_start = now;
+    }
+    m_name = m_name ? name : nullptr;
+  }
+
+private:
+  ProfileScope( const ProfileScope& );
+  ProfileScope& operator=( const ProfileScope& );
+
+  const char* m_name; /*!< Name of the marker, null when the profiler was disabled. */
+  Profiler::clock::time_point m_start; /*!< Time the scope was entered. */
+};
+
+#endif /* PROFILER_HPP */
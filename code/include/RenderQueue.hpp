@@ -0,0 +1,90 @@
+#ifndef RENDER_QUEUE_HPP
+#define RENDER_QUEUE_HPP
+
+/**@file
+ * @brief Define the queue sorting the draws of a frame.
+ */
+
+#include <vector>
+#include <glm/glm.hpp>
+
+class Renderable;
+
+/**@brief Passes of a frame, drawn in this order. */
+enum RenderPass
+{
+    /** Opaque renderables, drawn front to back to reject hidden fragments early. */
+    OPAQUE_PASS = 0,
+    /** Transparent renderables, blended back to front without writing the depth. */
+    TRANSPARENT_PASS = 1
+};
+
+/**
+ * @brief An entry of the render queue, with its sort key.
+ *
+ * The items are sorted by pass, then by shader program, texture and mesh
+ * for the opaque pass, so that consecutive draws share as much OpenGL state
+ * as possible. The transparent items are sorted by decreasing depth only, as
+ * blending requires it. The sequence number makes the order deterministic.
+ */
+struct RenderItem
+{
+    unsigned int pass;     /*!< The render pass of the item. */
+    unsigned int program;  /*!< The identifier of the shader program, 0 if none. */
+    unsigned int texture;  /*!< The identifier of the main texture, 0 if none. */
+    unsigned int mesh;     /*!< The identifier of the vertex buffer, 0 if unknown. */
+    float depth;           /*!< The squared distance from the sort position of the renderable to the camera. */
+    unsigned int sequence; /*!< The rank of insertion in the queue. */
+    Renderable* renderable; /*!< The renderable to draw. */
+
+    /**
+     * @brief Compare the sort keys of two items.
+     *
+     * @param other The item to compare with.
+     * @return True if this item must be drawn before the other one.
+     */
+    bool operator<(const RenderItem& other) const;
+};
+
+/**
+ * @brief Collect the renderables to draw in a frame and draw them in a
+ * sorted order.
+ *
+ * The queue keeps track of the shader program bound, to only bind a program
+ * when it differs from the one of the previous draw.
+ */
+class RenderQueue
+{
+public:
+    /**
+     * @brief Remove every item, to prepare the next frame.
+     *
+     * @param cameraPosition The position of the camera in world space.
+     */
+    void clear(const glm::vec3& cameraPosition);
+
+    /**
+     * @brief Add a renderable to the queue.
+     *
+     * @param renderable The renderable to draw in this frame.
+     */
+    void push(Renderable* renderable);
+
+    /**
+     * @brief Sort the items and draw them.
+     */
+    void draw();
+
+    /**
+     * @brief Get the number of items in the queue.
+     *
+     * @return The number of items.
+     */
+    std::size_t size() const;
+
+private:
+    std::vector<RenderItem> m_items; /*!< The items of the frame, reused from a frame to the next one. */
+    glm::vec3 m_cameraPosition;      /*!< The position of the camera, to compute the depth of the items. */
+};
+
+#endif //RENDER_QUEUE_HPP
@@ -14,6 +14,7 @@
 
 #include "Camera.hpp"
 #include "ShaderProgram.hpp"
+#include "RenderQueue.hpp"
 #include <SFML/Graphics.hpp>
 
 /* Forward declaration of the Viewer class in order to store a pointer to a
@@ -40,10 +41,16 @@ class Viewer;
  * class to display it for you, animate it or to send interaction events to it.
  *
  * If you want the Viewer managing your renderables to automatically set the view
- * and the projection matrices for you, remember to name the corresponding uniform
- * matrices as follow in your shaders:
- * - \c mat4 \c viewMat, for the view matrix
- * - \c mat4 \c projMat, for the projection matrix
+ * and the projection matrices for you, remember to declare them in the following
+ * uniform block of your shaders:
+ * \code
+ * layout(std140) uniform Camera
+ * {
+ *     mat4 projMat;
+ *     mat4 viewMat;
+ *     vec4 viewport;
+ * };
+ * \endcode
  *
  * \note As this class use virtuality, here are some words about the subject to
  * ease your learning of c++ as well as learning computer graphics. This note is
@@ -123,33 +130,22 @@ public:
      * any shader program.
      */
     void unbindShaderProgram();
-    /**
-     * \brief Get the location of the projection matrix in the shader program.
-     *
-     * Get the uniform identifier of the projection matrix for the shader program
-     * of this renderable. This uniform should be named "projMat" in your shader
-     * to be automatically set by the Viewer.
+    /** \brief Add this renderable to the render queue of the frame.
      *
-     * \return the location of the projection matrix uniform or -1 if the
-     * associated shader program does not use such an uniform ("projMat").
+     * The queue calls draw() later, in an order minimizing the changes of
+     * OpenGL state. This function calls the private virtual functions
+     * <tt> beforeEnqueue(queue) </tt> and <tt> afterEnqueue(queue) </tt>, to
+     * update this renderable and to add the renderables depending on this one.
+     * \param queue The render queue of the frame.
      */
-    int projectionLocation();
+    void enqueue(RenderQueue& queue);
 
-    /** \brief Get the location of the view matrix in the shader program.
-     *
-     * Get the uniform identifier of the view matrix for the shader program of
-     * this renderable. This uniform should be named "viewMat" in your shader
-     * to be automatically set by the Viewer.
-     * \return the location of the view matrix uniform or -1 if the associated
-     * shader program does not use such an uniform ("viewMat").
-     */
-    int viewLocation();
     /** \brief Draw this renderable.
      *
      * This function calls the private pure virtual function <tt> do_draw() </tt>
      * (guidelines #1 and #2). When this function is called by the Viewer,
      * the shader program is already binded, the view and projection matrices are
-     * already set.
+     * already set in the "Camera" uniform block.
      */
     void draw();
 
@@ -207,6 +203,40 @@ public:
 
     ShaderProgramPtr getShaderProgram() const;
 
+    /**\brief Set the render pass of this renderable.
+     *
+     * The transparent renderables are drawn after the opaque ones, back to
+     * front, with blending enabled and without writing the depth.
+     * \param pass The new render pass. Default to OPAQUE_PASS.
+     */
+    void setRenderPass( RenderPass pass );
+
+    /**\brief Get the render pass of this renderable.
+     * \return The render pass.
+     */
+    RenderPass getRenderPass() const;
+
+    /**\brief Get the texture sort key of this renderable.
+     *
+     * The renderables drawn with the same texture are drawn consecutively.
+     * \return The identifier of the main texture, 0 if none.
+     */
+    unsigned int getTextureKey() const;
+
+    /**\brief Get the mesh sort key of this renderable.
+     *
+     * The renderables drawn with the same vertex buffers are drawn consecutively.
+     * \return The identifier of the main vertex buffer, 0 if unknown.
+     */
+    unsigned int getMeshKey() const;
+
+    /**\brief Get the position used to sort this renderable by depth.
+     *
+     * The transparent renderables are drawn back to front according to it.
+     * \return The position in world space, the origin of the model frame by default.
+     */
+    glm::vec3 getSortPosition() const;
+
     void displayTextInViewer(std::string text) const;
 
 
@@ -301,6 +331,44 @@ private:
      * @param time The current simulation time.
      */
     virtual void afterAnimate( float time );
+    /**@brief Perform operation before adding a renderable to the render queue.
+     *
+     * Override this function to update the renderable before its sort keys
+     * are computed.
+     * @param queue The render queue of the frame.
+     */
+    virtual void beforeEnqueue( RenderQueue& queue );
+    /**@brief Perform operation after adding a renderable to the render queue.
+     *
+     * Override this function to add other renderables to the queue.
+     * @param queue The render queue of the frame.
+     */
+    virtual void afterEnqueue( RenderQueue& queue );
+    /**@brief Texture sort key virtual function.
+     *
+     * Override this function to return the identifier of the texture bound
+     * by do_draw().
+     * @return The identifier of the main texture, 0 by default.
+     */
+    virtual unsigned int do_getTextureKey() const;
+    /**@brief Mesh sort key virtual function.
+     *
+     * Override this function to return the identifier of a vertex buffer
+     * bound by do_draw().
+     * @return The identifier of the main vertex buffer, 0 by default.
+     */
+    virtual unsigned int do_getMeshKey() const;
+    /**@brief Sort position virtual function.
+     *
+     * Override this function when the geometry drawn is not placed by the
+     * model matrix alone. The instanced renderables draw many objects at
+     * once: they keep the default, which does not tell anything about the
+     * depth of their instances.
+     * @return The position in world space, the translation of the model matrix by default.
+     */
+    virtual glm::vec3 do_getSortPosition() const;
+
+    RenderPass m_renderPass; /*!< Render pass of the renderable. */
 
     Viewer* getViewer() const;
 
@@ -12,6 +12,53 @@
 # include <memory>
 # include <unordered_map>
 # include <list>
+# include <vector>
+
+/**@brief Name of a shader program variable, interned for fast location look up.
+ *
+ * Building a ShaderVariable registers its name in a global table, once, and
+ * assigns it a small integer identifier. Every shader program resolves the
+ * location of each registered name after its linking stage, and stores them
+ * in an array indexed by those identifiers. Looking up a location thanks to
+ * a ShaderVariable is thus an array access: no string is built nor hashed.
+ *
+ * The variables are meant to be built once, typically as static variables.
+ * The macro #SHADER_VARIABLE does it for you at the place of use:
+ * \code{.cpp}
+ * int modelLocation = m_shaderProgram->getUniformLocation(SHADER_VARIABLE("modelMat"));
+ * \endcode
+ */
+class ShaderVariable{
+public:
+    /**@brief Intern a variable name.
+     *
+     * @param name The variable name, as it appears in the shader sources.
+     */
+    explicit ShaderVariable(const std::string& name);
+
+    /**@brief Get the identifier of the interned name.
+     * @return The index of the name in the table of interned names. */
+    unsigned int id() const { return m_id; }
+
+    /**@brief Get the interned name.
+     * @return The variable name. */
+    const std::string& name() const;
+
+    /**@brief Get the number of names interned so far.
+     * @return The number of names. */
+    static unsigned int count();
+
+private:
+    unsigned int m_id;
+};
+
+/**@brief Get a static ShaderVariable for a name.
+ *
+ * The expression giving the name is only evaluated the first time this code
+ * is executed: the next times, the variable built then is returned.
+ */
+# define SHADER_VARIABLE( name ) \
+    ([&]() -> const ShaderVariable& { static const ShaderVariable variable( name ); return variable; }())
 
 /**@brief Assembly of the graphics pipeline programmable steps.
  *
@@ -125,6 +172,45 @@ public:
      */
     int getAttributeLocation( const std::string& name ) const;
 
+    /**@brief Get the location of an uniform thanks to its interned name.
+     *
+     * Same as getUniformLocation(const std::string&), without any string
+     * hashing: the locations of the interned names are resolved after the
+     * linking stage. This is the version to use in the rendering loop.
+     * @param variable The interned uniform name.
+     * @return The uniform location, null_location if there is no uniform with such name in this program
+     */
+    int getUniformLocation( const ShaderVariable& variable ) const
+    {
+        if( variable.id() >= m_uniformLocations.size() )
+            resolveLocations();
+        return m_uniformLocations[ variable.id() ];
+    }
+
+    /**@brief Get the location of an attribute thanks to its interned name.
+     *
+     * Same as getAttributeLocation(const std::string&), without any string
+     * hashing.
+     * @param variable The interned attribute name.
+     * @return The attribute location, null_location if there is no attribute with such name in this program
+     */
+    int getAttributeLocation( const ShaderVariable& variable ) const
+    {
+        if( variable.id() >= m_attributeLocations.size() )
+            resolveLocations();
+        return m_attributeLocations[ variable.id() ];
+    }
+
+    /**@brief Get the revision of this shader program.
+     *
+     * The revision is incremented each time the program is successfully
+     * linked, hence each time the locations of its variables may change.
+     * A renderable caching some locations can compare the revision with the
+     * one of its cache to know when the locations must be looked up again.
+     * @return The number of successful links of this program.
+     */
+    unsigned int getRevision() const;
+
 
     /**@brief Get the identifier of this shader program.
      *
@@ -152,15 +238,22 @@ public:
 private:
 
     void ressources_introspection();
+    // Resolve the locations of the names interned since the last call
+    void resolveLocations() const;
     std::string getExtension(const std::string &s);
 
     unsigned int m_programId;
     
     std::unordered_map< std::string, identifier > m_uniforms;
     std::unordered_map< std::string, int > m_attributes;
+
+    // Locations indexed by the identifiers of the interned names
+    mutable std::vector< int > m_uniformLocations;
+    mutable std::vector< int > m_attributeLocations;
  
     std::list< std::string > m_source_filenames;
     bool m_loaded;
+    unsigned int m_revision;
 
 };
 
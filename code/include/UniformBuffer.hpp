@@ -0,0 +1,156 @@
+#ifndef UNIFORM_BUFFER_HPP
+#define UNIFORM_BUFFER_HPP
+
+/**@file
+ * @brief Uniform buffer objects shared by the shader programs.
+ *
+ * The data common to every shader program (the camera matrices and the
+ * lights) are stored in uniform buffers, sent once per frame by the viewer
+ * and bound to fixed binding points. The material of each object is also
+ * stored in a uniform buffer, bound before drawing the object. This way,
+ * the amount of uniforms sent at each frame does not depend on the number
+ * of shader programs.
+ *
+ * The structures of this file mirror the uniform blocks of the shaders,
+ * following the std140 layout rules: a vec3 is aligned on 16 bytes, but a
+ * scalar following it fills its last 4 bytes.
+ */
+
+#include <cstddef>
+#include <string>
+#include <glm/glm.hpp>
+
+/**@brief Maximal number of point lights, MAX_NR_POINT_LIGHTS in the shaders. */
+#define MAX_NR_POINT_LIGHTS 10
+/**@brief Maximal number of spot lights, MAX_NR_SPOT_LIGHTS in the shaders. */
+#define MAX_NR_SPOT_LIGHTS 10
+
+/**@brief Binding points of the uniform blocks. */
+enum UniformBlockBinding
+{
+    /** The "Camera" block, holding the projection and view matrices. */
+    CAMERA_BLOCK_BINDING = 0,
+    /** The "Lights" block, holding every light of the scene. */
+    LIGHTS_BLOCK_BINDING = 1,
+    /** The "MaterialBlock" block, holding the material of the object drawn. */
+    MATERIAL_BLOCK_BINDING = 2
+};
+
+/**@brief Get the binding point of a uniform block.
+ *
+ * @param blockName The name of the block in the shader sources.
+ * @return The binding point of the block, -1 if the block is unknown.
+ */
+int uniformBlockBinding(const std::string& blockName);
+
+/**@brief Layout of the "Camera" uniform block. */
+struct CameraBlock
+{
+    glm::mat4 projMat;  /*!< The projection matrix. */
+    glm::mat4 viewMat;  /*!< The view matrix. */
+    glm::vec4 viewport; /*!< The width and height of the viewport in pixels, then their inverses. */
+};
+
+/**@brief Layout of the DirectionalLight structure in a uniform block. */
+struct DirectionalLightBlock
+{
+    glm::vec3 direction; float padding0;
+    glm::vec3 ambient;   float padding1;
+    glm::vec3 diffuse;   float padding2;
+    glm::vec3 specular;  float padding3;
+};
+
+/**@brief Layout of the PointLight structure in a uniform block. */
+struct PointLightBlock
+{
+    glm::vec3 position;  float padding0;
+    glm::vec3 ambient;   float padding1;
+    glm::vec3 diffuse;   float padding2;
+    glm::vec3 specular;
+    float constant;
+    float linear;
+    float quadratic;
+    float padding3[2];
+};
+
+/**@brief Layout of the SpotLight structure in a uniform block. */
+struct SpotLightBlock
+{
+    glm::vec3 position;      float padding0;
+    glm::vec3 spotDirection; float padding1;
+    glm::vec3 ambient;       float padding2;
+    glm::vec3 diffuse;       float padding3;
+    glm::vec3 specular;
+    float constant;
+    float linear;
+    float quadratic;
+    float innerCutOff;
+    float outerCutOff;
+};
+
+/**@brief Layout of the "Lights" uniform block. */
+struct LightsBlock
+{
+    DirectionalLightBlock directionalLight;
+    PointLightBlock pointLight[MAX_NR_POINT_LIGHTS];
+    SpotLightBlock spotLight[MAX_NR_SPOT_LIGHTS];
+    int numberOfPointLight;
+    int numberOfSpotLight;
+    int padding[2];
+};
+
+/**@brief Layout of the "MaterialBlock" uniform block. */
+struct MaterialBlock
+{
+    glm::vec3 ambient;  float padding0;
+    glm::vec3 diffuse;  float padding1;
+    glm::vec3 specular;
+    float shininess;
+};
+
+/**
+ * @brief A buffer storing the content of a uniform block on the GPU.
+ *
+ * The buffer is created at the first update, so that a uniform buffer can
+ * be built before the OpenGL context.
+ */
+class UniformBuffer
+{
+public:
+    /**
+     * @brief Constructor of an empty buffer.
+     */
+    UniformBuffer();
+
+    /**
+     * @brief Destructor, releases the buffer on the GPU.
+     */
+    ~UniformBuffer();
+
+    /**
+     * @brief Send the content of the block to the GPU.
+     *
+     * @param data The content of the block.
+     * @param size The size of the block, in bytes.
+     */
+    void update(const void* data, std::size_t size);
+
+    /**
+     * @brief Bind the buffer to a binding point.
+     *
+     * Every shader program having a block associated to this binding point
+     * reads its content from this buffer.
+     *
+     * @param binding The binding point.
+     */
+    void bind(unsigned int binding) const;
+
+private:
+    UniformBuffer(const UniformBuffer&);
+    UniformBuffer& operator=(const UniformBuffer&);
+
+    unsigned int m_id; /*!< Identifier of the buffer on the GPU. */
+    std::size_t m_size; /*!< Size of the buffer, in bytes. */
+};
+
+#endif //UNIFORM_BUFFER_HPP
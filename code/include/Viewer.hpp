@@ -10,9 +10,12 @@
 
 #include "Camera.hpp"
 #include "FPSCounter.hpp"
+#include "FrameTimeGraph.hpp"
 #include "HierarchicalRenderable.hpp"
 #include "Renderable.hpp"
+#include "RenderQueue.hpp"
 #include "TextEngine.hpp"
+#include "UniformBuffer.hpp"
 #include "dynamics/Particle.hpp"
 #include "lighting/Light.hpp"
 #include "terrain/MapGenerator.hpp"
@@ -21,6 +24,7 @@
 #include <memory>
 #include <string>
 #include <unordered_set>
+#include <vector>
 
 #include <GL/glew.h>
 #include <SFML/Graphics.hpp>
@@ -109,9 +113,10 @@ public:
     void display();
     /**\brief Draw the renderables.
      *
-     * Iterate over all the renderables of \ref m_renderables and call their Renderable::draw() function.
-     * For each renderable, the viewer will first bind its shader, send camera information to
-     * the GPU, draw the renderable and unbind its shader.
+     * Send the camera and the lights to the GPU, then add all the renderables of
+     * \ref m_renderables (and their children) to \ref m_renderQueue. The queue
+     * draws them sorted by pass, shader program, texture, mesh and depth, binding
+     * a shader program only when it differs from the previous one.
      */
     void draw();
 
@@ -147,6 +152,13 @@ public:
      * @return A reference to the viewer's camera. */
     Camera& getCamera();
 
+    /**@brief Get the framerate counter.
+     *
+     * Access to the counter measuring the frames, to which the simulation
+     * steps are reported.
+     * @return A reference to the viewer's framerate counter. */
+    FPSCounter& getFPSCounter();
+
     /**@brief Get the world coordinate of a window point.
      *
      * This function returns the world coordinate of a point given in the
@@ -164,7 +176,8 @@ public:
     /**
      * \brief addRenderable
      *
-     * Add a renderable to the set of renderabbles \ref m_renderables of the viewer.
+     * Add a renderable to the renderabbles \ref m_renderables of the viewer,
+     * if it was not already added.
      * \param r A renderable to add to \ref m_renderables.
      */
     void addRenderable( RenderablePtr r );
@@ -175,6 +188,23 @@ public:
      * Save a screenshot of the window in a PNG file in the directory containing the executable.
      */
     void takeScreenshot();
+
+    /**
+     * @brief Export the CPU profile.
+     *
+     * Save the last timing markers of every thread as a Chrome trace in a JSON
+     * file in the directory containing the executable, see Profiler.
+     */
+    void exportProfile();
+
+    /**
+     * @brief Export the frame time statistics.
+     *
+     * Save the statistics of the frames and of the simulation steps of each
+     * refresh interval in a CSV file in the directory containing the
+     * executable, see FPSCounter.
+     */
+    void exportFrameTimes();
     /**@}*/
 
     /**@name Animation
@@ -285,10 +315,13 @@ private:
 
     Camera m_camera; /*!< Camera used to render the scene in the Viewer. */
     sf::RenderWindow m_window; /*!< Pointer to the render window. */
-    std::unordered_set< RenderablePtr > m_renderables; /*!< Set of renderables that the viewer displays. */
+    std::vector< RenderablePtr > m_renderables; /*!< Renderables that the viewer displays, in the order they were added. */
+    RenderQueue m_renderQueue; /*!< Queue sorting the draws of the renderables at each frame. */
     DirectionalLightPtr m_directionalLight; /*!< Pointer to a directional light. */
     std::vector<PointLightPtr> m_pointLights; /*!< Vector of pointer to the point lights. */
     std::vector<SpotLightPtr> m_spotLights; /*!< Vector of pointer to the spot lights. */
+    UniformBuffer m_cameraBuffer; /*!< Uniform buffer of the camera matrices, sent once per frame. */
+    UniformBuffer m_lightsBuffer; /*!< Uniform buffer of the lights, sent once per frame. */
 
 
     std::unordered_set< ShaderProgramPtr > m_programs;
@@ -308,8 +341,13 @@ private:
     glm::vec3 m_lastMousePosition; /*!< Previous mouse cursor coordinates normalized between [-1,1]. The z-value is set to 1. */
 
     unsigned int m_screenshotCounter; /*!< Number of screenshots since the beginning of the application. */
+    unsigned int m_profileCounter; /*!< Number of exported profiles since the beginning of the application. */
+    unsigned int m_frameTimesCounter; /*!< Number of exported frame time statistics since the beginning of the application. */
 
     FPSCounter m_fpsCounter; /*!< A framerate counter */
+    FrameTimeGraph m_frameTimeGraph; /*!< Graph of the durations of the last frames. */
+    std::vector<float> m_frameTimes; /*!< Durations of the last frames, kept between the frames to draw them. */
+    float m_frameTimeBudget; /*!< Duration of a frame at the maximal FPS, in milliseconds. */
     bool m_helpDisplayed;
 
     /**@brief Hold important state of the keyboard.
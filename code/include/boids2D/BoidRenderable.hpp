@@ -4,6 +4,7 @@
 #include <glm/glm.hpp>
 #include "../HierarchicalRenderable.hpp"
 #include "./../lighting/Material.hpp"
+#include "./../AssetManager.hpp"
 #include <vector>
 #include "Boid.hpp"
 
@@ -44,11 +45,26 @@ class BoidRenderable : public HierarchicalRenderable
    */
   void do_animate( float time );
 
+  /**
+   * @brief Implementation of do_getTextureKey, to draw the boids of the same type together
+   */
+  unsigned int do_getTextureKey() const;
+
+  /**
+   * @brief Implementation of do_getMeshKey
+   */
+  unsigned int do_getMeshKey() const;
+
+  /**
+   * @brief Implementation of do_getSortPosition, the sprite is placed at the location of its boid
+   */
+  glm::vec3 do_getSortPosition() const;
+
   unsigned int m_pBuffer; ///< Buffer for the position of the boid
   unsigned int m_cBuffer; ///< Buffer for the colors of the boid
   unsigned int m_nBuffer; ///< Buffer for the normals of the boid
   unsigned int m_tBuffer;
-  unsigned int m_texId;
+  TexturePtr m_texture; ///< Texture of the boid, shared with the boids of the same type
 
   BoidPtr m_boid; ///< The boid linked to the renderable
 
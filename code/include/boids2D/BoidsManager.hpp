@@ -10,6 +10,8 @@
 #include "../terrain/MapGenerator.hpp"
 #include "../terrain/Biome.hpp"
 #include "../structures/Matrix.hpp"
+#include "../structures/TripleBuffer.hpp"
+#include "BoidsSnapshot.hpp"
 #include "../Viewer.hpp"
 
 class MovableBoid;
@@ -140,6 +142,82 @@ class BoidsManager
    */
   bool getNearestLake(const glm::vec2 & position, glm::vec2 & result) const;
 
+  /**
+   * @brief      Getter for the nearest point of the lakes giving a position,
+   *             on their shore from the land
+   * @param[in]  position Position from where the request is asked
+   * @param[out] result   Position of the nearest point of the lakes
+   * @param[out] distance Distance to the nearest point of the lakes
+   * @return     True if there it exists a lake, false otherwise
+   */
+  bool getNearestLakeShore(const glm::vec2 & position, glm::vec2 & result, float & distance) const;
+
+  /**
+   * @brief      Getter for the steering data of the terrain giving a position
+   * @param[in]  x Abscissa of the position
+   * @param[in]  y Ordinate of the position
+   * @return     The distances to the sea, the steep slopes and the lakes,
+   *             with the directions escaping from them
+   */
+  SteeringSample getSteering(const float& x, const float& y) const;
+
+  /**
+   * @brief     Check if a living movable boid of a type is in a cell or around it
+   * @param[in] i    Index of the line of the cell
+   * @param[in] j    Index of the column of the cell
+   * @param[in] type Type of the boids looked for
+   * @return    True if such a boid is in the 3x3 cells centered on the cell
+   */
+  bool isTypeAround(const unsigned int & i, const unsigned int & j, const BoidType & type) const;
+
+  /**
+   * @brief     Check if a movable boid of a cell has neighbours
+   * @param[in] i Index of the line of the cell
+   * @param[in] j Index of the column of the cell
+   * @return    True if there are at least two movable boids in the 3x3 cells centered on the cell
+   */
+  bool hasNeighbours(const unsigned int & i, const unsigned int & j) const;
+
+  /**
+   * @brief     Get the closest movable boid of a type seen by a boid
+   * @param[in] b    The boid looking around
+   * @param[in] type Type of the boid looked for
+   * @param[in] i    Index of the line of the cell of the boid
+   * @param[in] j    Index of the column of the cell of the boid
+   * @return    The closest boid of this type in the 3x3 cells centered on the cell
+   *            that the boid can see, nullptr if there is none
+   */
+  MovableBoidPtr closestMovable(const MovableBoid & b, const BoidType & type, const unsigned int & i, const unsigned int & j) const;
+
+  /**
+   * @brief     Get the closest rooted boid of a type seen by a boid
+   * @param[in] b    The boid looking around
+   * @param[in] type Type of the boid looked for
+   * @param[in] i    Index of the line of the cell of the boid
+   * @param[in] j    Index of the column of the cell of the boid
+   * @return    The closest boid of this type in the 3x3 cells centered on the cell
+   *            that the boid can see, nullptr if there is none
+   */
+  RootedBoidPtr closestRooted(const MovableBoid & b, const BoidType & type, const unsigned int & i, const unsigned int & j) const;
+
+  /**
+   * @brief Send the position of the camera to the simulation.
+   *        Only called by the rendering thread.
+   */
+  void publishFocus();
+
+  /**
+   * @brief Get the last position of the camera sent by the rendering thread.
+   *        Only called by the thread stepping the simulation.
+   */
+  void acquireFocus();
+
+  /**
+   * @brief  Getter for the position of the camera known by the simulation
+   * @return The last acquired position of the camera
+   */
+  const glm::vec3 & getFocus() const;
+
   /**
    * @brief       Return the index of the boid giving a location
    * @param[in]   location Location asked
@@ -172,6 +250,38 @@ class BoidsManager
    */
   void resetTick();
 
+  /**
+   * @brief     Copy the boids into a snapshot and publish it to the renderables.
+   *            Only called by the thread stepping the simulation.
+   * @param[in] time Simulated time of the last step
+   */
+  void publishSnapshot(const double & time);
+
+  /**
+   * @brief  Make the last published snapshot the one displayed.
+   *         Only called by the rendering thread, once per frame.
+   * @return True if a new snapshot was published since the last call
+   */
+  bool acquireSnapshot();
+
+  /**
+   * @brief  Getter for the snapshot displayed, for the rendering thread only
+   * @return The last acquired snapshot
+   */
+  const BoidsSnapshot & getSnapshot() const;
+
+  /**
+   * @brief     Setter for the fraction of a simulation step elapsed since the snapshot
+   * @param[in] alpha Fraction in [0, 1], used to display the boids between their two last locations
+   */
+  void setInterpolation(const float & alpha);
+
+  /**
+   * @brief  Getter for the fraction of a simulation step elapsed since the snapshot
+   * @return Fraction in [0, 1]
+   */
+  const float & getInterpolation() const;
+
   void addDebugMovableBoid(MovableBoidPtr m);
 
   void repopCarrot();
@@ -196,6 +306,10 @@ class BoidsManager
   int m_updateCoeff; ///< State of the update coefficient to check if the status of the boids need to be updated
   const int m_updatePeriod; ///< Period of tick before the update of the state of the boids
 
+  float m_interpolation; ///< Fraction of a simulation step elapsed since the snapshot, to display the boids
+  TripleBuffer<BoidsSnapshot> m_snapshots; ///< Snapshots handed over from the simulation to the renderables
+  TripleBuffer<glm::vec3> m_focus; ///< Position of the camera handed over from the rendering to the simulation
+
   int m_countCarrot;
 
   void placeRabbitGroup(Biome biomeType);
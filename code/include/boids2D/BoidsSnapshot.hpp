@@ -0,0 +1,60 @@
+/**
+ *  @file		BoidsSnapshot.hpp
+ *  @brief		State of the boids at a step of the simulation, as displayed
+ */
+#ifndef BOIDS_SNAPSHOT_HPP
+#define BOIDS_SNAPSHOT_HPP
+
+#include <vector>
+#include <glm/glm.hpp>
+#include "BoidType.hpp"
+#include "StateType.hpp"
+
+/**
+ * @struct BoidSnapshot
+ * @brief  Copy of what the renderables need of a boid, taken after a step
+ */
+struct BoidSnapshot
+{
+  glm::vec3 location; ///< Location of the boid after the step
+  glm::vec3 previousLocation; ///< Location of the boid before the step
+  float angle; ///< Angle of the boid after the step
+  float previousAngle; ///< Angle of the boid before the step
+  float scale; ///< Size of the boid
+  BoidType type; ///< Type of the boid
+  StateType state; ///< State of the boid, WALK_STATE for a rooted boid
+  bool dead; ///< True if the boid is dead
+  bool display; ///< True if the boid is still displayed
+
+  /**
+   * @brief     Getter for the location between the step and the previous one
+   * @param[in] alpha Fraction of the step, 0 for the previous location and 1 for the current one
+   * @return    The location to display
+   */
+  glm::vec3 interpolatedLocation(const float & alpha) const;
+
+  /**
+   * @brief     Getter for the angle between the step and the previous one
+   * @param[in] alpha Fraction of the step, 0 for the previous angle and 1 for the current one
+   * @return    The angle to display, turning along the shortest way
+   */
+  float interpolatedAngle(const float & alpha) const;
+};
+
+/**
+ * @struct BoidsSnapshot
+ * @brief  Copy of all the boids after a step, published by the simulation to the renderables
+ */
+struct BoidsSnapshot
+{
+  /**
+   * @brief Constructor of an empty snapshot
+   */
+  BoidsSnapshot() : time(0.0) {}
+
+  double time; ///< Simulated time of the step
+  std::vector<BoidSnapshot> movableBoids; ///< The movable boids
+  std::vector<BoidSnapshot> rootedBoids; ///< The rooted boids
+};
+
+#endif
@@ -87,6 +87,35 @@ public:
      * @param dt The new time integration interval.
      */
     void setDt(float dt);
+
+    /**@brief Send the position of the camera to the simulation.
+     *
+     * Called by the rendering thread, once per frame. The boids far from
+     * the camera are updated less often.
+     */
+    void publishFocus();
+
+    /**@brief Publish a snapshot of the boids to the renderables.
+     *
+     * Called by the thread stepping the system, after a simulation step.
+     * @param time The simulated time of the last step.
+     */
+    void publishSnapshot(double time);
+
+    /**@brief Acquire the last snapshot published.
+     *
+     * Called by the rendering thread, once per frame.
+     * @return The snapshot the renderables display until the next call.
+     */
+    const BoidsSnapshot& acquireSnapshot();
+
+    /**@brief Set the fraction of a step elapsed since the displayed snapshot.
+     *
+     * Forward the fraction to the boid manager, so that the renderables
+     * display the boids between the two simulated states of the snapshot.
+     * @param alpha The fraction of the time integration interval, in [0, 1].
+     */
+    void setInterpolation(float alpha);
 };
 
 typedef std::shared_ptr<DynamicSystemBoid> DynamicSystemBoidPtr;
@@ -4,6 +4,11 @@
 #include "../../include/HierarchicalRenderable.hpp"
 #include "DynamicSystemBoid.hpp"
 
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
 /**@brief A little hack to incorporate the dynamic system.
  *
  * This class is mostly a hack we use to deal with the dynamic system components
@@ -12,6 +17,11 @@
  * concept of renderable. Moreover, since it is a hierarchical renderable, it is
  * possible to define a dynamic system in a local frame and then use hierarchical
  * geometric transformation to replace it correctly in the scene.
+ *
+ * By default, the dynamic system is stepped on a thread of its own, started at
+ * the first animation. The renderable only tells this thread up to which time
+ * to simulate, and the boids renderables display the snapshots it publishes,
+ * so that the rendering never waits for the simulation.
  */
 class DynamicSystemBoidRenderable : public HierarchicalRenderable
 {
@@ -25,28 +35,79 @@ public:
      */
     DynamicSystemBoidRenderable(DynamicSystemBoidPtr system);
 
+    /**@brief Destructor, stops the simulation thread.
+     */
+    ~DynamicSystemBoidRenderable();
+
     /**@brief Change the managed dynamic system.
      *
      * Change the dynamic system that will be managed by this renderable.
      * @param system The new dynamic system managed by this.
      */
     void setDynamicSystem(const DynamicSystemBoidPtr &system);
-    
+
+    /**@brief Set the speed of the simulation.
+     *
+     * Scale the elapsed time before it is simulated: a factor of 2 simulates
+     * the island twice faster than real time, as long as the budget of
+     * simulation steps per round allows it.
+     * @param timeScale The new factor applied to the elapsed time.
+     */
+    void setTimeScale(float timeScale);
+
+    /**@brief Set the budget of simulation steps per round.
+     *
+     * Bound the number of simulation steps computed before a snapshot is
+     * published, so that the simulation does not fall further and further
+     * behind. The time which does not fit in this budget is dropped.
+     * @param maxSubsteps The new maximal number of steps per round.
+     */
+    void setMaxSubsteps(unsigned int maxSubsteps);
+
+    /**@brief Choose whether the simulation runs on its own thread.
+     *
+     * The renderables reading the boids directly, instead of the snapshots,
+     * require the simulation to run on the rendering thread.
+     * @param asynchronous True to step the simulation on its own thread.
+     */
+    void setAsynchronous(bool asynchronous);
+
 private:
     /**@brief Implementation of do_draw. Does nothing.
      */
     void do_draw();
-    
+
     /**@brief Update the dynamic system.
      *
      * This function will update the managed dynamic system, i.e. compute the
-     * new positions and velocities of the particles. This update will be
-     * actually done only if the last time the system was updated was more
-     * than m_sytem->m_dt ago. This allows us to update the dynamic system
-     * at the specified time interval.
+     * new positions and velocities of the particles. The elapsed time, scaled
+     * by m_timeScale, is added to the time to simulate. The simulation thread
+     * is woken up to consume it by steps of m_sytem->m_dt, or the steps are
+     * computed here if the simulation is not asynchronous. Then the last
+     * published snapshot is acquired, with how far between its two steps
+     * the boids should be displayed.
      */
     void do_animate( float time );
 
+    /**@brief Simulate up to the target time.
+     *
+     * Compute as many steps as the target time allows, within m_maxSubsteps,
+     * and publish a snapshot of the boids if a step was computed.
+     */
+    void simulate();
+
+    /**@brief Main loop of the simulation thread.
+     */
+    void run();
+
+    /**@brief Start the simulation thread, if it is not running.
+     */
+    void start();
+
+    /**@brief Stop the simulation thread, if it is running.
+     */
+    void stop();
+
     /**@brief Dynamic system managed by this renderable.
      *
      * The dynamic system that is managed by this renderable, to compute
@@ -54,14 +115,51 @@ private:
      */
     DynamicSystemBoidPtr m_system;
 
-    /**@brief Last time the dynamic system was updated.
+    /**@brief Last time the dynamic system was animated.
      *
-     * Store the last time the dynamic system was updated. This is used to
-     * keep updating the dynamic system at the specified time interval.
+     * Store the time of the last call to do_animate, to compute the time
+     * elapsed since then.
      */
     float m_lastUpdateTime;
+
+    /**@brief Scaled time elapsed since the first animation.
+     *
+     * Sum of the elapsed times multiplied by m_timeScale, the time the
+     * simulation tries to reach.
+     */
+    double m_scaledTime;
+
+    /**@brief Time the simulation has to reach, m_scaledTime shared with the simulation thread. */
+    std::atomic<double> m_targetTime;
+
+    /**@brief Time reached by the simulation, only used by the thread stepping it. */
+    double m_simulatedTime;
+
+    /**@brief Factor applied to the elapsed time before it is simulated. */
+    float m_timeScale;
+
+    /**@brief Maximal number of simulation steps computed per round. */
+    std::atomic<unsigned int> m_maxSubsteps;
+
+    /**@brief True if the simulation runs on its own thread. */
+    bool m_asynchronous;
+
+    /**@brief True once a first snapshot of the boids was published. */
+    bool m_published;
+
+    /**@brief True while the simulation thread must keep running. */
+    bool m_running;
+
+    /**@brief The simulation thread. */
+    std::thread m_thread;
+
+    /**@brief Protect m_running and the target time for the wake up of the simulation thread. */
+    std::mutex m_mutex;
+
+    /**@brief Wake up the simulation thread when there is time to simulate. */
+    std::condition_variable m_wakeUp;
 };
 
 typedef std::shared_ptr<DynamicSystemBoidRenderable> DynamicSystemBoidRenderablePtr;
 
-#endif
\ No newline at end of file
+#endif
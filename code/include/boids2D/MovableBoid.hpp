@@ -109,13 +109,30 @@ class MovableBoid : public Boid
 
   /**
    * @brief     Update the acceleration of the boid. Save the value
-   *            in the acceleration field of the class
+   *            in the acceleration field of the class.
+   *            The full update only runs every few ticks, depending on the state
+   *            of the boid, its distance to the camera and its neighbours. In
+   *            between, the boid keeps its last acceleration, unless a predator
+   *            comes close.
    * @param[in] boidsManager The boid's manager
    * @param[in] dt           Time step
    * @param[in] updateTick   True if the current tick should have update of state of boids
    */
   void computeAcceleration(BoidsManager & boidsManager, const float & dt, const bool & updateTick);
 
+  /**
+   * @brief  Getter for the number of ticks covered by the current update,
+   *         the ticks skipped since the previous update included
+   * @return Number of ticks, at least 1 during an update
+   */
+  const unsigned int & getUpdateTicks() const;
+
+  /**
+   * @brief     Check if a predator was in the surrounding boxes at the last tick
+   * @return    True if a predator of the boid was around, false otherwise
+   */
+  bool isPredatorAround() const;
+
   /**
    * @brief     Update the position and the velocity for the next step in the simulation 
    * @param[in] dt Value of the time step
@@ -123,6 +140,18 @@ class MovableBoid : public Boid
    */
   const glm::vec3 computeNextStep(const float & dt, const BoidsManagerPtr & boidsManager);
 
+  /**
+   * @brief  Getter for the location before the last step of the simulation
+   * @return The previous location
+   */
+  const glm::vec3 & getPreviousLocation() const;
+
+  /**
+   * @brief  Getter for the angle before the last step of the simulation
+   * @return The previous angle
+   */
+  const float & getPreviousAngle() const;
+
   /**
    * @brief     Check if the other boid is in the cone of vision of this
    * @param[in] other     The other boid to check if in range
@@ -277,7 +306,10 @@ class MovableBoid : public Boid
   glm::vec3 m_acceleration; ///< Acceleration of the boid
   float m_mass; ///< Mass of the boid
 
-  MovableStatePtr m_currentState; ///< State of the boid
+  glm::vec3 m_previousLocation; ///< Location of the boid before the last step
+  float m_previousAngle; ///< Angle of the boid before the last step
+
+  const MovableState * m_currentState; ///< State of the boid, shared with the other boids in this state
   MovableParametersPtr m_parameters; ///< Parameter of the boid
 
   MovableBoidPtr m_movablePrey; ///< Movable prey of the boid. (If exist cannot have a rooted prey)
@@ -298,6 +330,21 @@ class MovableBoid : public Boid
 
   float m_mateStatus;
 
+  unsigned int m_updatePeriod; ///< Number of ticks between two full updates of the boid
+  unsigned int m_updateTicks; ///< Number of ticks since the last full update
+  bool m_missedUpdateTick; ///< True if an update tick was skipped since the last full update
+  bool m_predatorAround; ///< True if a predator was in the surrounding boxes at the last tick
+
+  /**
+   * @brief     Compute the number of ticks until the next full update
+   * @param[in] boidsManager  Reference of the boidsManager
+   * @param[in] i             Index of the line of the boid in the grid
+   * @param[in] j             Index of the column of the boid in the grid
+   * @return    1 for the boids interacting with others, up to MAX_UPDATE_PERIOD
+   *            for the resting boids and the boids walking far from the camera
+   */
+  unsigned int computeUpdatePeriod(const BoidsManager & boidsManager, const unsigned int & i, const unsigned int & j) const;
+
   /**
    * @brief     Make all the change when a boid get to the new state stateType
    * @param[in] stateType     The state the boid change to
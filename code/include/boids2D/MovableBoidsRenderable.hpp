@@ -4,6 +4,7 @@
 #include <glm/glm.hpp>
 #include "../HierarchicalRenderable.hpp"
 #include "./../lighting/Material.hpp"
+#include "./../AssetManager.hpp"
 #include <vector>
 #include "BoidsManager.hpp"
 
@@ -24,6 +25,8 @@ class MovableBoidsRenderable : public HierarchicalRenderable
     private:
         void do_draw();
         void do_animate( float time );
+        unsigned int do_getTextureKey() const;
+        unsigned int do_getMeshKey() const;
         void compute_modelMatrix();
 
         std::vector< glm::vec2 > m_texCoords;
@@ -35,7 +38,7 @@ class MovableBoidsRenderable : public HierarchicalRenderable
 	    std::vector< unsigned int > m_VAOs;
 	    unsigned int m_VBO;
 	    unsigned int m_tBuffer;
-	    unsigned int m_texId;
+	    TexturePtr m_texture;
 
 	    MaterialPtr m_material;
 	    BoidType m_boidType;
@@ -3,10 +3,84 @@
 
 #include "BoidType.hpp"
 #include <memory>
+#include <string>
+
+/**
+ * @struct SpeciesParameters
+ * @brief  Immutable parameters of a species, shared by all its boids.
+ *         The motion values come from the file of the species and the
+ *         boundaries and coefficients of the vitals from VariableParameters.json.
+ */
+struct SpeciesParameters
+{
+  float maxSpeedWalk; ///< Maximum speed of the boid when walking
+  float maxSpeedRun; ///< Maximum speed of the boid when running
+  float maxForce; ///< Maximum force of the boid
+
+  float angleView; ///< Angle of vision
+
+  float distSeparate; ///< Distance of separation
+  float distCohesion; ///< Distance of cohesion
+  float distViewMax; ///< Distance of the maximum view
+  float distToLeader; ///< Distance to respect behind the leader
+  float distStartSlowingDown; ///< Distance before start slowing down
+  float distSeeAhead; ///< Distance to see ahead the obstacle
+  float distAttack; ///< Distance to check if the boid is close enough to consider it is eating
+  float distMaxToLeader; ///< Distance to stay around the leader
+
+  float rCircleWander; ///< Radius of the wander circle
+  float distToCircle; ///< Distance between the boid and the center of the wander circle
+
+  float lowStaminaValue; ///< Value of the low stamina
+  float highStaminaValue; ///< Value of the high stamina
+
+  float lowHungerValue; ///< Value of the low hunger
+  float highHungerValue; ///< Value of the high hunger
+
+  float lowThirstValue; ///< Value of the low thirst
+  float highThirstValue; ///< Value of the high thirst
+
+  float lowDangerValue; ///< Value of the low danger
+  float highDangerValue; ///< Value of the high danger
+
+  float staminaIncCoeff; ///< Coefficient to increase the stamina
+  float staminaDecCoeffWalk; ///< Coefficient to decrease the stamina when walking
+  float staminaDecCoeffRun; ///< Coefficient to decrease the stamina when running
+
+  float hungerIncCoeff; ///< Coefficient to increase the hunger
+  float hungerDecCoeffWalk; ///< Coefficient to decrease the hunger when walking
+  float hungerDecCoeffRun; ///< Coefficient to decrease the hunger when running
+
+  float thirstIncCoeff; ///< Coefficient to increase the thirst
+  float thirstDecCoeffWalk; ///< Coefficient to decrease the thirst when walking
+  float thirstDecCoeffRun; ///< Coefficient to decrease the thirst when running
+
+  float affinityIncCoeff; ///< Coefficient to increase the affinity
+  float affinityDecCoeff; ///< Coefficient to decrease the affinity
+
+  float dangerIncCoeff; ///< Coefficient to increase the danger
+  float dangerDecCoeff; ///< Coefficient to decrease the danger
+};
+
+typedef std::shared_ptr<const SpeciesParameters> SpeciesParametersPtr;
+
+/**
+ * @struct BoidVitals
+ * @brief  Mutable values of a boid, the only parameters not shared with its species
+ */
+struct BoidVitals
+{
+  float stamina; ///< Value in [0, 100] to describe the stamina of a boid
+  float hunger; ///< Value in [0, 100] to describe the hunger of a boid
+  float thirst; ///< Value in [0, 100] to describe the thirst of a boid
+  float danger; ///< Value in [0, 100] to describe the feel of danger of a boid
+  float affinity; ///< Value in [0, 100] to describe the affinity of a boid
+};
 
 /**
  * @class MovableParameters
- * @brief Class with all the parameters of a boid and method to check their value
+ * @brief Class with all the parameters of a boid and method to check their value.
+ *        The parameters of the species are shared, only the vitals belong to the boid.
  */
 class MovableParameters
 {
@@ -59,14 +133,15 @@ public:
     float distToCircle);
 	
   /**
-   * @brief     Constructor for MovableParameters from a file
+   * @brief     Constructor for MovableParameters from a file.
+   *            The file is parsed once, then its parameters are shared.
    * @param[in] filename Name of the file
    */
   MovableParameters(const std::string & filename);
 
   /**
    * @brief     Constructor for MovableParaeters from a type.
-   *            (Call the constructor from a file)
+   *            (Share the parameters of the file of the species)
    * @param[in] type Type of the requested boid
    */
   MovableParameters(const BoidType & type);
@@ -335,61 +410,40 @@ public:
 
   void resetAffinity();
 
- private:
-  float m_maxSpeedWalk; ///< Maximum speed of the boid
-  float m_maxSpeedRun; ///< Maximum speed of the boid
-  float m_maxForce; ///< Maximum force of the boid
-
-  float m_angleView; ///< Angle of vision
-
-  float m_distSeparate; ///< Distance of separation
-  float m_distCohesion; ///< Distance of cohesion
-  float m_distViewMax; ///< Distance of the maximum view
-  float m_distToLeader; ///< Distance to respect behind the leader
-  float m_distStartSlowingDown; ///< Distance before start slowing down
-  float m_distSeeAhead; ///< Distance to see ahead the obstacle
-  float m_distAttack; ///< Distance to check if the boid is close enough to consider it is eating
-  float m_distMaxToLeader; ///< Distance to stay around the leader
-
-  float m_rCircleWander; ///< Radius of the wander circle 
-  float m_distToCircle; ///< Distance between the boid and the center of the wander circle
-
-  float m_danger; ///< Value in [0, 100] to describe the feel of danger of a boid
-  float m_affinity; ///< Value in [0, 100] to describe the affinity of a boid
-
-  float m_stamina; ///< Value in [0, 100] to describe the stamina of a boid
-  float m_hunger; ///< Value in [0, 100] to describe the hunger of a boid
-  float m_thirst; ///< Value in [0, 100] to describe the thirst of a boid
-
-  float m_lowStaminaValue; ///< Value of the low stamina
-  float m_highStaminaValue; ///< Value of the high stamina
-
-  float m_lowHungerValue; ///< Value of the low hunger
-  float m_highHungerValue; ///< Value of the high hunger
-
-  float m_lowThirstValue; ///< Value of the low thirst
-  float m_highThirstValue; ///< Value of the high thirst
-
-  float m_lowDangerValue; ///< Value of the low danger
-  float m_highDangerValue; ///< Value of the high danger
-
-  float m_staminaIncCoeff; ///< Coefficient to increase the stamina
-  float m_staminaDecCoeffWalk; ///< Coefficient to decrease the stamina when walking
-  float m_staminaDecCoeffRun; ///< Coefficient to decrease the stamina when running
+  /**********************************
+          Needs events
+  ***********************************/
+  /**
+   * @brief  Check if a need of the boid changed since the last call, that is
+   *         if a vital crossed one of the thresholds checked by the states
+   * @return True if a threshold was crossed, false otherwise
+   */
+  bool popNeedsChanged();
 
-  float m_hungerIncCoeff; ///< Coefficient to increase the hunger
-  float m_hungerDecCoeffWalk; ///< Coefficient to decrease the hunger when walking
-  float m_hungerDecCoeffRun; ///< Coefficient to decrease the hunger when running
+  /**
+   * @brief Make the next call to popNeedsChanged return true,
+   *        to check the needs after a change of state
+   */
+  void raiseNeedsChanged();
 
-  float m_thirstIncCoeff; ///< Coefficient to increase the thirst
-  float m_thirstDecCoeffWalk; ///< Coefficient to decrease the thirst when walking
-  float m_thirstDecCoeffRun; ///< Coefficient to decrease the thirst when running
+ private:
+  /**
+   * @brief Recompute the needs of the boid after a change of its vitals,
+   *        and record whether one of them changed
+   */
+  void updateNeeds();
 
-  float m_affinityIncCoeff; ///< Coefficient to increase the affinity
-  float m_affinityDecCoeff; ///< Coefficient to decrease the affinity
+  /**
+   * @brief     Get the parameters of a species, parsing its file at the first request only
+   * @param[in] filename Name of the file describing the species
+   * @return    The parameters shared by every boid of the species
+   */
+  static SpeciesParametersPtr loadSpecies(const std::string & filename);
 
-  float m_dangerIncCoeff; ///< Coefficient to increase the danger
-  float m_dangerDecCoeff; ///< Coefficient to decrease the danger
+  SpeciesParametersPtr m_species; ///< Parameters shared by every boid of the species
+  BoidVitals m_vitals; ///< Vital values of this boid
+  unsigned short m_needs; ///< Result of each threshold check of the vitals, one bit per check
+  bool m_needsChanged; ///< True if a bit of m_needs changed since the last popNeedsChanged
 };
 
 typedef std::shared_ptr<MovableParameters> MovableParametersPtr;
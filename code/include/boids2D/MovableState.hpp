@@ -5,6 +5,8 @@
 #include <list>
 #include <cmath>
 #include "BoidsManager.hpp"
+#include "StateType.hpp"
+#include "../terrain/SteeringField.hpp"
 
 class BoidsManager;
 typedef std::shared_ptr<BoidsManager> BoidsManagerPtr;
@@ -18,7 +20,9 @@ typedef std::shared_ptr<RootedBoid> RootedBoidPtr;
 /**
  * @class MovableState
  * @brief Virtual class to describe a state of boid. Contain some methods
- *        to compute a force for a boid 
+ *        to compute a force for a boid.
+ *        The states hold no data, so one instance of each state is shared
+ *        by all the boids. @see get
  */
 class MovableState 
 {
@@ -29,6 +33,13 @@ class MovableState
    */
   virtual ~MovableState() {};
 
+  /**
+   * @brief     Get the instance of a state shared by all the boids
+   * @param[in] stateType Type of the state
+   * @return    The state, never destroyed nor copied
+   */
+  static const MovableState & get(const StateType & stateType);
+
   /**
    * @brief     Returns the acceleration and reset the acceleration of the boid
    * @param[in] b             The boid which has its acceleration reset and computed.
@@ -102,13 +113,17 @@ class MovableState
   
   /**
    * @brief Compute the force for a boid to stay in the island
+   * @param[in] b        The concerned boid
+   * @param[in] steering The steering data of the terrain at the location of the boid
    */
-  glm::vec3 stayOnIsland(const MovableBoid & b, const BoidsManager & boidsManager) const;
+  glm::vec3 stayOnIsland(const MovableBoid & b, const SteeringSample & steering) const;
 
   /**
-   * @brief Compute the force for a boid to avoid walking on mountains and inside lake
+   * @brief Compute the force for a boid to avoid walking on mountains and steep slopes
+   * @param[in] b        The concerned boid
+   * @param[in] steering The steering data of the terrain at the location of the boid
    */
-  glm::vec3 coherentWalk(const MovableBoid & b, const BoidsManager & boidsManager) const;
+  glm::vec3 coherentWalk(const MovableBoid & b, const SteeringSample & steering) const;
 
   /**
    * @brief     Computes the force for a boid b separate from others boids
@@ -50,8 +50,10 @@ class ConstantForceField : public ForceField
         void setForce(const glm::vec3& force);
 
     private:
-        void do_addForce();
+        void do_bind(const ParticleArrays& particles);
+        void do_addForce(const ParticleArrays& particles, std::vector<glm::vec3>& forces);
         std::vector<ParticlePtr> m_particles;
+        std::vector<std::size_t> m_indices; ///< Indices of m_particles in the arrays, the missing ones skipped
         glm::vec3 m_force;
 };
 
@@ -50,8 +50,11 @@ class DampingForceField : public ForceField
         void setDamping(const float& damping);
 
     private:
-        void do_addForce();
+        void do_bind(const ParticleArrays& particles);
+        void do_addForce(const ParticleArrays& particles, std::vector<glm::vec3>& forces);
+        void do_addJacobians(const ParticleArrays& particles, SparseBlockMatrix& dfdx, SparseBlockMatrix& dfdv);
         std::vector<ParticlePtr> m_particles;
+        std::vector<std::size_t> m_indices; ///< Indices of m_particles in the arrays, the missing ones skipped
         float m_damping;
 };
 
@@ -5,6 +5,7 @@
 
 #include "ForceField.hpp"
 #include "Particle.hpp"
+#include "ParticleArrays.hpp"
 #include "Solver.hpp"
 
 /**@brief A dynamic system.
@@ -14,6 +15,10 @@
  * replace fixed planes obstacles by triangle obstacles: you will be able to
  * model more kind of obstacles. However, this would require a spatial optimization
  * that is out of the scope of these practical lessons.
+ *
+ * The simulation steps are computed in a copy of the particles stored as a
+ * structure of arrays, the force fields of large systems being accumulated
+ * in parallel.
  */
 class DynamicSystem
 {
@@ -48,6 +53,25 @@ private:
      */
     std::vector<ParticlePtr> m_particles;
 
+    /**@brief The particles stored as a structure of arrays.
+     *
+     * The arrays the force fields and the solver work on during a simulation
+     * step, copied from m_particles before and back to them after.
+     */
+    ParticleArrays m_arrays;
+
+    /**@brief True if m_particles changed since the arrays were indexed. */
+    bool m_particlesChanged;
+
+    /**@brief Forces accumulated by each thread.
+     *
+     * When the force fields are accumulated in parallel, each thread adds the
+     * forces of its fields to a buffer of its own. These buffers are summed
+     * afterwards, so that two springs sharing a particle never write to the
+     * same force at once.
+     */
+    std::vector< std::vector<glm::vec3> > m_threadForces;
+
 public:
     ~DynamicSystem();
     DynamicSystem();
@@ -104,6 +128,31 @@ public:
      */
     void setForceFields(const std::vector<ForceFieldPtr> &forceFields);
 
+    /**@brief Access to the particles stored as a structure of arrays.
+     *
+     * Get the arrays the solver integrates during a simulation step.
+     * @return The particle arrays of this system.
+     */
+    ParticleArrays& getParticleArrays();
+
+    /**@brief Compute the forces applied to the particles.
+     *
+     * Reset the forces of the particle arrays, then add the forces of the
+     * force fields, for the current positions and velocities of the arrays.
+     * Called at the beginning of each simulation step, and by the solvers
+     * which need the forces at intermediate states.
+     */
+    void computeForces();
+
+    /**@brief Compute the Jacobians of the forces.
+     *
+     * Compute the derivatives of the forces of the force fields with respect
+     * to the positions and velocities of the particle arrays.
+     * @param dfdx The derivatives with respect to the positions.
+     * @param dfdv The derivatives with respect to the velocities.
+     */
+    void computeJacobians(SparseBlockMatrix& dfdx, SparseBlockMatrix& dfdv);
+
 
     /**@brief Compute a simulation step for this system.
      *
@@ -5,7 +5,9 @@
 
 /**@brief Explicit Euler solver.
  *
- * Explicit Euler dynamic system solver.
+ * Explicit Euler dynamic system solver: the positions are integrated with
+ * the velocities of the beginning of the step. Only stable for small time
+ * steps, see SymplecticEulerSolver for the same cost.
  */
 class EulerExplicitSolver : public Solver
 {
@@ -13,7 +15,7 @@ public:
     EulerExplicitSolver();
     ~EulerExplicitSolver();
 private:
-    void do_solve(const float& dt, std::vector<ParticlePtr>& particles);
+    void do_solve(const float& dt, DynamicSystem& system);
 };
 
 typedef std::shared_ptr<EulerExplicitSolver> EulerExplicitSolverPtr;
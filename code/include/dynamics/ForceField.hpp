@@ -2,11 +2,17 @@
 #define FORCE_FIELD_HPP
 
 #include <memory>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "ParticleArrays.hpp"
+#include "SparseBlockMatrix.hpp"
 
 /**@brief Force field interface.
  *
  * Define an interface for a force field. A force field applies forces
- * to a set of handled particles. Those particles are stored in derived classes.
+ * to a set of handled particles. Those particles are stored in derived classes,
+ * which work on their indices in the arrays of the dynamic system.
  */
 class ForceField
 {
@@ -16,16 +22,67 @@ public:
 
   /**@brief Add a force to particles.
    *
-   * Add a force to the particles influenced by this force field.
+   * Add the force of this force field to the particles it influences. The
+   * indices of these particles in the arrays are resolved again if the
+   * particles of the arrays changed since the last call.
+   * @param particles The arrays of the particles of the dynamic system.
+   * @param forces The forces to add to, indexed as the particles.
    */
-  void addForce();
+  void addForce(const ParticleArrays& particles, std::vector<glm::vec3>& forces);
+
+  /**@brief Add the derivatives of the force to the Jacobians of the system.
+   *
+   * Used by the implicit solvers. A force field that does not implement
+   * its derivatives is integrated explicitly by these solvers.
+   * @param particles The arrays of the particles of the dynamic system.
+   * @param dfdx The derivatives of the forces with respect to the positions.
+   * @param dfdv The derivatives of the forces with respect to the velocities.
+   */
+  void addJacobians(const ParticleArrays& particles, SparseBlockMatrix& dfdx, SparseBlockMatrix& dfdv);
+
+protected:
+  /**@brief Resolve the indices of the particles again at the next call to addForce.
+   *
+   * To call when the particles influenced by this force field change.
+   */
+  void unbind();
+
 private:
+  /**@brief Resolve the indices of the particles if the arrays changed since the last time.
+   *
+   * @param particles The arrays of the particles of the dynamic system.
+   */
+  void bind(const ParticleArrays& particles);
+
+  /**@brief Bind implementation.
+   *
+   * Store the indices in the arrays of the particles influenced by this
+   * force field. This should be implemented in derived classes.
+   * @param particles The arrays of the particles of the dynamic system.
+   */
+  virtual void do_bind(const ParticleArrays& particles) = 0;
+
   /**@brief Add force implementation.
    *
    * The actual implementation to add force to the particles.
    * This should be implemented in derived classes.
+   * @param particles The arrays of the particles of the dynamic system.
+   * @param forces The forces to add to, indexed as the particles.
    */
-  virtual void do_addForce() = 0;
+  virtual void do_addForce(const ParticleArrays& particles, std::vector<glm::vec3>& forces) = 0;
+
+  /**@brief Add Jacobians implementation.
+   *
+   * The actual implementation to add the derivatives of the force. Does
+   * nothing by default.
+   * @param particles The arrays of the particles of the dynamic system.
+   * @param dfdx The derivatives of the forces with respect to the positions.
+   * @param dfdv The derivatives of the forces with respect to the velocities.
+   */
+  virtual void do_addJacobians(const ParticleArrays& particles, SparseBlockMatrix& dfdx, SparseBlockMatrix& dfdv);
+
+  const ParticleArrays* m_boundArrays; /*!< The arrays the indices were resolved in. */
+  unsigned int m_boundVersion; /*!< The version of these arrays at that time. */
 };
 
 typedef std::shared_ptr<ForceField> ForceFieldPtr;
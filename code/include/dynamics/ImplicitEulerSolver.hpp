@@ -0,0 +1,54 @@
+#ifndef IMPLICIT_EULER_SOLVER_HPP
+#define IMPLICIT_EULER_SOLVER_HPP
+
+#include "Solver.hpp"
+#include "SparseBlockMatrix.hpp"
+
+/**@brief Linearly implicit (backward) Euler solver.
+ *
+ * Implicit Euler dynamic system solver, linearized around the beginning of
+ * the step: the change of velocity dv solves
+ * (M - dt * df/dv - dt^2 * df/dx) dv = dt * (f + dt * df/dx * v),
+ * then the positions are integrated with the new velocities. The system is
+ * solved by a conjugate gradient, preconditioned by its diagonal, the fixed
+ * particles being kept out of it. Stable with stiff springs at time steps
+ * far larger than the explicit solvers, at the cost of damping the motion.
+ */
+class ImplicitEulerSolver : public Solver
+{
+public:
+    /**@brief Build an implicit Euler solver.
+     *
+     * @param maxIterations The maximal number of iterations of the conjugate gradient.
+     * @param tolerance The residual, relative to the right hand side, at which the conjugate gradient stops.
+     */
+    ImplicitEulerSolver(unsigned int maxIterations = 100, float tolerance = 1e-4f);
+    ~ImplicitEulerSolver();
+
+private:
+    void do_solve(const float& dt, DynamicSystem& system);
+
+    /**@brief Multiply a vector by the matrix of the system.
+     *
+     * @param particles The particle arrays, for their masses and fixed flags.
+     * @param dt The time step.
+     * @param x The vector to multiply.
+     * @param y The result, null for the fixed particles.
+     */
+    void multiply(const ParticleArrays& particles, const float& dt,
+                  const std::vector<glm::vec3>& x, std::vector<glm::vec3>& y);
+
+    unsigned int m_maxIterations; /*!< Maximal number of iterations of the conjugate gradient. */
+    float m_tolerance; /*!< Relative residual at which the conjugate gradient stops. */
+
+    SparseBlockMatrix m_dfdx; /*!< Derivatives of the forces with respect to the positions. */
+    SparseBlockMatrix m_dfdv; /*!< Derivatives of the forces with respect to the velocities. */
+
+    /** Buffers of the conjugate gradient, kept from a step to the next one. */
+    std::vector<glm::vec3> m_dv, m_b, m_r, m_z, m_p, m_q, m_tmp;
+    std::vector<glm::vec3> m_preconditioner; /*!< Inverse of the diagonal of the matrix of the system. */
+};
+
+typedef std::shared_ptr<ImplicitEulerSolver> ImplicitEulerSolverPtr;
+
+#endif //IMPLICIT_EULER_SOLVER_HPP
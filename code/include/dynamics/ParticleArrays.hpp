@@ -0,0 +1,87 @@
+#ifndef PARTICLE_ARRAYS_HPP
+#define PARTICLE_ARRAYS_HPP
+
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "Particle.hpp"
+
+/**@brief The particles of a dynamic system, stored as a structure of arrays.
+ *
+ * The particles are shared with the renderables and the force fields, each one
+ * allocated on its own. To compute a simulation step, their positions, velocities
+ * and masses are copied in contiguous arrays, indexed by the order of the particles
+ * in the system. The force fields accumulate their forces and the solver integrates
+ * in these arrays, then the new states are copied back to the particles.
+ */
+class ParticleArrays
+{
+public:
+    /**@brief Index of a particle which is not stored in these arrays. */
+    static const std::size_t npos = static_cast<std::size_t>(-1);
+
+    ParticleArrays();
+    ~ParticleArrays();
+
+    /**@brief Set the particles stored in these arrays.
+     *
+     * Index the particles by their order and resize the arrays. The force
+     * fields bound to the previous particles will bind themselves again.
+     * @param particles The particles to store.
+     */
+    void setParticles(const std::vector<ParticlePtr>& particles);
+
+    /**@brief Access to the index of a particle.
+     *
+     * Get the index of a particle in the arrays.
+     * @param particle The particle to look for.
+     * @return The index of the particle, npos if it is not stored here.
+     */
+    std::size_t indexOf(const ParticlePtr& particle) const;
+
+    /**@brief Access to the number of particles.
+     *
+     * @return The number of particles stored in these arrays.
+     */
+    std::size_t size() const;
+
+    /**@brief Access to the version of the indices.
+     *
+     * The version changes each time the particles are set, for the force
+     * fields to know if the indices they hold are still valid.
+     * @return The version of the indices.
+     */
+    unsigned int getVersion() const;
+
+    /**@brief Copy the state of the particles in the arrays.
+     *
+     * Copy the positions, velocities, masses and fixed flags of the particles.
+     */
+    void gather();
+
+    /**@brief Copy the arrays back to the particles.
+     *
+     * Set the positions, velocities and forces of the particles.
+     */
+    void scatter() const;
+
+    std::vector<glm::vec3> positions;  /*!< Position of each particle. */
+    std::vector<glm::vec3> velocities; /*!< Velocity of each particle. */
+    std::vector<glm::vec3> forces;     /*!< Force applied to each particle. */
+    std::vector<float> masses;         /*!< Mass of each particle. */
+    std::vector<unsigned char> fixed;  /*!< Non zero for each fixed particle. */
+
+private:
+    /**@brief The particles stored, in the order of the arrays. */
+    std::vector<ParticlePtr> m_particles;
+
+    /**@brief Index of each particle in the arrays. */
+    std::unordered_map<const Particle*, std::size_t> m_indices;
+
+    /**@brief Version of the indices, changed by setParticles. */
+    unsigned int m_version;
+};
+
+#endif //PARTICLE_ARRAYS_HPP
@@ -3,7 +3,9 @@
 
 #include <memory>
 #include <vector>
-#include "Particle.hpp"
+#include "ParticleArrays.hpp"
+
+class DynamicSystem;
 
 /**@brief Dynamic system solver interface.
  *
@@ -18,18 +20,21 @@ public:
    *
    * Solve the dynamic system of particles for a specified time step.
    * @param dt The time step for the integration.
-   * @param particles The collection of particles.
+   * @param system The dynamic system, its particle arrays holding the forces
+   * applied at the beginning of the step.
    */
-  void solve( const float& dt, std::vector<ParticlePtr>& particles );
+  void solve( const float& dt, DynamicSystem& system );
 private:
   /**@brief Solve implementation.
    *
    * The actual implementation to solve the dynamic system. This should
-   * be implemented in derived classes.
+   * be implemented in derived classes, which may compute the forces again
+   * during the step.
    * @param dt The time step for the integration.
-   * @param particles The collection of particles.
+   * @param system The dynamic system, its particle arrays holding the forces
+   * applied at the beginning of the step.
    */
-  virtual void do_solve(const float& dt, std::vector<ParticlePtr>& particles) = 0;
+  virtual void do_solve(const float& dt, DynamicSystem& system) = 0;
 };
 
 typedef std::shared_ptr<Solver> SolverPtr;
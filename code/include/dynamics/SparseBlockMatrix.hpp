@@ -0,0 +1,70 @@
+#ifndef SPARSE_BLOCK_MATRIX_HPP
+#define SPARSE_BLOCK_MATRIX_HPP
+
+#include <cstddef>
+#include <vector>
+#include <glm/glm.hpp>
+
+/**@brief A sparse matrix of 3x3 blocks.
+ *
+ * Store the derivatives of the forces of a dynamic system with respect to
+ * the positions or the velocities of its particles: the block (i,j) is the
+ * derivative of the force of the particle i with respect to the state of
+ * the particle j. The diagonal blocks are stored densely, the other ones as
+ * a list of entries, a block added twice being the sum of the two.
+ */
+class SparseBlockMatrix
+{
+public:
+    SparseBlockMatrix();
+    ~SparseBlockMatrix();
+
+    /**@brief Resize and clear the matrix.
+     *
+     * Set all the blocks to zero, for a given number of particles.
+     * @param size The number of block rows and columns.
+     */
+    void reset(std::size_t size);
+
+    /**@brief Access to the number of block rows.
+     *
+     * @return The number of block rows and columns.
+     */
+    std::size_t size() const;
+
+    /**@brief Add a block to the matrix.
+     *
+     * @param i The block row.
+     * @param j The block column.
+     * @param block The block to add at (i,j).
+     */
+    void addBlock(std::size_t i, std::size_t j, const glm::mat3& block);
+
+    /**@brief Access to a diagonal block.
+     *
+     * @param i The block row and column.
+     * @return The block at (i,i).
+     */
+    const glm::mat3& getDiagonalBlock(std::size_t i) const;
+
+    /**@brief Multiply a vector by this matrix.
+     *
+     * @param x The vector to multiply, one 3D vector per block column.
+     * @param y The result, resized to one 3D vector per block row.
+     */
+    void multiply(const std::vector<glm::vec3>& x, std::vector<glm::vec3>& y) const;
+
+private:
+    /**@brief A block outside the diagonal. */
+    struct Entry
+    {
+        std::size_t i;   /*!< The block row. */
+        std::size_t j;   /*!< The block column. */
+        glm::mat3 block; /*!< The value of the block. */
+    };
+
+    std::vector<glm::mat3> m_diagonal; /*!< The diagonal blocks. */
+    std::vector<Entry> m_entries;      /*!< The other blocks. */
+};
+
+#endif //SPARSE_BLOCK_MATRIX_HPP
@@ -38,19 +38,81 @@ class SpringForceField : public ForceField
          */
         ParticlePtr getParticle2() const;
 
+        /**@brief Access to the stiffness of this spring.
+         *
+         * @return The stiffness of this spring.
+         */
+        float getStiffness() const;
+        /**@brief Access to the equilibrium length of this spring.
+         *
+         * @return The equilibrium length of this spring.
+         */
+        float getEquilibriumLength() const;
+        /**@brief Access to the damping factor of this spring.
+         *
+         * @return The damping factor of this spring.
+         */
+        float getDamping() const;
+
+        /**@brief Add the force of a damped spring between two particles.
+         *
+         * Shared by this class and SpringListForceField, which loops over the
+         * indices of many springs.
+         * @param particles The arrays of the particles of the dynamic system.
+         * @param forces The forces to add to, indexed as the particles.
+         * @param index1 The index of the first particle of the spring.
+         * @param index2 The index of the second particle of the spring.
+         * @param stiffness spring stiffness
+         * @param equilibriumLength equilibrium length
+         * @param damping damping factor
+         */
+        static void addSpringForce(const ParticleArrays& particles, std::vector<glm::vec3>& forces,
+                std::size_t index1, std::size_t index2, float stiffness, float equilibriumLength, float damping);
+
+        /**@brief Add the derivatives of the force of a damped spring.
+         *
+         * The stiffness term depends on the positions of the two particles,
+         * the damping term on their velocities. The transverse stiffness of a
+         * compressed spring is dropped, to keep the system of the implicit
+         * solvers positive definite.
+         * @param particles The arrays of the particles of the dynamic system.
+         * @param dfdx The derivatives of the forces with respect to the positions.
+         * @param dfdv The derivatives of the forces with respect to the velocities.
+         * @param index1 The index of the first particle of the spring.
+         * @param index2 The index of the second particle of the spring.
+         * @param stiffness spring stiffness
+         * @param equilibriumLength equilibrium length
+         * @param damping damping factor
+         */
+        static void addSpringJacobians(const ParticleArrays& particles, SparseBlockMatrix& dfdx, SparseBlockMatrix& dfdv,
+                std::size_t index1, std::size_t index2, float stiffness, float equilibriumLength, float damping);
+
     private:
+        /**@brief Find the two particles in the arrays.
+         *
+         * Store the indices of the particles of this spring.
+         */
+        void do_bind(const ParticleArrays& particles);
+
         /**@brief Add the force of this spring to the two particles.
          *
          * Compute the forces applied by this spring to each particles
-         * and add them to the particles.
+         * and add them to the forces of the particles.
+         */
+        void do_addForce(const ParticleArrays& particles, std::vector<glm::vec3>& forces);
+
+        /**@brief Add the derivatives of the force of this spring.
+         *
+         * See addSpringJacobians().
          */
-        void do_addForce();
+        void do_addJacobians(const ParticleArrays& particles, SparseBlockMatrix& dfdx, SparseBlockMatrix& dfdv);
 
 
         const ParticlePtr m_p1, m_p2;
         float m_stiffness;
         float m_equilibriumLength;
         float m_damping;
+        std::size_t m_index1, m_index2;
 };
 
 typedef std::shared_ptr<SpringForceField> SpringForceFieldPtr;
@@ -0,0 +1,75 @@
+#ifndef SPRING_LIST_FORCE_FIELD_HPP
+#define SPRING_LIST_FORCE_FIELD_HPP
+
+#include <list>
+#include <vector>
+#include "ForceField.hpp"
+#include "SpringForceField.hpp"
+
+/**@brief Implement the force field of a set of springs.
+ *
+ * A system made of many springs, like a rope or a cloth, would call a
+ * SpringForceField per spring at each step. This force field applies the
+ * forces of a whole set of springs instead: their particles are resolved
+ * to pairs of indices once, and the forces are accumulated by a single
+ * loop over these pairs. The springs are only read when binding, they
+ * remain the ones drawn by SpringListRenderable.
+ */
+class SpringListForceField : public ForceField
+{
+    public:
+        /**@brief Build the force field of a set of springs.
+         *
+         * @param springForceFields The springs whose forces are applied.
+         * They should not be added to the dynamic system themselves.
+         */
+        SpringListForceField(const std::list<SpringForceFieldPtr>& springForceFields);
+
+        /**@brief Access to the springs of this force field.
+         *
+         * @return The springs whose forces are applied by this.
+         */
+        const std::list<SpringForceFieldPtr>& getSpringForceFields() const;
+
+        /**@brief Define the springs of this force field.
+         *
+         * @param springForceFields The new springs whose forces are applied.
+         */
+        void setSpringForceFields(const std::list<SpringForceFieldPtr>& springForceFields);
+
+    private:
+        /**@brief Resolve the particles of each spring to indices.
+         *
+         * Store the indices and the parameters of the springs whose two
+         * particles are in the arrays.
+         */
+        void do_bind(const ParticleArrays& particles);
+
+        /**@brief Add the forces of all the springs.
+         *
+         * Large sets of springs are accumulated in parallel, each thread in
+         * a buffer of its own, since two springs may share a particle.
+         */
+        void do_addForce(const ParticleArrays& particles, std::vector<glm::vec3>& forces);
+
+        /**@brief Add the derivatives of the forces of all the springs. */
+        void do_addJacobians(const ParticleArrays& particles, SparseBlockMatrix& dfdx, SparseBlockMatrix& dfdv);
+
+        /**@brief A spring resolved in the particle arrays. */
+        struct BoundSpring
+        {
+            std::size_t index1; /*!< Index of the first particle. */
+            std::size_t index2; /*!< Index of the second particle. */
+            float stiffness; /*!< Stiffness of the spring. */
+            float equilibriumLength; /*!< Equilibrium length of the spring. */
+            float damping; /*!< Damping factor of the spring. */
+        };
+
+        std::list<SpringForceFieldPtr> m_springForceFields;
+        std::vector<BoundSpring> m_springs; ///< The springs of m_springForceFields found in the arrays
+        std::vector< std::vector<glm::vec3> > m_threadForces; ///< Forces accumulated by each thread
+};
+
+typedef std::shared_ptr<SpringListForceField> SpringListForceFieldPtr;
+
+#endif // SPRING_LIST_FORCE_FIELD_HPP
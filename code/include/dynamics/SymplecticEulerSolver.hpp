@@ -0,0 +1,24 @@
+#ifndef SYMPLECTIC_EULER_SOLVER_HPP
+#define SYMPLECTIC_EULER_SOLVER_HPP
+
+#include "Solver.hpp"
+
+/**@brief Semi-implicit (symplectic) Euler solver.
+ *
+ * Semi-implicit Euler dynamic system solver: the velocities are integrated
+ * first, then the positions with the new velocities. As cheap as the explicit
+ * Euler solver, but it conserves the energy of the springs over time instead
+ * of pumping energy into them.
+ */
+class SymplecticEulerSolver : public Solver
+{
+public:
+    SymplecticEulerSolver();
+    ~SymplecticEulerSolver();
+private:
+    void do_solve(const float& dt, DynamicSystem& system);
+};
+
+typedef std::shared_ptr<SymplecticEulerSolver> SymplecticEulerSolverPtr;
+
+#endif //SYMPLECTIC_EULER_SOLVER_HPP
@@ -0,0 +1,25 @@
+#ifndef VELOCITY_VERLET_SOLVER_HPP
+#define VELOCITY_VERLET_SOLVER_HPP
+
+#include "Solver.hpp"
+
+/**@brief Velocity Verlet solver.
+ *
+ * Velocity Verlet dynamic system solver: the velocities are integrated with
+ * the average of the forces at the beginning and at the end of the step.
+ * Second order accurate, for twice the force computations of the Euler
+ * solvers. The velocity dependent forces of the end of the step are computed
+ * with the velocities of the middle of the step.
+ */
+class VelocityVerletSolver : public Solver
+{
+public:
+    VelocityVerletSolver();
+    ~VelocityVerletSolver();
+private:
+    void do_solve(const float& dt, DynamicSystem& system);
+};
+
+typedef std::shared_ptr<VelocityVerletSolver> VelocityVerletSolverPtr;
+
+#endif //VELOCITY_VERLET_SOLVER_HPP
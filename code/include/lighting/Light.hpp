@@ -6,6 +6,7 @@
 #include <glm/glm.hpp>
 
 #include "./../../include/ShaderProgram.hpp"
+#include "./../../include/UniformBuffer.hpp"
 
 /**
  * @brief A directional light.
@@ -50,13 +51,11 @@ public:
     DirectionalLight(const glm::vec3& direction, const glm::vec3& ambient, const glm::vec3& diffuse, const glm::vec3& specular);
 
     /**
-     * @brief Get location for the attributes of the light and send the data to the GPU as uniforms.
+     * @brief Write the light in its structure of the "Lights" uniform block.
      *
-     * @param program A pointer to the shader program where to get the locations.
-     * @param light A pointer to the light to send to the GPU.
-     * @return  True if everything was fine, false otherwise
+     * @param block The structure to fill.
      */
-    static bool sendToGPU(const ShaderProgramPtr& program, const DirectionalLightPtr& light);
+    void writeBlock(DirectionalLightBlock& block) const;
 
     /**
      * @brief Access to the direction of the light.
@@ -123,41 +122,6 @@ private:
     glm::vec3 m_ambient;    /*!< Intensity of the light with respect to the object ambient components. */
     glm::vec3 m_diffuse;    /*!< Intensity of the light with respect to the object diffuse components. */
     glm::vec3 m_specular;   /*!< Intensity of the light with respect to the object specular components. */
-
-    /**
-     * @brief Get the uniform name of the light.
-     *
-     * @return The name of the light in the shader.
-     */
-    std::string lightName() { return std::string("directionalLight"); }
-
-    /**
-     * @brief Get the uniform name of the direction of the light.
-     *
-     * @return The name of the direction of the light in the shader.
-     */
-    std::string directionName() { return std::string("direction"); }
-
-    /**
-     * @brief Get the uniform name of the ambient intensity of the light.
-     *
-     * @return The name of the ambient intensity of the light in the shader.
-     */
-    std::string ambientName() { return std::string("ambient"); }
-
-    /**
-     * @brief Get the uniform name of the diffuse intensity of the light.
-     *
-     * @return The name of the diffuse intensity of the light in the shader.
-     */
-    std::string diffuseName() { return std::string("diffuse"); }
-
-    /**
-     * @brief Get the uniform name of the specular intensity of the light.
-     *
-     * @return The name of the specular intensity of the light in the shader.
-     */
-    std::string specularName() { return std::string("specular"); }
 };
 
 typedef std::shared_ptr<DirectionalLight> DirectionalLightPtr; /*!< Smart pointer to a directional light */
@@ -206,22 +170,22 @@ public:
                const float& constant, const float& linear, const float& quadratic);
 
     /**
-     * @brief Get location for the attributes of the light and send the data to the GPU as uniforms.
+     * @brief Write the light in its structure of the "Lights" uniform block.
      *
-     * @param program A pointer to the shader program where to get the locations.
-     * @param light A pointer to the light to send to the GPU.
-     * @return  True if everything was fine, false otherwise
+     * @param block The structure to fill.
      */
-    static bool sendToGPU(const ShaderProgramPtr& program, const PointLightPtr& light);
+    void writeBlock(PointLightBlock& block) const;
 
     /**
-     * @brief Get location for the attributes of the lights and send the data to the GPU as uniforms.
+     * @brief Write the lights in the "Lights" uniform block.
+     *
+     * Only the first MAX_NR_POINT_LIGHTS lights are written, the other
+     * ones are ignored by the shaders.
      *
-     * @param program A pointer to the shader program where to get the locations.
-     * @param lights A vector of pointer to the lights to send to the GPU.
-     * @return  True if everything was fine, false otherwise
+     * @param block The uniform block to fill.
+     * @param lights A vector of pointer to the lights to write.
      */
-    static bool sendToGPU(const ShaderProgramPtr& program, const std::vector<PointLightPtr>& lights);
+    static void writeBlock(LightsBlock& block, const std::vector<PointLightPtr>& lights);
 
     /**
      * @brief Access to the position of the light.
@@ -338,70 +302,6 @@ private:
     float m_constant;       /*!< Coefficient of constant attenuation of the light. */
     float m_linear;         /*!< Coefficient of linear attenuation of the light with respect to the distance to the light position. */
     float m_quadratic;      /*!< Coefficient of quadratic attenuation of the light with respect to the distance to the light position. */
-
-    /**
-     * @brief Get the uniform name of the number of lights.
-     *
-     * @return The name of the number of lights in the shader.
-     */
-    std::string numberOfLightsName() { return std::string("numberOfPointLight"); }
-
-    /**
-     * @brief Get the uniform name of the light.
-     *
-     * @return The name of the light in the shader.
-     */
-    std::string lightName() { return std::string("pointLight"); }
-
-    /**
-     * @brief Get the uniform name of the position of the light.
-     *
-     * @return The name of the position of the light in the shader.
-     */
-    std::string positionName() { return std::string("position"); }
-
-
-    /**
-     * @brief Get the uniform name of the ambient intensity of the light.
-     *
-     * @return The name of the ambient intensity of the light in the shader.
-     */
-    std::string ambientName() { return std::string("ambient"); }
-
-    /**
-     * @brief Get the uniform name of the diffuse intensity of the light.
-     *
-     * @return The name of the diffuse intensity of the light in the shader.
-     */
-    std::string diffuseName() { return std::string("diffuse"); }
-
-    /**
-     * @brief Get the uniform name of the specular intensity of the light.
-     *
-     * @return The name of the specular intensity of the light in the shader.
-     */
-    std::string specularName() { return std::string("specular"); }
-
-    /**
-     * @brief Get the uniform name of the constant attenuation coefficient of the light.
-     *
-     * @return The name of the constant attenuation coefficient of the light in the shader.
-     */
-    std::string constantName() { return std::string("constant"); }
-
-    /**
-     * @brief Get the uniform name of the linear attenuation coefficient of the light.
-     *
-     * @return The name of the linear attenuation coefficient of the light in the shader.
-     */
-    std::string linearName() { return std::string("linear"); }
-
-    /**
-     * @brief Get the uniform name of the quadratic attenuation coefficient of the light.
-     *
-     * @return The name of the quadratic attenuation coefficient of the light in the shader.
-     */
-    std::string quadraticName() { return std::string("quadratic"); }
 };
 
 typedef std::shared_ptr<PointLight> PointLightPtr; /*!< Smart pointer to a point light */
@@ -459,22 +359,22 @@ public:
               const float& innerCutOff, const float& outerCutOff);
 
     /**
-     * @brief Get location for the attributes of the light and send the data to the GPU as uniforms.
+     * @brief Write the light in its structure of the "Lights" uniform block.
      *
-     * @param program A pointer to the shader program where to get the locations.
-     * @param light A pointer to the light to send to the GPU.
-     * @return  True if everything was fine, false otherwise
+     * @param block The structure to fill.
      */
-    static bool sendToGPU(const ShaderProgramPtr& program, const SpotLightPtr& light);
+    void writeBlock(SpotLightBlock& block) const;
 
     /**
-     * @brief Get location for the attributes of the lights and send the data to the GPU as uniforms.
+     * @brief Write the lights in the "Lights" uniform block.
      *
-     * @param program A pointer to the shader program where to get the locations.
-     * @param lights A vector of pointer to the lights to send to the GPU.
-     * @return  True if everything was fine, false otherwise
+     * Only the first MAX_NR_SPOT_LIGHTS lights are written, the other
+     * ones are ignored by the shaders.
+     *
+     * @param block The uniform block to fill.
+     * @param lights A vector of pointer to the lights to write.
      */
-    static bool sendToGPU(const ShaderProgramPtr& program, const std::vector<SpotLightPtr>& lights);
+    static void writeBlock(LightsBlock& block, const std::vector<SpotLightPtr>& lights);
 
     /**
      * @brief Access to the position of the light.
@@ -640,90 +540,6 @@ private:
 
     float m_innerCutOff;    /*!< The cosinus of the inner cutoff angle that specifies the spotlight's inner radius. Everything inside this angle is fully lit by the spotlight. */
     float m_outerCutOff;    /*!< The cosinus of the outer cutoff angle that specifies the spotlight's outer radius. Everything outside this angle is not lit by the spotlight. */
-
-    /**
-     * @brief Get the uniform name of the number of lights.
-     *
-     * @return The name of the number of lights in the shader.
-     */
-    std::string numberOfLightsName() { return std::string("numberOfSpotLight"); }
-
-    /**
-     * @brief Get the uniform name of the light.
-     *
-     * @return The name of the light in the shader.
-     */
-    std::string lightName() { return std::string("spotLight"); }
-
-    /**
-     * @brief Get the uniform name of the position of the light.
-     *
-     * @return The name of the position of the light in the shader.
-     */
-    std::string positionName() { return std::string("position"); }
-
-    /**
-     * @brief Get the uniform name of the direction of the spot.
-     *
-     * @return The name of the direction of the spot in the shader.
-     */
-    std::string spotDirectionName() { return std::string("spotDirection"); }
-
-    /**
-     * @brief Get the uniform name of the ambient intensity of the light.
-     *
-     * @return The name of the ambient intensity of the light in the shader.
-     */
-    std::string ambientName() { return std::string("ambient"); }
-
-    /**
-     * @brief Get the uniform name of the diffuse intensity of the light.
-     *
-     * @return The name of the diffuse intensity of the light in the shader.
-     */
-    std::string diffuseName() { return std::string("diffuse"); }
-
-    /**
-     * @brief Get the uniform name of the specular intensity of the light.
-     *
-     * @return The name of the specular intensity of the light in the shader.
-     */
-    std::string specularName() { return std::string("specular"); }
-
-    /**
-     * @brief Get the uniform name of the constant attenuation coefficient of the light.
-     *
-     * @return The name of the constant attenuation coefficient of the light in the shader.
-     */
-    std::string constantName() { return std::string("constant"); }
-
-    /**
-     * @brief Get the uniform name of the linear attenuation coefficient of the light.
-     *
-     * @return The name of the linear attenuation coefficient of the light in the shader.
-     */
-    std::string linearName() { return std::string("linear"); }
-
-    /**
-     * @brief Get the uniform name of the quadratic attenuation coefficient of the light.
-     *
-     * @return The name of the quadratic attenuation coefficient of the light in the shader.
-     */
-    std::string quadraticName() { return std::string("quadratic"); }
-
-    /**
-     * @brief Get the uniform name of the inner cut off cosinus angle of the spot.
-     *
-     * @return The name of the cosinus of the inner cut off angle of the spot in the shader.
-     */
-    std::string innerCutOffName() { return std::string("innerCutOff"); }
-
-    /**
-     * @brief Get the uniform name of the cosinus of the outer cut off angle of the spot.
-     *
-     * @return The name of the the cosinus of the outer cut off cosinus angle of the spot in the shader.
-     */
-    std::string outerCutOffName() { return std::string("outerCutOff"); }
 };
 
 typedef std::shared_ptr<SpotLight> SpotLightPtr; /*!< Smart pointer to a spot light */
@@ -4,6 +4,7 @@
 #include "./../../include/ShaderProgram.hpp"
 #include "./../../include/log.hpp"
 #include "./../../include/gl_helper.hpp"
+#include "./../../include/UniformBuffer.hpp"
 
 #include <GL/glew.h>
 #include <glm/glm.hpp>
@@ -32,10 +33,19 @@ public:
     Material();
 
     /**
-     * @brief Default constructor
+     * @brief Copy constructor
+     *
+     * The copy has its own uniform buffer.
      */
     Material(const Material& material);
 
+    /**
+     * @brief Assignment operator
+     *
+     * The uniform buffer is not shared, it is updated at the next draw.
+     */
+    Material& operator=(const Material& material);
+
     /**
      * @brief Specific constructor
      *
@@ -109,9 +119,12 @@ public:
     void setShininess(float shininess);
 
     /**
-     * @brief Get location for the attributes of the material and send the data to the GPU as uniforms.
+     * @brief Bind the uniform buffer of the material for the next draw.
      *
-     * @param program A pointer to the shader program where to get the locations.
+     * The "MaterialBlock" uniform block is only sent again to the GPU
+     * when the material has changed since the last call.
+     *
+     * @param program A pointer to the shader program that will use the material.
      * @param material A pointer to the material to send to the GPU.
      * @return  True if everything was fine, false otherwise
      */
@@ -140,6 +153,9 @@ private:
     glm::vec3 m_diffuse; /*!< The diffuse material vector defines the color of the object under diffuse lighting. */
     glm::vec3 m_specular; /*!< The specular material vector sets the color impact a specular light has on the object. */
     float m_shininess; /*!< The shininess impacts the scattering/radius of the specular highlight. */
+
+    std::unique_ptr<UniformBuffer> m_buffer; /*!< The "MaterialBlock" uniform block of the material, created at the first draw. */
+    bool m_dirty; /*!< True if the material changed since the last update of m_buffer. */
 };
 
 typedef std::shared_ptr<Material> MaterialPtr; /*!< Smart pointer to a material */
@@ -0,0 +1,53 @@
+/**
+ *  @file      DisjointSets.hpp
+ *  @brief     Implementation of a disjoint-set forest (union-find)
+ */
+
+#ifndef DISJOINT_SETS_HPP
+#define DISJOINT_SETS_HPP
+
+#include <vector>
+
+/**
+ * @class DisjointSets
+ * @brief Partition of the integers [0, size) into disjoint sets
+ *
+ * The sets are trees whose roots represent them. The trees are kept shallow
+ * by the union by rank and the path halving of find, so that a sequence of
+ * operations runs in almost linear time.
+ */
+class DisjointSets
+{
+ public:
+  /**
+   * @brief     Creates a partition where each element is alone in its set
+   * @param[in] size Number of elements
+   */
+  explicit DisjointSets(std::size_t size);
+
+  /**
+   * @brief     Find the representative of the set of an element
+   * @param[in] element The element, in [0, size)
+   * @return    The representative of its set
+   */
+  int find(int element);
+
+  /**
+   * @brief     Merge the sets of two elements
+   * @param[in] a First element, in [0, size)
+   * @param[in] b Second element, in [0, size)
+   */
+  void unite(int a, int b);
+
+  /**
+   * @brief   Getter of the number of elements
+   * @return  The number of elements of the partition
+   */
+  std::size_t size() const;
+
+ private:
+  std::vector<int> m_parents; /*!< Parent of each element, itself for a root. */
+  std::vector<unsigned char> m_ranks; /*!< Upper bound of the height of each tree. */
+};
+
+#endif //DISJOINT_SETS_HPP
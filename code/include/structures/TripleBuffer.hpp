@@ -0,0 +1,97 @@
+/**
+ *  @file      TripleBuffer.hpp
+ *  @brief     Implementation of a lock-free triple buffer
+ */
+
+#ifndef TRIPLE_BUFFER_HPP
+#define TRIPLE_BUFFER_HPP
+
+#include <atomic>
+
+/**
+ * @class TripleBuffer
+ * @brief Hand over values from a writer thread to a reader thread without locks
+ *
+ * The writer fills the back buffer and publishes it, the reader reads the
+ * front buffer and acquires the last published one. A third buffer sits
+ * between them, so that neither thread ever waits for the other: the writer
+ * may publish several values between two acquisitions, the reader then only
+ * sees the last one. The buffers are reused, a value keeps the memory it
+ * allocated in a previous round.
+ */
+template<typename T>
+class TripleBuffer
+{
+ public:
+  /**
+   * @brief Creates three default buffers, none of them published
+   */
+  TripleBuffer();
+
+  /**
+   * @brief   Getter of the buffer to fill, for the writer only
+   * @return  The back buffer
+   */
+  T & back();
+
+  /**
+   * @brief Publish the back buffer, for the writer only.
+   *        The back buffer is then replaced by a buffer the reader does not use.
+   */
+  void publish();
+
+  /**
+   * @brief   Make the last published buffer the front one, for the reader only
+   * @return  True if a buffer was published since the last acquisition
+   */
+  bool acquire();
+
+  /**
+   * @brief   Getter of the buffer to read, for the reader only
+   * @return  The front buffer, the last acquired one
+   */
+  const T & front() const;
+
+ private:
+  static const unsigned int FRESH = 4; /*!< Flag of the middle index set when the middle buffer was published and not acquired yet. */
+
+  T m_buffers[3]; /*!< The three buffers. */
+  unsigned int m_back; /*!< Index of the back buffer, owned by the writer. */
+  std::atomic<unsigned int> m_middle; /*!< Index of the middle buffer, with the FRESH flag. */
+  unsigned int m_front; /*!< Index of the front buffer, owned by the reader. */
+};
+
+template<typename T>
+TripleBuffer<T>::TripleBuffer()
+  : m_back(0), m_middle(1), m_front(2)
+{}
+
+template<typename T>
+T & TripleBuffer<T>::back()
+{
+  return m_buffers[m_back];
+}
+
+template<typename T>
+void TripleBuffer<T>::publish()
+{
+  m_back = m_middle.exchange(m_back | FRESH, std::memory_order_acq_rel) & ~FRESH;
+}
+
+template<typename T>
+bool TripleBuffer<T>::acquire()
+{
+  if (!(m_middle.load(std::memory_order_relaxed) & FRESH)) {
+    return false;
+  }
+  m_front = m_middle.exchange(m_front, std::memory_order_acq_rel) & ~FRESH;
+  return true;
+}
+
+template<typename T>
+const T & TripleBuffer<T>::front() const
+{
+  return m_buffers[m_front];
+}
+
+#endif //TRIPLE_BUFFER_HPP
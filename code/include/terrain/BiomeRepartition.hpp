@@ -33,15 +33,12 @@ void computeLand(
  *
  * @param seeds   Set of seeds
  * This set must be sorted by the distance to the center of the map
- * @param lakes A reference on the vector to fill with the coordinates of the
- * centroids of the Lake biomes.
  * @param parameters A reference on the MapParameters object which contains
  * the parsed parameters for the simulation.
  */
 void computeLake(
 	MapParameters& parameters,
-	std::vector<Seed>& seeds,
-	std::vector<glm::vec2>& lakes
+	std::vector<Seed>& seeds
 );
 
 
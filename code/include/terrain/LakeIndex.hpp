@@ -0,0 +1,112 @@
+/**
+ * @file LakeIndex.hpp
+ *
+ * @brief
+ * Spatial index answering the nearest lake queries of the boids.
+ */
+#ifndef LAKE_INDEX_HPP
+#define LAKE_INDEX_HPP
+
+#include "Biome.hpp"
+
+#include <vector>
+#include <glm/glm.hpp>
+
+/**
+ * @class LakeIndex
+ *
+ * @brief
+ * The centroids of the Lake biomes are sorted into square buckets, to find
+ * the closest one without scanning them all. On top of that, two fields are
+ * rasterised on the grid of the sampled biome map:
+ *  - the closest centroid of each texel, a rasterised Voronoi diagram of the
+ *    lakes;
+ *  - the closest Lake texel of each texel, that is to say the closest point
+ *    of the shore, computed by a distance transform.
+ * The queries inside the map are then simple lookups.
+ */
+class LakeIndex
+{
+public:
+    /**
+     * @brief
+     * Construct an empty index, without any lake.
+     */
+    LakeIndex();
+
+    /**
+     * @brief
+     * Build the index.
+     *
+     * @param lakes The centroids of the Lake biomes, which must outlive the
+     * index.
+     * @param biomeMap The sampled biome map, of effMapSize*effMapSize texels.
+     * @param effMapSize The number of texels of a side of the biome map.
+     * @param mapScaling The number of texels per unit of length.
+     */
+    void build(
+        const std::vector<glm::vec2>& lakes,
+        const Biome* biomeMap,
+        int effMapSize,
+        int mapScaling
+    );
+
+    /**
+     * @brief
+     * Find the closest centroid of a Lake biome.
+     *
+     * @param x The abscissa of the position.
+     * @param y The ordinate of the position.
+     * @param lake The centroid of the closest Lake biome, if found.
+     * @return A boolean representing "Closest Lake biome found ?"
+     */
+    bool closestLake(float x, float y, glm::vec2& lake) const;
+
+    /**
+     * @brief
+     * Find the closest point of the lakes, which is on their shore when the
+     * position is on land.
+     *
+     * @param x The abscissa of the position.
+     * @param y The ordinate of the position.
+     * @param shore The closest point of the lakes, if found.
+     * @param distance The distance to this point, 0 inside a lake.
+     * @return A boolean representing "Closest lake found ?"
+     */
+    bool closestShore(float x, float y, glm::vec2& shore, float& distance) const;
+
+private:
+    /**
+     * @brief
+     * Find the closest centroid by searching the buckets around the
+     * position, ring by ring.
+     *
+     * @param position The position.
+     * @return The index of the closest centroid, -1 if there is no lake.
+     */
+    int searchBuckets(const glm::vec2& position) const;
+
+    /**
+     * @brief
+     * Get the texel of the fields containing a position, clamped to the map.
+     *
+     * @param x The abscissa of the position.
+     * @param y The ordinate of the position.
+     * @return The index of the texel.
+     */
+    int texel(float x, float y) const;
+
+    const std::vector<glm::vec2>* m_lakes; /*!< The centroids of the Lake biomes. */
+
+    float m_bucketSize;                    /*!< The side of a bucket. */
+    int m_bucketCount;                     /*!< The number of buckets on a side of the map. */
+    std::vector<int> m_bucketStarts;       /*!< The first entry of each bucket, and the end of the last one. */
+    std::vector<int> m_bucketLakes;        /*!< The indices of the centroids, sorted by bucket. */
+
+    int m_fieldSize;                       /*!< The number of texels on a side of the fields. */
+    float m_fieldScaling;                  /*!< The number of texels per unit of length. */
+    std::vector<int> m_closestLakes;       /*!< The index of the closest centroid of each texel. */
+    std::vector<int> m_closestShores;      /*!< The index of the closest Lake texel of each texel, -1 if none. */
+};
+
+#endif //LAKE_INDEX_HPP
@@ -12,13 +12,23 @@
 
 #include "../HierarchicalRenderable.hpp"
 #include "./../lighting/Material.hpp"
+#include "./../AssetManager.hpp"
 #include "MapGenerator.hpp"
 
-#include <list>
-#include <utility>
 #include <vector>
 #include <glm/glm.hpp>
 
+/**
+ * @brief
+ * A connexe lake: a group of neighbouring Lake biomes, drawn as one
+ * lake.
+ */
+struct ConnexLake
+{
+    std::vector<int> seeds;           /*!< The indices of the seeds of the Lake biomes. */
+    std::vector<glm::vec3> triangles; /*!< The triangles of the lake, three vertices each. */
+};
+
 /**
  * @brief LakeRenderable
  */
@@ -35,17 +45,12 @@ public :
      * @brief Constructor
      *
      * @param shaderProgram Shader program used to render this quad.
-     * @param lakesTriangles The triangles rendering each lake, 
+     * @param lakesTriangles The triangles rendering each connexe lake, 
      * taken separately.
      */
     LakeRenderable(
         ShaderProgramPtr shaderProgram, 
-        std::list<
-            std::pair<
-                std::vector<int>, 
-                std::vector<glm::vec3> 
-            >
-        >& lakesTriangles
+        const std::vector<ConnexLake>& lakesTriangles
     );
 
     /**
@@ -73,6 +78,22 @@ private:
      */
     void do_animate( float time );
 
+    /**
+     * @brief 
+     * Implementation of the private inherited function do_getTextureKey.
+     *
+     * @see Renderable.hpp
+     */
+    unsigned int do_getTextureKey() const;
+
+    /**
+     * @brief 
+     * Implementation of the private inherited function do_getMeshKey.
+     *
+     * @see Renderable.hpp
+     */
+    unsigned int do_getMeshKey() const;
+
     /**
      * @brief 
      * Vector dedicated to store the positions to send to 
@@ -88,9 +109,9 @@ private:
     GLuint m_pBuffer;
 
     /**
-     * @brief The texture ID
+     * @brief The texture, shared through the AssetManager
      */
-    GLuint m_textureId;
+    TexturePtr m_texture;
 
     /**
      * @brief
@@ -9,6 +9,8 @@
 #define MAPGENERATOR_HPP
 
 #include "HeightTree.hpp"
+#include "LakeIndex.hpp"
+#include "SteeringField.hpp"
 #include "MapParameters.hpp"
 #include "VoronoiSeedsGenerator.hpp"
 #include "../structures/Matrix.hpp"
@@ -128,9 +130,8 @@ public :
 
     /**
      * @brief
-     * Finds closest Lake biome.
-     * Encapsulates "findClosestLake".
-     * @see MapUtils.hpp
+     * Finds closest Lake biome, through the lake index.
+     * @see LakeIndex.hpp
      *
      * @param x The abscissa of the point this function aims at dertermining the
      * closest Lake biome.
@@ -150,6 +151,58 @@ public :
 			float& yLake
 			);
 
+    /**
+     * @brief
+     * Get the number of connexe lakes, that is to say of groups of
+     * neighbouring Lake biomes.
+     *
+     * @return The number of connexe lakes.
+     */
+    int getLakeComponentCount() const;
+
+    /**
+     * @brief
+     * Get the steering field of the map, to steer the boids away from the
+     * sea, the steep slopes and the lakes.
+     *
+     * @return A reference on the steering field.
+     */
+    const SteeringField& getSteeringField() const;
+
+    /**
+     * @brief
+     * Finds the closest point of the lakes, on their shore from the land.
+     * @see LakeIndex.hpp
+     *
+     * @param x The abscissa of the position.
+     * @param y The ordinate of the position.
+     * @param xShore A reference on a float in which the function is going to
+     * store the abscissa of the closest point of the lakes.
+     * @param yShore A reference on a float in which the function is going to
+     * store the ordinate of the closest point of the lakes.
+     * @param distance A reference on a float in which the function is going
+     * to store the distance to the closest point of the lakes.
+     *
+     * @return A boolean representing "Closest lake found ?"
+     */
+    bool getClosestLakeShore(
+			float x,
+			float y,
+			float& xShore,
+			float& yShore,
+			float& distance
+			) const;
+
+    /**
+     * @brief
+     * Get the connexe lake a seed belongs to.
+     *
+     * @param seed The index of the seed.
+     * @return The index of its connexe lake, in [0, getLakeComponentCount()),
+     * -1 if the seed is not a Lake biome.
+     */
+    int getLakeComponent(int seed) const;
+
 	/**
 	 * @brief
 	 * Exports the map data, that is to say the list of the seeds used to
@@ -203,6 +256,22 @@ private :
      */
     std::vector<glm::vec2> m_lakes;
 
+    /**
+     * @brief
+     * The index of the connexe lake of each seed, -1 for the seeds which
+     * are not Lake biomes.
+     */
+    std::vector<int> m_lakeComponents;
+
+    /// @brief The number of connexe lakes
+    int m_lakeComponentCount = 0;
+
+    /// @brief The spatial index of the lakes, built with the biome map
+    LakeIndex m_lakeIndex;
+
+    /// @brief The steering field of the boids, built with the biome and height maps
+    SteeringField m_steeringField;
+
     /// @brief The height tree
     HeightTree *heightTree = NULL;
 
@@ -216,6 +285,14 @@ private :
      */
     Vertex2D clipPosition(float x, float y);
 
+    /**
+     * @brief
+     * Gather the Lake biomes into connexe lakes, merging the neighbouring
+     * ones with a disjoint-set forest, and fill the centroids of the lakes.
+     * Each seed and each neighbourhood is visited once.
+     */
+    void computeLakeComponents();
+
 };
 
 #endif
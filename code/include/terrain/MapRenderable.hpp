@@ -11,10 +11,10 @@
 
 #include "../HierarchicalRenderable.hpp"
 #include "./../lighting/Material.hpp"
+#include "./../AssetManager.hpp"
 #include "MapGenerator.hpp"
+#include "LakeRenderable.hpp"
 
-#include <list>
-#include <utility>
 #include <vector>
 #include <glm/glm.hpp>
 
@@ -58,12 +58,7 @@ public:
      * @return A reference on the data structure containing the
      * connexe lakes.
      */
-    std::list< 
-        std::pair<
-            std::vector<int>, 
-            std::vector<glm::vec3> 
-        >
-    >& getLakesTriangles();
+    std::vector<ConnexLake>& getLakesTriangles();
 
 private:
     /**
@@ -82,13 +77,37 @@ private:
      */
     void do_animate(float time);
 
+    /**
+     * @brief 
+     * Implementation of the private inherited function do_getTextureKey.
+     *
+     * @see Renderable.hpp
+     */
+    unsigned int do_getTextureKey() const;
+
+    /**
+     * @brief 
+     * Implementation of the private inherited function do_getMeshKey.
+     *
+     * @see Renderable.hpp
+     */
+    unsigned int do_getMeshKey() const;
+
     /**
      * @brief 
      * Vector dedicated to store the positions to send to 
-     * the GPU buffer in order to render the map.
+     * the GPU buffer in order to render the map. Each vertex
+     * is shared by every triangle using it.
      */
     std::vector<glm::vec3> m_positions;
 
+    /**
+     * @brief
+     * Vector dedicated to store the indices of the vertices of
+     * the triangles, three by triangle.
+     */
+    std::vector<unsigned int> m_indices;
+
     /**
      * @brief
      * Vector dedicated to store the texture coordinates
@@ -105,11 +124,40 @@ private:
 
     /**
      * @brief
-     * IDs of the GPU's buffers associated with the texture
-     * used for rendering.
+     * ID of the GPU's buffer associated with the indices.
+     */
+    unsigned int m_indicesBufferID;
+
+    /**
+     * @brief
+     * ID of the GPU's buffer associated with the bounds of the patches,
+     * one by triangle: (minimal height, maximal height, roughness, minimal
+     * vertical component of the normals). They let the tessellation control
+     * shader cull the patches and refine the rough ones.
+     */
+    unsigned int m_patchBoundsID;
+
+    /**
+     * @brief
+     * ID of the buffer texture reading the bounds of the patches, fetched
+     * with the index of the patch by the tessellation control shader.
+     */
+    unsigned int m_patchBoundsTextureID;
+
+    /**
+     * @brief
+     * ID of the height map texture, storing the normalized
+     * heights on 16 bits (R16).
      */
     unsigned int m_heightmapID;
 
+    /**
+     * @brief
+     * ID of the normal map texture, storing the (x, y) components
+     * of the normals as half floats (RG16F).
+     */
+    unsigned int m_normalMapID;
+
     /**
      * @brief
      * IDs of the texture coordinates
@@ -148,94 +196,91 @@ private:
 
 
     /**
-     * @brief The texture ID for the biome 'Sea'
-     */
-    GLuint m_seaTexId;
-
-    /**
-     * @brief The texture ID for the biomse 'InnerBeach' and 'OuterBeach'
-     */
-    GLuint m_sandTexId;
-
-    /**
-     * @brief The texture ID for the biome 'Plains'
-     */
-    GLuint m_plainsTexId;
-
-    /**
-     * @brief The texture ID for the biome 'Lake'
-     */
-    GLuint m_lakeTexId;
-
-    /**
-     * @brief The texture ID for the biome 'Mountain'
+     * @brief The textures of the biomes, as the layers of a texture array:
+     * (sea, sand, plains, lake, mountain, peak)
      */
-    GLuint m_mountainTexId;
+    TexturePtr m_biomesTexture;
 
     /**
-     * @brief The texture ID for the biome 'Peak'
+     * @brief The texture ID of the blending masks, as a two layers
+     * RGBA8 texture array:
+     * layer 0: (x, y, z, w) = (sea, sand, plains, lake)
+     * layer 1: (x, y)       = (mountain, peak)
      */
-    GLuint m_peakTexId;
+    GLuint m_masksId;
 
     /**
-     * @brief The texture ID for the first mask
-     * (x, y, z, w) = (sea, sand, plains, lake)
+     * @brief
+     * Locations of the variables of the shader program, looked up once
+     * per link of the program instead of at each frame.
      */
-    GLuint m_seaSandPlainsLakeMaskId;
+    struct Locations
+    {
+        unsigned int revision; /*!< Revision of the program the locations come from. */
+        int position;
+        int texCoord;
+        int patchBounds;
+        int model;
+        int heightMap;
+        int normalMap;
+        int heightMin;
+        int heightScale;
+        int tessellationLevel;
+        int scaleTexture;
+        int biomes;
+        int masks;
+    } m_locations;
 
     /**
-     * @brief The texture ID for the second mask
-     * (x, y)        = (mountain, peak)
+     * @brief Look up the locations of the shader program variables, and
+     * set the texture units of its samplers.
+     *
+     * The shader program must be bound.
      */
-    GLuint m_mountainPeakMaskId;
+    void updateLocations();
 
     /**
      * @brief
-     * In order to take account the connexity of the lakes,
-     * we have to use an auxiliar data structure.
+     * The triangles of each connexe lake, indexed as the connexe
+     * lakes of the map generator.
      */
-    std::list< 
-        std::pair<
-            std::vector<int>, 
-            std::vector<glm::vec3> 
-        >
-    > m_lakesTriangles;
+    std::vector<ConnexLake> m_lakesTriangles;
 
-    /**
-     * @brief Performs a sorted insert of a pair of coordinates into a 
-     *  list according to its angle with the abscissa axis.
-     *
-     * @param list A reference of the list in which the insertion has to
-     *  be performed.
-     * @param x The abscissa of the pair to insert into the list.
-     * @param y The ordinate of the pair to insert into the list.
-     * @param centerX The abscissa of the center of the cell.
-     * @param centerY The ordinate of the center of the cell.
-     */
-    void insertIntoList(
-        std::list< std::pair<float, float> >& list,
-        float x,
-        float y,
-        float centerX,
-        float centerY
-    );
-
-    
     /**
      * @brief Cut the voronoi diagram into triangles
      * and send them
      *
+     * The polygons of the cells are extracted in parallel, then the
+     * vertices shared by several cells are merged into an indexed mesh.
+     *
      * @mapGenerator A reference on the map generator.
      */
     void sendVoronoiDiagram(MapGenerator& mapGenerator);
 
     /**
-     * @brief Create and send the height map texture
+     * @brief Create and send the height map and normal map textures
+     *
+     * The heights are sampled once per texel, in parallel, and the normals
+     * are derived from the sampled heights.
      */
     void sendHeightMap();
 
+    /**
+     * @brief Compute the bounds of each patch of the map and send them
+     *
+     * The texels of the height map covered by each triangle are scanned,
+     * in parallel, to get its height range, the largest distance between
+     * the terrain and the plane of the triangle, and its steepest slope.
+     *
+     * @param altitudes The altitudes sampled for the height map, on a grid
+     * of (mapSize*heightmapScaling + 1)^2 texels.
+     */
+    void sendPatchBounds(const std::vector<float>& altitudes);
+
     /**
      * @brief Compute the texture masks and send them
+     *
+     * Each column of the masks slides its own neighbourhood, in parallel.
      */
     void sendMasks();
 
@@ -103,27 +103,21 @@ float findApproximativeHeight(Vertex2D & pos,
 
 /**
  * @brief
- * Determines which Lake biome is the closest of the given position.
- *
- * @param lakes A reference on the vector containing the positions of the Lake
- * biome.
- * @param x The abscissa of the point this function aims at dertermining the
- * closest Lake biome.
- * @param y The ordinate of the point this function aims at dertermining the
- * closest Lake biome.
- * @param xLake A reference on a float in which the function is going to store
- * the abscissa of the centroid of the closest Lake biome.
- * @param yLake A reference on a float in which the function is going to store
- * the ordinate of the centroid of the closest Lake biome.
- *
- * @return A boolean representing "Closest Lake biome found ?"
+ * Computes the closest feature texel of each texel of a square grid.
+ *
+ * Each texel takes the closest feature texel among the ones of its
+ * neighbours, in a forward then a backward sweep over the grid: a two-pass
+ * 8-neighbour distance transform, close to the Euclidean one.
+ *
+ * @param features Whether each texel is a feature, on size*size texels.
+ * @param size The number of texels of a side of the grid.
+ * @param closest A reference on the vector to fill with the index of the
+ * closest feature texel of each texel, -1 if there is no feature.
  */
-bool findClosestLake(
-	std::vector<glm::vec2>& lakes,
-	float x,
-	float y,
-	float& xLake,
-	float& yLake
+void computeClosestTexels(
+	const std::vector<char>& features,
+	int size,
+	std::vector<int>& closest
 );
 
 /**
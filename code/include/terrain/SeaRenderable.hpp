@@ -13,6 +13,7 @@
 
 #include "../HierarchicalRenderable.hpp"
 #include "./../lighting/Material.hpp"
+#include "./../AssetManager.hpp"
 #include "MapGenerator.hpp"
 
 #include <list>
@@ -74,6 +75,22 @@ private:
      */
     void do_animate( float time );
 
+    /**
+     * @brief 
+     * Implementation of the private inherited function do_getTextureKey.
+     *
+     * @see Renderable.hpp
+     */
+    unsigned int do_getTextureKey() const;
+
+    /**
+     * @brief 
+     * Implementation of the private inherited function do_getMeshKey.
+     *
+     * @see Renderable.hpp
+     */
+    unsigned int do_getMeshKey() const;
+
 
     /**
      * @brief
@@ -96,9 +113,9 @@ private:
     GLuint m_pBuffer;
 
     /**
-     * @brief The texture ID
+     * @brief The texture, shared through the AssetManager
      */
-    GLuint m_textureId;
+    TexturePtr m_texture;
 
     /**
      * @brief
@@ -0,0 +1,100 @@
+/**
+ * @file SteeringField.hpp
+ *
+ * @brief
+ * Fields precomputed on the map to steer the boids away from the sea, the
+ * steep slopes and the lakes.
+ */
+#ifndef STEERING_FIELD_HPP
+#define STEERING_FIELD_HPP
+
+#include "Biome.hpp"
+
+#include <vector>
+#include <glm/glm.hpp>
+
+/**
+ * @brief
+ * The steering data of a position: for each kind of obstacle, the signed
+ * distance to its border (negative inside the obstacle) and the direction
+ * escaping from it (away from the obstacle outside, towards its closest
+ * border inside). The escape direction is null if there is no such obstacle.
+ */
+struct SteeringSample
+{
+    glm::vec2 seaEscape;   /*!< The direction escaping from the sea. */
+    float seaDistance;     /*!< The signed distance to the sea. */
+    glm::vec2 slopeEscape; /*!< The direction escaping from the mountains and steep slopes. */
+    float slopeDistance;   /*!< The signed distance to the mountains and steep slopes. */
+    glm::vec2 lakeEscape;  /*!< The direction escaping from the lakes. */
+    float lakeDistance;    /*!< The signed distance to the lakes. */
+};
+
+/**
+ * @class SteeringField
+ *
+ * @brief
+ * A raster of steering samples, one per unit of length, computed once from
+ * the sampled biome and height maps. The boids sample it bilinearly in one
+ * lookup, instead of probing the terrain at several points at each step.
+ */
+class SteeringField
+{
+public:
+    /**
+     * @brief
+     * Construct an empty field: every position is far from any obstacle.
+     */
+    SteeringField();
+
+    /**
+     * @brief
+     * Compute the field.
+     *
+     * @param biomeMap The sampled biome map, of effMapSize*effMapSize texels.
+     * @param heightMap The sampled height map, of effMapSize*effMapSize texels.
+     * @param effMapSize The number of texels of a side of the sampled maps.
+     * @param mapScaling The number of texels of the sampled maps per unit of
+     * length.
+     * @param maxSlope The height difference per unit of length beyond which
+     * the ground is too steep to walk on.
+     */
+    void build(
+        const Biome* biomeMap,
+        const float* heightMap,
+        int effMapSize,
+        int mapScaling,
+        float maxSlope
+    );
+
+    /**
+     * @brief
+     * Sample the field at a position, with a bilinear interpolation. The
+     * positions are clamped to the map.
+     *
+     * @param x The abscissa of the position.
+     * @param y The ordinate of the position.
+     * @return The interpolated steering sample, with normalized directions.
+     */
+    SteeringSample sample(float x, float y) const;
+
+private:
+    /**
+     * @brief
+     * Fill one obstacle of the samples from its mask.
+     *
+     * @param mask Whether each texel belongs to the obstacle.
+     * @param escapes The escape direction of each texel, to fill.
+     * @param distances The signed distance of each texel, to fill.
+     */
+    void computeObstacle(
+        const std::vector<char>& mask,
+        std::vector<glm::vec2>& escapes,
+        std::vector<float>& distances
+    ) const;
+
+    int m_size;                            /*!< The number of texels on a side of the field. */
+    std::vector<SteeringSample> m_samples; /*!< The samples, row by row. */
+};
+
+#endif //STEERING_FIELD_HPP
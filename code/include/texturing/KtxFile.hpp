@@ -0,0 +1,86 @@
+#ifndef KTX_FILE_HPP
+#define KTX_FILE_HPP
+
+/**@file
+ * @brief Input/Output functions for KTX texture containers.
+ *
+ * A KTX file (version 1.1) stores a texture in a single file, with all its
+ * mip map levels and array layers, in a format that can be sent as is to
+ * the GPU: plain texels or compressed blocks (BC1, BC3, BC7, ...). Such
+ * files are produced from the images of the textures directory by the
+ * texconvert tool (see tools/texconvert.cpp).
+ *
+ * The texels are expected in the OpenGL convention: the first row is the
+ * bottom one.
+ */
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Content of a KTX file.
+ *
+ * The fields are named after the ones of the KTX header. Only 2D textures
+ * and 2D texture arrays are handled (no cube maps, no 3D textures).
+ */
+struct KtxTexture
+{
+    unsigned int glType; /*!< Type of the texels, 0 for compressed textures. */
+    unsigned int glTypeSize; /*!< Size of glType in bytes, 1 for compressed textures. */
+    unsigned int glFormat; /*!< Format of the texels, 0 for compressed textures. */
+    unsigned int glInternalFormat; /*!< Internal format to use on the GPU. */
+    unsigned int glBaseInternalFormat; /*!< Base internal format (GL_RGB, GL_RGBA, ...). */
+    unsigned int width; /*!< Width of the base level, in texels. */
+    unsigned int height; /*!< Height of the base level, in texels. */
+    unsigned int layers; /*!< Number of array layers, 0 if the texture is not an array. */
+    bool generateMipMap; /*!< True if only the base level is stored and the others must be generated. */
+    std::vector< std::vector<unsigned char> > levels; /*!< Data of each level, every layer included. */
+
+    /**
+     * @brief Tell whether the texture is made of compressed blocks.
+     * @return True if the data must be sent with glCompressedTexSubImage.
+     */
+    bool isCompressed() const;
+
+    /**
+     * @brief Width of a mip map level.
+     * @param level The level, 0 being the base one.
+     * @return The width in texels.
+     */
+    unsigned int getLevelWidth(unsigned int level) const;
+
+    /**
+     * @brief Height of a mip map level.
+     * @param level The level, 0 being the base one.
+     * @return The height in texels.
+     */
+    unsigned int getLevelHeight(unsigned int level) const;
+
+    /**
+     * @brief Size of a mip map level, every layer included.
+     *
+     * The rows of plain texels are aligned on 4 bytes, as in a KTX file.
+     * @param level The level, 0 being the base one.
+     * @return The size in bytes, 0 if the format is not supported.
+     */
+    std::size_t getLevelSize(unsigned int level) const;
+};
+
+/**@brief Read a texture from a KTX file.
+ *
+ * @param filename The path to the KTX file.
+ * @param texture The texture read.
+ * @return False if the file could not be read or is not supported, true otherwise.
+ */
+bool read_ktx(const std::string& filename, KtxTexture& texture);
+
+/**@brief Write a texture to a KTX file.
+ *
+ * @param filename The path to the KTX file.
+ * @param texture The texture to write.
+ * @return False if the file could not be written, true otherwise.
+ */
+bool write_ktx(const std::string& filename, const KtxTexture& texture);
+
+#endif //KTX_FILE_HPP
@@ -4,6 +4,7 @@
 #include "./../HierarchicalRenderable.hpp"
 #include "./../lighting/Material.hpp"
 #include "./../lighting/Light.hpp"
+#include "./../AssetManager.hpp"
 
 #include <string>
 #include <vector>
@@ -22,6 +23,8 @@ class TexturedLightedMeshRenderable : public HierarchicalRenderable
     private:
         void do_draw();
         void do_animate( float time );
+        unsigned int do_getTextureKey() const;
+        unsigned int do_getMeshKey() const;
 
         std::vector< glm::vec3 > m_positions;
         std::vector< glm::vec3 > m_normals;
@@ -34,7 +37,8 @@ class TexturedLightedMeshRenderable : public HierarchicalRenderable
         unsigned int m_nBuffer;
         unsigned int m_iBuffer;
         unsigned int m_tBuffer;
-        unsigned int m_texId;
+
+        TexturePtr m_texture;
 
         MaterialPtr m_material;
 };
@@ -5,8 +5,14 @@
 
 ////////// Uniforms to set
 
-// Camera related
-uniform mat4 projMat, viewMat, modelMat;
+// Camera matrices, shared by every shader program (binding point 0)
+layout(std140) uniform Camera
+{
+    mat4 projMat;
+    mat4 viewMat;
+    vec4 viewport;
+};
+uniform mat4 modelMat;
 
 // Position
 uniform vec3 billboard_world_position;
@@ -0,0 +1,8 @@
+#version 400
+in vec4 fragmentColor;
+out vec4 color;
+
+void main()
+{
+  color = fragmentColor;
+}
@@ -0,0 +1,12 @@
+#version 400
+layout (location = 0) in vec2 vertex;
+layout (location = 1) in vec4 color;
+out vec4 fragmentColor;
+
+uniform mat4 projection;
+
+void main()
+{
+    gl_Position = projection * vec4(vertex, 1.0, 1.0);
+    fragmentColor = color;
+}
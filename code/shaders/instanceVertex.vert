@@ -1,6 +1,12 @@
 #version 400
 
-uniform mat4 projMat, viewMat;
+// Camera matrices, shared by every shader program (binding point 0)
+layout(std140) uniform Camera
+{
+    mat4 projMat;
+    mat4 viewMat;
+    vec4 viewport;
+};
 uniform mat3 NIT = mat3(1.0);
 
 layout (location = 0) in vec3 position;
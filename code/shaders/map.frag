@@ -52,40 +52,49 @@ struct SpotLight
     float outerCutOff;
 };
 
-uniform Material material;
-uniform DirectionalLight directionalLight;
-
 #define MAX_NR_POINT_LIGHTS 10
-uniform int numberOfPointLight;
-uniform PointLight pointLight[MAX_NR_POINT_LIGHTS];
-
 #define MAX_NR_SPOT_LIGHTS 10
-uniform int numberOfSpotLight;
-uniform SpotLight spotLight[MAX_NR_SPOT_LIGHTS];
+
+// Material of the object, set before drawing it (binding point 2)
+layout(std140) uniform MaterialBlock
+{
+    Material material;
+};
+
+// Lights of the scene, shared by every shader program (binding point 1)
+layout(std140) uniform Lights
+{
+    DirectionalLight directionalLight;
+    PointLight pointLight[MAX_NR_POINT_LIGHTS];
+    SpotLight spotLight[MAX_NR_SPOT_LIGHTS];
+    int numberOfPointLight;
+    int numberOfSpotLight;
+};
 
 
 ////////// Uniforms to set
 
-// Camera related informations
-uniform mat4 projMat, viewMat, modelMat;
+// Camera related informations, shared by every shader program (binding point 0)
+layout(std140) uniform Camera
+{
+    mat4 projMat;
+    mat4 viewMat;
+    vec4 viewport;
+};
+uniform mat4 modelMat;
 
 
 ///// The texture scale
 uniform float scaleTexture;
 
-///// Textures
-uniform sampler2D seaTex;
-uniform sampler2D sandTex;
-uniform sampler2D plainsTex;
-uniform sampler2D lakeTex;
-uniform sampler2D mountainTex;
-uniform sampler2D peakTex;
+///// Textures of the biomes, one per layer
+//(0, 1, 2, 3, 4, 5) = (sea, sand, plains, lake, mountain, peak)
+uniform sampler2DArray biomeTex;
 
-///// Masks 
-//(x, y, z, w) = (sea, sand, plains, lake)
-uniform sampler2D seaSandPlainsLakeMask;
-//(x, y)       = (mountain, peak)
-uniform sampler2D mountainPeakMask;
+///// Masks, one per layer
+//layer 0: (x, y, z, w) = (sea, sand, plains, lake)
+//layer 1: (x, y)       = (mountain, peak)
+uniform sampler2DArray biomeMasks;
 
 ////////// In parameters
 
@@ -204,30 +213,25 @@ void main() {
     
     // Texture
     // Taking the values from the masks
-    vec4 firstMask  = texture(seaSandPlainsLakeMask, gTexCoord);
-    vec4 secondMask = texture(mountainPeakMask,      gTexCoord);
-    
-    float seaCoefficient      = firstMask.x;
-    float sandCoefficient     = firstMask.y;
-    float plainsCoefficient   = firstMask.z;
-    float lakeCoefficient     = firstMask.w;
-    float mountainCoefficient = secondMask.x;
-    float peakCoefficient     = secondMask.y;
+    vec4 firstMask  = texture(biomeMasks, vec3(gTexCoord, 0));
+    vec4 secondMask = texture(biomeMasks, vec3(gTexCoord, 1));
 
-    
-    vec2 mapPosition = gPosition.xy;
-    // Taking the texture values
-    vec4 seaValue      = texture(seaTex,      mapPosition/scaleTexture);
-    vec4 sandValue     = texture(sandTex,     mapPosition/scaleTexture);
-    vec4 plainsValue   = texture(plainsTex,   mapPosition/scaleTexture);
-    vec4 lakeValue     = texture(lakeTex,     mapPosition/scaleTexture);
-    vec4 mountainValue = texture(mountainTex, mapPosition/scaleTexture);
-    vec4 peakValue     = texture(peakTex,     mapPosition/scaleTexture);
+    float coefficients[6] = float[6](firstMask.x,  firstMask.y, firstMask.z,
+                                     firstMask.w,  secondMask.x, secondMask.y);
+
+    // Taking the texture values, only for the biomes present here.
+    // The implicit derivatives are undefined inside the branches: the
+    // gradients used to select the mip map level are computed before.
+    vec2 mapPosition = gPosition.xy/scaleTexture;
+    vec2 dx = dFdx(mapPosition);
+    vec2 dy = dFdy(mapPosition);
 
     // Blending the textures
-    vec4 texture = (seaCoefficient      * seaValue      + sandCoefficient * sandValue
-		    + plainsCoefficient   * plainsValue   + lakeCoefficient * lakeValue
-		    + mountainCoefficient * mountainValue + peakCoefficient * peakValue);
+    vec4 texture = vec4(0.0);
+    for (int layer = 0; layer < 6; ++layer) {
+        if (coefficients[layer] > 0.0)
+            texture += coefficients[layer] * textureGrad(biomeTex, vec3(mapPosition, layer), dx, dy);
+    }
 
     // Final result
     fColor = texture*vec4(illumination, 1.0);
@@ -1,6 +1,13 @@
 #version 400
 
-uniform mat4 projMat, viewMat, modelMat;
+// Camera matrices, shared by every shader program (binding point 0)
+layout(std140) uniform Camera
+{
+    mat4 projMat;
+    mat4 viewMat;
+    vec4 viewport;
+};
+uniform mat4 modelMat;
 
 // This is the normal inverse transpose matrix.
 // It is really important to obtain a normal in world coordinates.
@@ -52,16 +52,24 @@ struct SpotLight
     float outerCutOff;
 };
 
-uniform Material material;
-uniform DirectionalLight directionalLight;
-
 #define MAX_NR_POINT_LIGHTS 10
-uniform int numberOfPointLight;
-uniform PointLight pointLight[MAX_NR_POINT_LIGHTS];
-
 #define MAX_NR_SPOT_LIGHTS 10
-uniform int numberOfSpotLight;
-uniform SpotLight spotLight[MAX_NR_SPOT_LIGHTS];
+
+// Material of the object, set before drawing it (binding point 2)
+layout(std140) uniform MaterialBlock
+{
+    Material material;
+};
+
+// Lights of the scene, shared by every shader program (binding point 1)
+layout(std140) uniform Lights
+{
+    DirectionalLight directionalLight;
+    PointLight pointLight[MAX_NR_POINT_LIGHTS];
+    SpotLight spotLight[MAX_NR_SPOT_LIGHTS];
+    int numberOfPointLight;
+    int numberOfSpotLight;
+};
 
 
 ////////// Uniforms to set
@@ -0,0 +1,530 @@
+#include "./../include/AssetManager.hpp"
+#include "./../include/gl_helper.hpp"
+#include "./../include/log.hpp"
+#include "./../include/Io.hpp"
+#include "./../include/texturing/KtxFile.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <GL/glew.h>
+#include <SFML/Graphics/Image.hpp>
+
+std::unordered_map< std::string, std::weak_ptr<const MeshData> > AssetManager::m_meshes;
+std::unordered_map< std::string, std::weak_ptr<Texture> > AssetManager::m_textures;
+
+/**
+ * @brief
+ * Pool of threads decoding the assets in the background.
+ * The threads are started at the first job and joined at exit.
+ */
+class LoaderPool
+{
+public:
+    LoaderPool() : m_stop(false) {}
+
+    ~LoaderPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+        m_condition.notify_all();
+        for (std::thread& worker : m_workers) {
+            worker.join();
+        }
+    }
+
+    void submit(const std::function<void()>& job)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_workers.empty()) {
+                // hardware_concurrency() may return 0 when the number of cores is unknown
+                unsigned int cores = std::thread::hardware_concurrency();
+                unsigned int count = cores > 1 ? cores - 1 : 1;
+                for (unsigned int i = 0; i < count; ++i) {
+                    m_workers.push_back(std::thread(&LoaderPool::run, this));
+                }
+            }
+            m_jobs.push_back(job);
+        }
+        m_condition.notify_one();
+    }
+
+private:
+    void run()
+    {
+        for (;;) {
+            std::function<void()> job;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_condition.wait(lock, [this]{ return m_stop || !m_jobs.empty(); });
+                if (m_stop) {
+                    return;
+                }
+                job = m_jobs.front();
+                m_jobs.pop_front();
+            }
+            job();
+        }
+    }
+
+    std::vector<std::thread> m_workers;
+    std::deque< std::function<void()> > m_jobs;
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    bool m_stop;
+};
+
+/**
+ * @brief
+ * A texture whose data is read by the pool, waiting to be sent
+ * to the GPU by the main thread.
+ */
+struct TextureUpload
+{
+    TexturePtr texture;
+    std::string key; // key of the texture in the cache, to report the failures
+    std::vector< std::vector<std::string> > chains; // images of each layer, starting by the finest level
+    std::string container; // KTX file loaded instead of the images when it exists
+    bool sRGB;
+    bool repeat;
+    TextureFiltering filtering;
+    KtxTexture data;
+    bool failed;
+};
+
+typedef std::shared_ptr<TextureUpload> TextureUploadPtr;
+
+// Meshes being parsed by the pool
+static std::unordered_map< std::string, std::shared_future<MeshDataPtr> > s_pendingMeshes;
+
+// Textures requested, and the ones whose images are decoded
+static std::size_t s_pendingTextures = 0;
+static std::deque<TextureUploadPtr> s_decodedTextures;
+static std::mutex s_decodedMutex;
+
+static GLuint s_placeholderId = 0;
+static GLuint s_placeholderArrayId = 0;
+
+// Declared last, so that the workers are joined before the data they use is destroyed
+static LoaderPool s_pool;
+
+static MeshDataPtr parseMesh(const std::string& filename)
+{
+    std::shared_ptr<MeshData> data = std::make_shared<MeshData>();
+    if (!read_obj(filename, data->positions, data->indices, data->normals, data->texCoords)) {
+        LOG(error, "cannot read the mesh " << filename);
+        return nullptr;
+    }
+    return data;
+}
+
+static bool decodeImages(TextureUploadPtr upload)
+{
+    const unsigned int layers = upload->chains.size();
+    const unsigned int levels = layers ? upload->chains.front().size() : 0;
+    if (!levels) {
+        return false;
+    }
+
+    KtxTexture& data = upload->data;
+    data.glType = GL_UNSIGNED_BYTE;
+    data.glTypeSize = 1;
+    data.glFormat = GL_RGBA;
+    data.glInternalFormat = upload->sRGB ? GL_SRGB8_ALPHA8 : GL_RGBA8;
+    data.glBaseInternalFormat = GL_RGBA;
+    data.layers = (upload->texture->getTarget() == GL_TEXTURE_2D_ARRAY) ? layers : 0;
+    // a single image gets a full mip map chain generated by the GPU, if it is filtered with it
+    data.generateMipMap = (levels == 1) && upload->filtering == TRILINEAR_FILTERING;
+    data.levels.assign(levels, std::vector<unsigned char>());
+
+    sf::Image image;
+    for (unsigned int layer = 0; layer < layers; ++layer) {
+        if (upload->chains[layer].size() != levels) {
+            return false;
+        }
+        for (unsigned int i = 0; i < levels; ++i) {
+            if (!image.loadFromFile(upload->chains[layer][i])) {
+                return false;
+            }
+            image.flipVertically(); // sfml inverts the v axis... put the image in OpenGL convention: lower left corner is (0,0)
+
+            // Every layer of a level has the same size
+            if (layer == 0 && i == 0) {
+                data.width = image.getSize().x;
+                data.height = image.getSize().y;
+            }
+            if (image.getSize().x != data.getLevelWidth(i) || image.getSize().y != data.getLevelHeight(i)) {
+                LOG(error, upload->chains[layer][i] << " does not have the expected size");
+                return false;
+            }
+
+            const unsigned char* pixels = image.getPixelsPtr();
+            data.levels[i].insert(data.levels[i].end(), pixels, pixels + 4 * image.getSize().x * image.getSize().y);
+        }
+    }
+    return true;
+}
+
+static void decodeTexture(TextureUploadPtr upload)
+{
+    upload->failed = true;
+    if (!upload->container.empty()) {
+        if (read_ktx(upload->container, upload->data)) {
+            upload->failed = false;
+        } else if (upload->chains.empty() || std::ifstream(upload->container.c_str()).good()) {
+            LOG(error, "cannot read the texture " << upload->container);
+        }
+    }
+    if (upload->failed && !upload->chains.empty()) {
+        upload->failed = !decodeImages(upload);
+        if (upload->failed) {
+            LOG(error, "cannot read the texture " << upload->chains.front().front());
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(s_decodedMutex);
+    s_decodedTextures.push_back(upload);
+}
+
+Texture::Texture(unsigned int target)
+    : m_id(0), m_target(target), m_width(0), m_height(0), m_loaded(false)
+{}
+
+Texture::Texture(unsigned int id, unsigned int width, unsigned int height)
+    : m_id(id), m_target(GL_TEXTURE_2D), m_width(width), m_height(height), m_loaded(true)
+{}
+
+Texture::~Texture()
+{
+    if (m_id) {
+        glcheck(glDeleteTextures(1, &m_id));
+    }
+}
+
+unsigned int Texture::getId() const
+{
+    if (m_loaded) {
+        return m_id;
+    }
+
+    const GLubyte white[4] = { 255, 255, 255, 255 };
+    if (m_target == GL_TEXTURE_2D_ARRAY) {
+        if (!s_placeholderArrayId) {
+            glcheck(glGenTextures(1, &s_placeholderArrayId));
+            glcheck(glBindTexture(GL_TEXTURE_2D_ARRAY, s_placeholderArrayId));
+            glcheck(glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_NEAREST));
+            glcheck(glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_NEAREST));
+            glcheck(glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_RGBA8, 1, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, white));
+            glcheck(glBindTexture(GL_TEXTURE_2D_ARRAY, 0));
+        }
+        return s_placeholderArrayId;
+    }
+
+    if (!s_placeholderId) {
+        glcheck(glGenTextures(1, &s_placeholderId));
+        glcheck(glBindTexture(GL_TEXTURE_2D, s_placeholderId));
+        glcheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST));
+        glcheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST));
+        glcheck(glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, white));
+        glcheck(glBindTexture(GL_TEXTURE_2D, 0));
+    }
+    return s_placeholderId;
+}
+
+unsigned int Texture::getTarget() const
+{
+    return m_target;
+}
+
+bool Texture::isLoaded() const
+{
+    return m_loaded;
+}
+
+unsigned int Texture::getWidth() const
+{
+    return m_width;
+}
+
+unsigned int Texture::getHeight() const
+{
+    return m_height;
+}
+
+MeshDataPtr AssetManager::getMesh(const std::string& filename)
+{
+    MeshDataPtr mesh = m_meshes[filename].lock();
+    if (mesh) {
+        return mesh;
+    }
+
+    auto pending = s_pendingMeshes.find(filename);
+    if (pending != s_pendingMeshes.end()) {
+        mesh = pending->second.get();
+        s_pendingMeshes.erase(pending);
+    } else {
+        mesh = parseMesh(filename);
+    }
+
+    if (mesh) {
+        m_meshes[filename] = mesh;
+    } else {
+        m_meshes.erase(filename);
+    }
+    return mesh;
+}
+
+void AssetManager::prefetchMesh(const std::string& filename)
+{
+    if (!m_meshes[filename].expired() || s_pendingMeshes.count(filename)) {
+        return;
+    }
+
+    std::shared_ptr< std::packaged_task<MeshDataPtr()> > task =
+        std::make_shared< std::packaged_task<MeshDataPtr()> >(std::bind(parseMesh, filename));
+    s_pendingMeshes[filename] = task->get_future().share();
+    s_pool.submit([task]{ (*task)(); });
+}
+
+static bool isKtxFile(const std::string& filename)
+{
+    static const std::string extension = ".ktx";
+    return filename.size() >= extension.size()
+        && filename.compare(filename.size() - extension.size(), extension.size(), extension) == 0;
+}
+
+TexturePtr AssetManager::getTexture(const std::string& filename, bool sRGB, TextureFiltering filtering)
+{
+    // The same image may be requested with both encodings, and with several filterings
+    std::string key = filename;
+    if (filtering == NEAREST_FILTERING) {
+        key += "#nearest";
+    } else if (filtering == LINEAR_FILTERING) {
+        key += "#linear";
+    }
+
+    if (isKtxFile(filename)) {
+        return requestTexture(key, GL_TEXTURE_2D, std::vector< std::vector<std::string> >(), filename, false, false, filtering);
+    }
+
+    if (sRGB) {
+        key += "#sRGB";
+    }
+    return requestTexture(key, GL_TEXTURE_2D, std::vector< std::vector<std::string> >(1, std::vector<std::string>(1, filename)),
+                          std::string(), sRGB, false, filtering);
+}
+
+TexturePtr AssetManager::getMipMapTexture(const std::vector<std::string>& filenames)
+{
+    if (filenames.empty()) {
+        return requestTexture("mipmap#", GL_TEXTURE_2D, std::vector< std::vector<std::string> >(), std::string(), false, true);
+    }
+
+    // The container of the chain "name2.png", ..., "name8.png" is "name.ktx"
+    const std::string& first = filenames.front();
+    std::size_t end = first.find_last_of('.');
+    if (end == std::string::npos || end < first.find_last_of('/')) {
+        end = first.size();
+    }
+    std::size_t stem = end;
+    while (stem > 0 && std::isdigit(first[stem - 1])) {
+        --stem;
+    }
+    const std::string container = first.substr(0, stem) + ".ktx";
+
+    return requestTexture("mipmap#" + first, GL_TEXTURE_2D, std::vector< std::vector<std::string> >(1, filenames),
+                          container, false, true);
+}
+
+TexturePtr AssetManager::getTextureArray(
+    const std::string& filename,
+    const std::vector< std::vector<std::string> >& chains
+)
+{
+    return requestTexture(filename, GL_TEXTURE_2D_ARRAY, chains, filename, false, true);
+}
+
+TexturePtr AssetManager::requestTexture(
+    const std::string& key,
+    unsigned int target,
+    const std::vector< std::vector<std::string> >& chains,
+    const std::string& container,
+    bool sRGB,
+    bool repeat,
+    TextureFiltering filtering
+)
+{
+    TexturePtr texture = m_textures[key].lock();
+    if (texture) {
+        return texture;
+    }
+
+    texture = std::make_shared<Texture>(target);
+    m_textures[key] = texture;
+
+    // The upload holds the texture until it is sent to the GPU
+    TextureUploadPtr upload = std::make_shared<TextureUpload>();
+    upload->texture = texture;
+    upload->key = key;
+    upload->chains = chains;
+    upload->container = container;
+    upload->sRGB = sRGB;
+    upload->repeat = repeat;
+    upload->filtering = filtering;
+    upload->failed = false;
+
+    ++s_pendingTextures;
+    s_pool.submit(std::bind(decodeTexture, upload));
+    return texture;
+}
+
+void AssetManager::processUploads(std::size_t maxBytes)
+{
+    std::size_t sentBytes = 0;
+    while (sentBytes < maxBytes) {
+        TextureUploadPtr upload;
+        {
+            std::lock_guard<std::mutex> lock(s_decodedMutex);
+            if (s_decodedTextures.empty()) {
+                return;
+            }
+            upload = s_decodedTextures.front();
+            s_decodedTextures.pop_front();
+        }
+        --s_pendingTextures;
+
+        if (upload->failed) {
+            LOG(error, "the texture " << upload->key << " keeps its placeholder");
+            continue;
+        }
+
+        Texture& texture = *upload->texture;
+        const KtxTexture& data = upload->data;
+        const GLenum target = texture.m_target;
+        if ((target == GL_TEXTURE_2D_ARRAY) != (data.layers != 0)) {
+            LOG(error, upload->container << (data.layers ? " is a texture array" : " is not a texture array"));
+            continue;
+        }
+        texture.m_width = data.width;
+        texture.m_height = data.height;
+
+        // The GPU cannot be trusted to generate the mip maps of compressed formats
+        bool generateMipMap = data.generateMipMap && !data.isCompressed();
+        unsigned int levels = data.levels.size();
+        if (generateMipMap) {
+            for (unsigned int size = std::max(data.width, data.height); size > 1; size /= 2) {
+                ++levels;
+            }
+        }
+
+        std::size_t bytes = 0;
+        for (const std::vector<unsigned char>& level : data.levels) {
+            bytes += level.size();
+        }
+
+        // Staging the texels in a pixel buffer object, so that the driver
+        // can perform the transfer asynchronously
+        GLuint pbo = 0;
+        glcheck(glGenBuffers(1, &pbo));
+        glcheck(glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pbo));
+        glcheck(glBufferData(GL_PIXEL_UNPACK_BUFFER, bytes, NULL, GL_STREAM_DRAW));
+        GLubyte* staging = (GLubyte*) glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, bytes,
+                                                       GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+        if (!staging) {
+            LOG(error, "cannot map the staging buffer of the texture " << upload->key << ", it keeps its placeholder");
+            glcheck(glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0));
+            glcheck(glDeleteBuffers(1, &pbo));
+            continue;
+        }
+        std::size_t offset = 0;
+        for (const std::vector<unsigned char>& level : data.levels) {
+            std::memcpy(staging + offset, level.data(), level.size());
+            offset += level.size();
+        }
+        glcheck(glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER));
+
+        glcheck(glGenTextures(1, &texture.m_id));
+        glcheck(glBindTexture(target, texture.m_id));
+
+        GLint wrap = upload->repeat ? GL_REPEAT : GL_CLAMP_TO_EDGE;
+        GLint magFilter = upload->filtering == NEAREST_FILTERING ? GL_NEAREST : GL_LINEAR;
+        GLint minFilter = magFilter;
+        if (upload->filtering == TRILINEAR_FILTERING && levels > 1) {
+            minFilter = GL_LINEAR_MIPMAP_LINEAR;
+        }
+        glcheck(glTexParameteri(target, GL_TEXTURE_MAG_FILTER, magFilter));
+        glcheck(glTexParameteri(target, GL_TEXTURE_MIN_FILTER, minFilter));
+        glcheck(glTexParameteri(target, GL_TEXTURE_WRAP_S, wrap));
+        glcheck(glTexParameteri(target, GL_TEXTURE_WRAP_T, wrap));
+
+        // The texels are sent as they are stored: 8 bits per channel, or compressed blocks
+        if (target == GL_TEXTURE_2D_ARRAY) {
+            glcheck(glTexStorage3D(target, levels, data.glInternalFormat, data.width, data.height, data.layers));
+        } else {
+            glcheck(glTexStorage2D(target, levels, data.glInternalFormat, data.width, data.height));
+        }
+        offset = 0;
+        for (unsigned int i = 0; i < data.levels.size(); ++i) {
+            const GLsizei width = data.getLevelWidth(i);
+            const GLsizei height = data.getLevelHeight(i);
+            const GLsizei size = data.levels[i].size();
+            if (target == GL_TEXTURE_2D_ARRAY && data.isCompressed()) {
+                glcheck(glCompressedTexSubImage3D(target, i, 0, 0, 0, width, height, data.layers,
+                                                  data.glInternalFormat, size, (const GLvoid*) offset));
+            } else if (target == GL_TEXTURE_2D_ARRAY) {
+                glcheck(glTexSubImage3D(target, i, 0, 0, 0, width, height, data.layers,
+                                        data.glFormat, data.glType, (const GLvoid*) offset));
+            } else if (data.isCompressed()) {
+                glcheck(glCompressedTexSubImage2D(target, i, 0, 0, width, height,
+                                                  data.glInternalFormat, size, (const GLvoid*) offset));
+            } else {
+                glcheck(glTexSubImage2D(target, i, 0, 0, width, height,
+                                        data.glFormat, data.glType, (const GLvoid*) offset));
+            }
+            offset += size;
+        }
+        if (generateMipMap) {
+            glcheck(glGenerateMipmap(target));
+        }
+
+        //Release the texture and the staging buffer
+        glcheck(glBindTexture(target, 0));
+        glcheck(glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0));
+        glcheck(glDeleteBuffers(1, &pbo));
+
+        texture.m_loaded = true;
+        sentBytes += bytes;
+        upload->data.levels.clear();
+    }
+}
+
+bool AssetManager::isLoading()
+{
+    return s_pendingTextures != 0;
+}
+
+void AssetManager::clear()
+{
+    m_meshes.clear();
+    m_textures.clear();
+
+    // The placeholders are created again if a texture still needs one
+    if (s_placeholderId) {
+        glcheck(glDeleteTextures(1, &s_placeholderId));
+        s_placeholderId = 0;
+    }
+    if (s_placeholderArrayId) {
+        glcheck(glDeleteTextures(1, &s_placeholderArrayId));
+        s_placeholderArrayId = 0;
+    }
+}
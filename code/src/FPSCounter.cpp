@@ -1,10 +1,63 @@
 #include "./../include/FPSCounter.hpp"
+#include "./../include/log.hpp"
+
+#include <algorithm>
 #include <chrono>
+#include <cmath>
+#include <fstream>
+
+/** Number of frames whose durations are kept to be drawn */
+#define FRAME_TIME_HISTORY 240
+
+/**
+ * @brief Percentile of sorted durations, by the nearest rank method
+ */
+static float percentile( const std::vector<float>& sorted, double proportion )
+{
+    const std::size_t rank = (std::size_t) std::ceil( proportion * sorted.size() );
+    return sorted[ std::min( std::max( rank, (std::size_t) 1 ), sorted.size() ) - 1 ];
+}
+
+/**
+ * @brief Compute the statistics of durations, sorting them
+ */
+static FPSCounter::Statistics computeStatistics( std::vector<float>& durations )
+{
+    FPSCounter::Statistics statistics;
+    if( durations.empty() )
+        return statistics;
+
+    std::sort( durations.begin(), durations.end() );
+    double sum = 0.0;
+    for( float duration : durations )
+        sum += duration;
+
+    statistics.min = durations.front();
+    statistics.mean = float( sum / durations.size() );
+    statistics.p50 = percentile( durations, 0.50 );
+    statistics.p95 = percentile( durations, 0.95 );
+    statistics.p99 = percentile( durations, 0.99 );
+    statistics.max = durations.back();
+    statistics.count = durations.size();
+    return statistics;
+}
+
+static void writeStatistics( std::ostream& out, const FPSCounter::Statistics& statistics )
+{
+    out << ',' << statistics.count << ',' << statistics.min << ',' << statistics.mean
+        << ',' << statistics.p50 << ',' << statistics.p95 << ',' << statistics.p99
+        << ',' << statistics.max;
+}
+
+FPSCounter::Statistics::Statistics()
+    : min(0.0f), mean(0.0f), p50(0.0f), p95(0.0f), p99(0.0f), max(0.0f), count(0)
+{}
 
 FPSCounter::FPSCounter( double displayInterval )
     : m_refreshInterval(displayInterval > 0.0 ? Duration(displayInterval) : Duration(2.0)),
-      m_lastRefreshTime(clock::now()), m_lastCallTime(clock::now()),
-      m_accumulatedFPS(0.0f), m_fps(0.0f), m_numberOfSamples(0)
+      m_startTime(clock::now()), m_lastRefreshTime(clock::now()), m_lastCallTime(clock::now()),
+      m_accumulatedFPS(0.0f), m_fps(0.0f), m_numberOfSamples(0),
+      m_numberOfFrames(0), m_frameTimes(FRAME_TIME_HISTORY, 0.0f)
 {}
 
 FPSCounter::~FPSCounter()
@@ -18,6 +71,15 @@ float FPSCounter::getFPS()
     m_accumulatedFPS += currentFPS;
     ++m_numberOfSamples;
 
+    // The first call also measures the initialization of the scene, it is not a frame
+    if( m_numberOfFrames > 0 )
+    {
+        const float milliseconds = float(duration.count() * 1000.0);
+        m_frameTimes[ m_numberOfFrames % FRAME_TIME_HISTORY ] = milliseconds;
+        m_intervalFrameTimes.push_back( milliseconds );
+    }
+    ++m_numberOfFrames;
+
     // It's time to update the value
     if( currentTime > m_lastRefreshTime + m_refreshInterval )
     {
@@ -25,8 +87,76 @@ float FPSCounter::getFPS()
         m_accumulatedFPS = double(0);
         m_numberOfSamples = 0;
         m_lastRefreshTime = currentTime;
+
+        m_frameStatistics = computeStatistics( m_intervalFrameTimes );
+        m_intervalFrameTimes.clear();
+
+        // Swap the buffers, the simulation keeps reporting steps while they are sorted
+        {
+            std::lock_guard<std::mutex> lock( m_stepTimesMutex );
+            m_refreshedStepTimes.swap( m_intervalStepTimes );
+        }
+        m_stepStatistics = computeStatistics( m_refreshedStepTimes );
+        m_refreshedStepTimes.clear();
+
+        Record record;
+        record.time = Duration( currentTime - m_startTime ).count();
+        record.fps = m_fps;
+        record.frames = m_frameStatistics;
+        record.steps = m_stepStatistics;
+        m_history.push_back( record );
     }
 
     m_lastCallTime = currentTime;
     return m_fps;
 }
+
+void FPSCounter::addSimulationStep( double duration )
+{
+    std::lock_guard<std::mutex> lock( m_stepTimesMutex );
+    m_intervalStepTimes.push_back( float(duration * 1000.0) );
+}
+
+const FPSCounter::Statistics& FPSCounter::getFrameTimeStatistics() const
+{
+    return m_frameStatistics;
+}
+
+const FPSCounter::Statistics& FPSCounter::getSimulationStepStatistics() const
+{
+    return m_stepStatistics;
+}
+
+void FPSCounter::getFrameTimes( std::vector<float>& frameTimes ) const
+{
+    // The first call to getFPS() did not record a frame
+    const unsigned long recorded = m_numberOfFrames > 0 ? m_numberOfFrames - 1 : 0;
+    const unsigned long count = std::min( recorded, (unsigned long) FRAME_TIME_HISTORY );
+    frameTimes.resize( count );
+    for( unsigned long i = 0; i < count; ++i )
+        frameTimes[i] = m_frameTimes[ (m_numberOfFrames - count + i) % FRAME_TIME_HISTORY ];
+}
+
+bool FPSCounter::exportCSV( const std::string& filename ) const
+{
+    std::ofstream out( filename.c_str() );
+    if( !out )
+    {
+        LOG( error, "Cannot write the frame times " << filename );
+        return false;
+    }
+
+    out << "time,fps,"
+        << "frames,frame_min,frame_mean,frame_p50,frame_p95,frame_p99,frame_max,"
+        << "steps,step_min,step_mean,step_p50,step_p95,step_p99,step_max\n";
+    for( const Record& record : m_history )
+    {
+        out << record.time << ',' << record.fps;
+        writeStatistics( out, record.frames );
+        writeStatistics( out, record.steps );
+        out << '\n';
+    }
+
+    LOG( info, "Frame times successfully exported : " << filename );
+    return true;
+}
@@ -0,0 +1,114 @@
+#include "./../include/FrameTimeGraph.hpp"
+#include "./../include/gl_helper.hpp"
+
+#include <algorithm>
+
+#include <glm/gtc/type_ptr.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <GL/glew.h>
+
+// Each vertex is made of a 2D position and a RGBA color
+static const int floats_per_vertex = 6;
+
+static const glm::vec4 background_color( 0.0f, 0.0f, 0.0f, 0.35f );
+static const glm::vec4 budget_color( 1.0f, 1.0f, 1.0f, 0.8f );
+static const glm::vec4 within_budget_color( 0.2f, 0.8f, 0.2f, 0.9f );
+static const glm::vec4 over_budget_color( 1.0f, 0.6f, 0.1f, 0.9f );
+static const glm::vec4 clamped_color( 0.9f, 0.1f, 0.1f, 0.9f );
+
+FrameTimeGraph::FrameTimeGraph()
+  : m_vboVertices{0}, m_vertexLocation{-1},
+    m_colorLocation{-1}, m_projectionLocation{-1}
+{}
+
+FrameTimeGraph::~FrameTimeGraph()
+{
+  if( m_vboVertices )
+    {
+      glcheck(glDeleteBuffers(1, &m_vboVertices));
+    }
+}
+
+void FrameTimeGraph::init()
+{
+  // init program and acquire GPU variables locations (names)
+  m_program.load(std::list<std::string>{"./../shaders/hud_vertex.vert",
+      "./../shaders/hud_fragment.frag"});
+  m_projectionLocation = m_program.getUniformLocation( "projection" );
+  m_vertexLocation = m_program.getAttributeLocation( "vertex" );
+  m_colorLocation = m_program.getAttributeLocation( "color" );
+
+  // create VBO
+  glcheck(glGenBuffers(1, &m_vboVertices));
+}
+
+void FrameTimeGraph::setWindowDimensions( float width, float height )
+{
+  m_projection = glm::ortho(float(0), width, float(0), height );
+}
+
+void FrameTimeGraph::addQuad( const glm::vec2& lowerLeft, const glm::vec2& upperRight, const glm::vec4& color )
+{
+  const glm::vec2 corners[6] = {
+    lowerLeft, glm::vec2( upperRight.x, lowerLeft.y ), upperRight,
+    lowerLeft, upperRight, glm::vec2( lowerLeft.x, upperRight.y )
+  };
+  for( const glm::vec2& corner : corners )
+    {
+      m_vertices.push_back( corner.x );
+      m_vertices.push_back( corner.y );
+      m_vertices.push_back( color.r );
+      m_vertices.push_back( color.g );
+      m_vertices.push_back( color.b );
+      m_vertices.push_back( color.a );
+    }
+}
+
+void FrameTimeGraph::render( const std::vector<float>& frameTimes, const glm::vec2& pixelCoordinates,
+                             const glm::vec2& size, float budget )
+{
+  if( frameTimes.empty() || budget <= 0.0f )
+    return;
+
+  // the graph spans twice the budget, the budget line is at half its height
+  const float pixelsPerMillisecond = size.y / ( 2.0f * budget );
+  const float barWidth = size.x / frameTimes.size();
+  const glm::vec2 upperRight = pixelCoordinates + size;
+
+  m_vertices.clear();
+  addQuad( pixelCoordinates, upperRight, background_color );
+  for( std::size_t i = 0; i < frameTimes.size(); ++i )
+    {
+      const float duration = std::min( frameTimes[i], 2.0f * budget );
+      const glm::vec4& color = frameTimes[i] > 2.0f * budget ? clamped_color
+        : frameTimes[i] > budget ? over_budget_color : within_budget_color;
+      const float x = pixelCoordinates.x + i * barWidth;
+      addQuad( glm::vec2( x, pixelCoordinates.y ),
+               glm::vec2( x + barWidth, pixelCoordinates.y + duration * pixelsPerMillisecond ), color );
+    }
+  const float budgetY = pixelCoordinates.y + 0.5f * size.y;
+  addQuad( glm::vec2( pixelCoordinates.x, budgetY ), glm::vec2( upperRight.x, budgetY + 1.0f ), budget_color );
+
+  // the quads will be blended with what is behind (the 3D scene)
+  glcheck(glEnable(GL_BLEND));
+  glcheck(glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA));
+
+  m_program.bind();
+  glcheck(glUniformMatrix4fv(m_projectionLocation, 1, GL_FALSE, glm::value_ptr(m_projection)));
+
+  // transfer our vertex data, interleaving the positions and the colors
+  glcheck(glBindBuffer(GL_ARRAY_BUFFER, m_vboVertices));
+  glcheck(glBufferData(GL_ARRAY_BUFFER, m_vertices.size() * sizeof(float), m_vertices.data(), GL_DYNAMIC_DRAW));
+  glcheck(glEnableVertexAttribArray(m_vertexLocation));
+  glcheck(glVertexAttribPointer(m_vertexLocation, 2, GL_FLOAT, GL_FALSE, floats_per_vertex * sizeof(float), (void*)0));
+  glcheck(glEnableVertexAttribArray(m_colorLocation));
+  glcheck(glVertexAttribPointer(m_colorLocation, 4, GL_FLOAT, GL_FALSE, floats_per_vertex * sizeof(float), (void*)(2 * sizeof(float))));
+
+  glcheck(glDrawArrays(GL_TRIANGLES, 0, m_vertices.size() / floats_per_vertex ));
+
+  // restore the previous openGL state
+  glcheck(glDisableVertexAttribArray(m_vertexLocation));
+  glcheck(glDisableVertexAttribArray(m_colorLocation));
+  glcheck(glDisable(GL_BLEND));
+}
@@ -8,7 +8,10 @@ HierarchicalRenderable::~HierarchicalRenderable(){}
 
 HierarchicalRenderable::HierarchicalRenderable(ShaderProgramPtr shaderProgram) : 
     Renderable(shaderProgram), m_parent( nullptr ),
-    m_parentTransform( glm::mat4(1.0) ), m_localTransform( glm::mat4(1.0) )
+    m_parentTransform( glm::mat4(1.0) ), m_localTransform( glm::mat4(1.0) ),
+    m_totalParentTransform( glm::mat4(1.0) ),
+    m_hierarchyChanged( true ), m_parentTransformDirty( true ),
+    m_localTransformDirty( true ), m_totalParentTransformChanged( false )
 {}
 
 
@@ -20,12 +23,59 @@ const glm::mat4& HierarchicalRenderable::getParentTransform() const
 void HierarchicalRenderable::setParentTransform( const glm::mat4& parentTransform )
 {
     m_parentTransform = parentTransform;
+    m_parentTransformDirty = true;
 }
 
 void HierarchicalRenderable::updateModelMatrix()
 {
-    //TODO: Get absolute model matrix
-    m_model = computeTotalParentTransform()*m_localTransform;
+    HierarchicalRenderable* root = this;
+    while( root->m_parent )
+    {
+        root = root->m_parent.get();
+    }
+    root->updateHierarchy();
+}
+
+void HierarchicalRenderable::updateHierarchy()
+{
+    if( m_hierarchyChanged )
+    {
+        m_hierarchy.clear();
+        flattenHierarchy( m_hierarchy );
+        m_hierarchyChanged = false;
+    }
+
+    //The parents are updated before their children, so that the cached
+    //total parent transform of the parent is up-to-date when used.
+    for( HierarchicalRenderable* node : m_hierarchy )
+    {
+        const HierarchicalRenderable* parent = node->m_parent.get();
+        node->m_totalParentTransformChanged = node->m_parentTransformDirty
+            || ( parent && parent->m_totalParentTransformChanged );
+
+        if( node->m_totalParentTransformChanged )
+        {
+            node->m_totalParentTransform = parent
+                ? parent->m_totalParentTransform*node->m_parentTransform
+                : node->m_parentTransform;
+        }
+        if( node->m_totalParentTransformChanged || node->m_localTransformDirty )
+        {
+            node->m_model = node->m_totalParentTransform*node->m_localTransform;
+        }
+
+        node->m_parentTransformDirty = false;
+        node->m_localTransformDirty = false;
+    }
+}
+
+void HierarchicalRenderable::flattenHierarchy( std::vector< HierarchicalRenderable* >& hierarchy )
+{
+    hierarchy.push_back( this );
+    for( HierarchicalRenderablePtr child : m_children )
+    {
+        child->flattenHierarchy( hierarchy );
+    }
 }
 
 const glm::mat4& HierarchicalRenderable::getLocalTransform() const
@@ -36,40 +86,39 @@ const glm::mat4& HierarchicalRenderable::getLocalTransform() const
 void HierarchicalRenderable::setLocalTransform(const glm::mat4& localTransform)
 {
     m_localTransform = localTransform;
+    m_localTransformDirty = true;
 }
 
 glm::mat4 HierarchicalRenderable::computeTotalParentTransform() const
 {
     if( m_parent )
     {
-        //TODO: Get recursive parent transformation
         return m_parent->computeTotalParentTransform()*m_parentTransform;
     }
     else
     {
-        //TODO: Get recursive parent transformation
         return m_parentTransform;
     }
 }
 
-void HierarchicalRenderable::beforeDraw()
+void HierarchicalRenderable::beforeEnqueue(RenderQueue& queue)
 {
     //Each time m_localTransform is modified we need to update the model matrix of the instance.
     //Each time m_parentTransform is modified we need to udpate the model matrix of the instance and its children.
-    //This could be implemented efficiently using a flag system to update the hierarchy whenever m_parentTransform is called.
-    updateModelMatrix();
+    //The root updates the whole hierarchy before its instances are added to the queue,
+    //so that their depth is computed from up-to-date model matrices.
+    if( !m_parent )
+    {
+        updateHierarchy();
+    }
 }
 
-void HierarchicalRenderable::afterDraw()
+void HierarchicalRenderable::afterEnqueue(RenderQueue& queue)
 {
-    //After the instance has been drawn using do_draw(),
-    //we loop over its children and draw them.
-    //The subtlety is that these children can be drawn with different shaderProgram,
-    //therefore we shall NOT forget to :
-    //-Bind their respective shaderProgram
-    //-Send projection and view matrix to the GPU
-    //-Draw the object ;)
-    //-Unbind their respective shaderProgram.
+    //After the instance has been added to the render queue,
+    //we loop over its children and add them too.
+    //The queue binds their respective shaderProgram when drawing them,
+    //so that the children sharing a shaderProgram are drawn together.
     for(size_t i=0; i<m_children.size(); ++i)
     {
         // this affectation here is a little hack we use to keep the source code simple.
@@ -78,14 +127,8 @@ void HierarchicalRenderable::afterDraw()
         // to the viewer, thus they do not have the field m_viewer correctly setted. This is why we perform this
         // affectation here: we are then sure this field is up-to-date when a do_draw() method is called.
         m_children[i]->m_viewer = m_viewer;
-
-        m_children[i]->bindShaderProgram();
-        glcheck(glUniformMatrix4fv(m_children[i]->projectionLocation(), 1, GL_FALSE, glm::value_ptr(m_viewer->getCamera().projectionMatrix())));
-        glcheck(glUniformMatrix4fv(m_children[i]->viewLocation(), 1, GL_FALSE, glm::value_ptr(m_viewer->getCamera().viewMatrix())));
-        m_children[i]->draw();
-        m_children[i]->unbindShaderProgram();
+        m_children[i]->enqueue(queue);
     }
-
 }
 
 void HierarchicalRenderable::afterAnimate(float time)
@@ -99,7 +142,16 @@ void HierarchicalRenderable::afterAnimate(float time)
 void HierarchicalRenderable::addChild( HierarchicalRenderablePtr parent, HierarchicalRenderablePtr child )
 {
     child->m_parent = parent;
+    child->m_parentTransformDirty = true;
+    child->m_hierarchy.clear();
     parent->m_children.push_back(child);
+
+    HierarchicalRenderable* root = parent.get();
+    while( root->m_parent )
+    {
+        root = root->m_parent.get();
+    }
+    root->m_hierarchyChanged = true;
 }
 
 std::vector< HierarchicalRenderablePtr > & HierarchicalRenderable::getChildren()
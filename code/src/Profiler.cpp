@@ -0,0 +1,153 @@
+#include "./../include/Profiler.hpp"
+#include "./../include/log.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/** Number of markers kept per thread, the oldest ones being overwritten */
+#define PROFILER_CAPACITY (1 << 16)
+
+namespace
+{
+/** @brief A marker, in microseconds since the start of the profiler. */
+struct Marker
+{
+  const char* name;
+  std::int64_t start;
+  std::int64_t duration;
+};
+
+/** @brief The ring buffer of the markers of a thread.
+ *
+ * Only its thread writes in it. The count of the markers ever written is
+ * published after each marker, so that an export knows which markers are
+ * complete, and which ones may have been overwritten while it read them.
+ */
+struct ThreadMarkers
+{
+  ThreadMarkers( unsigned int id ) : id( id ), count( 0 ), markers( PROFILER_CAPACITY ) {}
+
+  unsigned int id;
+  std::string name;
+  std::atomic<std::uint64_t> count;
+  std::vector<Marker> markers;
+};
+
+std::atomic<bool> g_enabled( true );
+const Profiler::clock::time_point g_origin = Profiler::clock::now();
+
+/** Protects the registration of the threads, never the recording */
+std::mutex g_threadsMutex;
+/** The buffers of every thread which recorded a marker, kept after the threads end */
+std::vector< std::unique_ptr<ThreadMarkers> > g_threads;
+
+ThreadMarkers& threadMarkers()
+{
+  static thread_local ThreadMarkers* markers = nullptr;
+  if( !markers )
+  {
+    std::lock_guard<std::mutex> lock( g_threadsMutex );
+    g_threads.push_back( std::unique_ptr<ThreadMarkers>( new ThreadMarkers( g_threads.size() ) ) );
+    markers = g_threads.back().get();
+  }
+  return *markers;
+}
+
+std::int64_t microseconds( const Profiler::clock::time_point& time )
+{
+  return std::chrono::duration_cast<std::chrono::microseconds>( time - g_origin ).count();
+}
+
+void writeString( std::ostream& out, const std::string& s )
+{
+  out << '"';
+  for( char c : s )
+  {
+    if( c == '"' || c == '\\' )
+      out << '\\';
+    out << c;
+  }
+  out << '"';
+}
+}
+
+void Profiler::setEnabled( bool enabled )
+{
+  g_enabled.store( enabled, std::memory_order_relaxed );
+}
+
+bool Profiler::isEnabled()
+{
+  return g_enabled.load( std::memory_order_relaxed );
+}
+
+void Profiler::setThreadName( const std::string& name )
+{
+  ThreadMarkers& markers = threadMarkers();
+  std::lock_guard<std::mutex> lock( g_threadsMutex );
+  markers.name = name;
+}
+
+void Profiler::record( const char* name, const clock::time_point& start, const clock::time_point& end )
+{
+  ThreadMarkers& markers = threadMarkers();
+  const std::uint64_t count = markers.count.load( std::memory_order_relaxed );
+  Marker& marker = markers.markers[ count % PROFILER_CAPACITY ];
+  marker.name = name;
+  marker.start = microseconds( start );
+  marker.duration = microseconds( end ) - marker.start;
+  markers.count.store( count + 1, std::memory_order_release );
+}
+
+bool Profiler::exportChromeTrace( const std::string& filename )
+{
+  std::ofstream out( filename.c_str() );
+  if( !out )
+  {
+    LOG( error, "Cannot write the profile " << filename );
+    return false;
+  }
+
+  std::lock_guard<std::mutex> lock( g_threadsMutex );
+  out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  bool first = true;
+  std::vector<Marker> copy;
+  for( const std::unique_ptr<ThreadMarkers>& thread : g_threads )
+  {
+    if( !thread->name.empty() )
+    {
+      out << ( first ? "" : "," ) << "\n{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":0,\"tid\":" << thread->id
+          << ",\"args\":{\"name\":";
+      writeString( out, thread->name );
+      out << "}}";
+      first = false;
+    }
+
+    // Copy the markers, then keep the ones the thread could not overwrite meanwhile
+    const std::uint64_t end = thread->count.load( std::memory_order_acquire );
+    const std::uint64_t begin = end > PROFILER_CAPACITY ? end - PROFILER_CAPACITY : 0;
+    copy.clear();
+    for( std::uint64_t i = begin; i < end; ++i )
+      copy.push_back( thread->markers[ i % PROFILER_CAPACITY ] );
+    std::atomic_thread_fence( std::memory_order_acquire );
+    const std::uint64_t endAfterCopy = thread->count.load( std::memory_order_relaxed );
+    // The thread may be writing the marker endAfterCopy, in the slot of endAfterCopy - PROFILER_CAPACITY
+    const std::uint64_t valid = endAfterCopy + 1 > PROFILER_CAPACITY ? endAfterCopy + 1 - PROFILER_CAPACITY : 0;
+
+    for( std::uint64_t i = std::max( begin, valid ); i < end; ++i )
+    {
+      const Marker& marker = copy[ i - begin ];
+      out << ( first ? "" : "," ) << "\n{\"ph\":\"X\",\"cat\":\"cpu\",\"name\":";
+      writeString( out, marker.name );
+      out << ",\"pid\":0,\"tid\":" << thread->id << ",\"ts\":" << marker.start << ",\"dur\":" << marker.duration << "}";
+      first = false;
+    }
+  }
+  out << "\n]}\n";
+
+  LOG( info, "Profile successfully exported : " << filename );
+  return true;
+}
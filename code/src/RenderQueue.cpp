@@ -0,0 +1,100 @@
+#include "./../include/RenderQueue.hpp"
+#include "./../include/Renderable.hpp"
+#include "./../include/gl_helper.hpp"
+
+#include <algorithm>
+#include <GL/glew.h>
+
+bool RenderItem::operator<(const RenderItem& other) const
+{
+    if (pass != other.pass) {
+        return pass < other.pass;
+    }
+
+    if (pass == TRANSPARENT_PASS) {
+        // Back to front
+        if (depth != other.depth) {
+            return depth > other.depth;
+        }
+    } else {
+        if (program != other.program) {
+            return program < other.program;
+        }
+        if (texture != other.texture) {
+            return texture < other.texture;
+        }
+        if (mesh != other.mesh) {
+            return mesh < other.mesh;
+        }
+        // Front to back
+        if (depth != other.depth) {
+            return depth < other.depth;
+        }
+    }
+
+    return sequence < other.sequence;
+}
+
+void RenderQueue::clear(const glm::vec3& cameraPosition)
+{
+    m_items.clear();
+    m_cameraPosition = cameraPosition;
+}
+
+void RenderQueue::push(Renderable* renderable)
+{
+    const glm::vec3 offset = renderable->getSortPosition() - m_cameraPosition;
+
+    RenderItem item;
+    item.pass = renderable->getRenderPass();
+    item.program = renderable->getShaderProgram() ? renderable->getShaderProgram()->programId() : 0;
+    item.texture = renderable->getTextureKey();
+    item.mesh = renderable->getMeshKey();
+    item.depth = glm::dot(offset, offset);
+    item.sequence = m_items.size();
+    item.renderable = renderable;
+    m_items.push_back(item);
+}
+
+void RenderQueue::draw()
+{
+    std::sort(m_items.begin(), m_items.end());
+
+    bool programBound = false;
+    unsigned int currentProgram = 0;
+    unsigned int currentPass = OPAQUE_PASS;
+
+    for (const RenderItem& item : m_items) {
+        if (item.pass != currentPass) {
+            glcheck(glEnable(GL_BLEND));
+            glcheck(glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA));
+            glcheck(glDepthMask(GL_FALSE));
+            currentPass = item.pass;
+        }
+
+        if (!programBound || item.program != currentProgram) {
+            if (item.program) {
+                item.renderable->bindShaderProgram();
+            } else {
+                ShaderProgram::unbind();
+            }
+            currentProgram = item.program;
+            programBound = true;
+        }
+
+        item.renderable->draw();
+    }
+
+    if (currentPass == TRANSPARENT_PASS) {
+        glcheck(glDepthMask(GL_TRUE));
+        glcheck(glDisable(GL_BLEND));
+    }
+    if (programBound) {
+        ShaderProgram::unbind();
+    }
+}
+
+std::size_t RenderQueue::size() const
+{
+    return m_items.size();
+}
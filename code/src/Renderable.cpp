@@ -6,7 +6,8 @@
 Renderable::~Renderable(){}
 
 Renderable::Renderable(ShaderProgramPtr program)
-  : m_shaderProgram(program),
+  : m_renderPass(OPAQUE_PASS),
+    m_shaderProgram(program),
     m_model(glm::mat4(1.0)), // default: loads the identity
     m_viewer(nullptr)
 {}
@@ -21,16 +22,6 @@ void Renderable::unbindShaderProgram()
     ShaderProgram::unbind();
 }
 
-int Renderable::projectionLocation()
-{
-    return m_shaderProgram->getUniformLocation("projMat");
-}
-
-int Renderable::viewLocation()
-{
-    return m_shaderProgram->getUniformLocation("viewMat");
-}
-
 void Renderable::draw()
 {
   beforeDraw();
@@ -38,6 +29,13 @@ void Renderable::draw()
   afterDraw();
 }
 
+void Renderable::enqueue( RenderQueue& queue )
+{
+  beforeEnqueue( queue );
+  queue.push( this );
+  afterEnqueue( queue );
+}
+
 void Renderable::animate( float time )
 {
   beforeAnimate( time );
@@ -118,6 +116,52 @@ void Renderable::afterDraw()
 
 void Renderable::afterAnimate( float time )
 {}
+
+void Renderable::beforeEnqueue( RenderQueue& queue )
+{}
+
+void Renderable::afterEnqueue( RenderQueue& queue )
+{}
+
+unsigned int Renderable::do_getTextureKey() const
+{
+    return 0;
+}
+
+unsigned int Renderable::do_getMeshKey() const
+{
+    return 0;
+}
+
+glm::vec3 Renderable::do_getSortPosition() const
+{
+    return glm::vec3(m_model[3]);
+}
+
+void Renderable::setRenderPass( RenderPass pass )
+{
+    m_renderPass = pass;
+}
+
+RenderPass Renderable::getRenderPass() const
+{
+    return m_renderPass;
+}
+
+unsigned int Renderable::getTextureKey() const
+{
+    return do_getTextureKey();
+}
+
+unsigned int Renderable::getMeshKey() const
+{
+    return do_getMeshKey();
+}
+
+glm::vec3 Renderable::getSortPosition() const
+{
+    return do_getSortPosition();
+}
 ShaderProgramPtr Renderable::getShaderProgram() const
 {
     return m_shaderProgram;
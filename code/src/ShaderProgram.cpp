@@ -11,11 +11,52 @@
 #include "./../include/ShaderProgram.hpp"
 #include "./../include/log.hpp"
 #include "./../include/gl_helper.hpp"
+#include "./../include/UniformBuffer.hpp"
 
 using namespace std;
 
 int ShaderProgram::null_location = -1;
 
+// The interned names are built on first use, since static ShaderVariable
+// may be built before the static variables of this file.
+static std::vector< std::string >& interned_names()
+{
+  static std::vector< std::string > names;
+  return names;
+}
+
+static std::unordered_map< std::string, unsigned int >& interned_identifiers()
+{
+  static std::unordered_map< std::string, unsigned int > identifiers;
+  return identifiers;
+}
+
+ShaderVariable::ShaderVariable( const std::string& name )
+{
+  std::unordered_map< std::string, unsigned int >& identifiers = interned_identifiers();
+  std::unordered_map< std::string, unsigned int >::const_iterator search = identifiers.find( name );
+  if( search != identifiers.end() )
+    {
+      m_id = search->second;
+    }
+  else
+    {
+      m_id = interned_names().size();
+      interned_names().push_back( name );
+      identifiers.insert( {{ name, m_id }} );
+    }
+}
+
+const std::string& ShaderVariable::name() const
+{
+  return interned_names()[ m_id ];
+}
+
+unsigned int ShaderVariable::count()
+{
+  return interned_names().size();
+}
+
 static void
 dump_shader_log( GLuint shader )
 {
@@ -134,13 +175,14 @@ compile_shader( const std::string& gpu_name, GLuint type )
 }
 
 ShaderProgram::ShaderProgram()
-  : m_programId{0}
+  : m_programId{0}, m_revision{0}
 {}
 
 
 ShaderProgram::ShaderProgram(const std::list< std::string >& shader_sources)
     :   m_programId{ 0 },
-        m_source_filenames{ shader_sources }
+        m_source_filenames{ shader_sources },
+        m_revision{ 0 }
   {
       reload();
   }
@@ -172,7 +214,7 @@ void
 ShaderProgram::reload()
 {
     if( m_programId ) {
-	glcheck(glDeleteShader(m_programId));
+	glcheck(glDeleteProgram(m_programId));
     }
 
     m_programId = 0;
@@ -221,6 +263,10 @@ ShaderProgram::reload()
     else {
 	glcheck(glDeleteProgram(m_programId));
 	m_programId = 0;
+	m_uniforms.clear();
+	m_attributes.clear();
+	m_uniformLocations.clear();
+	m_attributeLocations.clear();
     }
 }
 
@@ -272,6 +318,9 @@ ShaderProgram::ressources_introspection()
     //Clean the maps
     m_uniforms.clear();
     m_attributes.clear();
+    m_uniformLocations.clear();
+    m_attributeLocations.clear();
+    ++m_revision;
 
     GLint values[3];
 
@@ -309,6 +358,41 @@ ShaderProgram::ressources_introspection()
 	    LOG( info, "    - attribute #" << att << ": " << name );
 	    delete[]name;
 	}
+
+    //Associate the uniform blocks to their binding points
+    GLint num_blocks = 0;
+    glcheck(glGetProgramInterfaceiv( m_programId, GL_UNIFORM_BLOCK, GL_ACTIVE_RESOURCES, &num_blocks ));
+    LOG( info, "  * " << num_blocks << " uniform block(s)");
+    for( int block = 0; block < num_blocks; ++ block )
+	{
+	    const GLenum name_length = GL_NAME_LENGTH;
+	    glcheck(glGetProgramResourceiv( m_programId, GL_UNIFORM_BLOCK, block, 1, &name_length, 1, NULL, values ));
+	    char* name = new char[values[0]];
+	    glcheck(glGetProgramResourceName(m_programId, GL_UNIFORM_BLOCK, block, values[0], NULL, &name[0]));
+	    int binding = uniformBlockBinding( name );
+	    if( binding >= 0 )
+		{
+		    glcheck(glUniformBlockBinding( m_programId, block, binding ));
+		    LOG( info, "    - uniform block #" << block << ": " << name << " (binding " << binding << ")" );
+		}
+	    else
+		{
+		    LOG( warning, "    - uniform block #" << block << ": " << name << " has no binding point" );
+		}
+	    delete[]name;
+	}
+
+    resolveLocations();
+}
+
+void
+ShaderProgram::resolveLocations() const
+{
+    const std::vector< std::string >& names = interned_names();
+    for( unsigned int id = m_uniformLocations.size(); id < names.size(); ++ id )
+	m_uniformLocations.push_back( getUniformLocation( names[id] ) );
+    for( unsigned int id = m_attributeLocations.size(); id < names.size(); ++ id )
+	m_attributeLocations.push_back( getAttributeLocation( names[id] ) );
 }
 
 GLint ShaderProgram::getUniformLocation( const std::string& name ) const
@@ -329,3 +413,7 @@ GLint ShaderProgram::getAttributeLocation( const std::string& name ) const
   return null_location;
 }
 
+unsigned int ShaderProgram::getRevision() const
+{
+  return m_revision;
+}
@@ -0,0 +1,55 @@
+#include "./../include/UniformBuffer.hpp"
+#include "./../include/gl_helper.hpp"
+
+#include <GL/glew.h>
+
+static_assert(sizeof(CameraBlock) == 144, "CameraBlock does not follow the std140 layout");
+static_assert(sizeof(DirectionalLightBlock) == 64, "DirectionalLightBlock does not follow the std140 layout");
+static_assert(sizeof(PointLightBlock) == 80, "PointLightBlock does not follow the std140 layout");
+static_assert(sizeof(SpotLightBlock) == 96, "SpotLightBlock does not follow the std140 layout");
+static_assert(sizeof(LightsBlock) == 1840, "LightsBlock does not follow the std140 layout");
+static_assert(sizeof(MaterialBlock) == 48, "MaterialBlock does not follow the std140 layout");
+
+int uniformBlockBinding(const std::string& blockName)
+{
+    if (blockName == "Camera") {
+        return CAMERA_BLOCK_BINDING;
+    } else if (blockName == "Lights") {
+        return LIGHTS_BLOCK_BINDING;
+    } else if (blockName == "MaterialBlock") {
+        return MATERIAL_BLOCK_BINDING;
+    }
+    return -1;
+}
+
+UniformBuffer::UniformBuffer()
+    : m_id(0), m_size(0)
+{}
+
+UniformBuffer::~UniformBuffer()
+{
+    if (m_id) {
+        glcheck(glDeleteBuffers(1, &m_id));
+    }
+}
+
+void UniformBuffer::update(const void* data, std::size_t size)
+{
+    if (!m_id) {
+        glcheck(glGenBuffers(1, &m_id));
+    }
+
+    glcheck(glBindBuffer(GL_UNIFORM_BUFFER, m_id));
+    if (size != m_size) {
+        glcheck(glBufferData(GL_UNIFORM_BUFFER, size, data, GL_DYNAMIC_DRAW));
+        m_size = size;
+    } else {
+        glcheck(glBufferSubData(GL_UNIFORM_BUFFER, 0, size, data));
+    }
+    glcheck(glBindBuffer(GL_UNIFORM_BUFFER, 0));
+}
+
+void UniformBuffer::bind(unsigned int binding) const
+{
+    glcheck(glBindBufferBase(GL_UNIFORM_BUFFER, binding, m_id));
+}
@@ -1,7 +1,10 @@
 #include "./../include/gl_helper.hpp"
 #include "./../include/log.hpp"
 #include "./../include/Viewer.hpp"
+#include "./../include/AssetManager.hpp"
+#include "./../include/Profiler.hpp"
 
+#include <algorithm>
 #include <iostream>
 #include <sstream>
 #include <iomanip>
@@ -12,6 +15,9 @@ static const Viewer::Duration g_modeInformationTextTimeout = std::chrono::second
 
 static const std::string screenshot_basename = "screenshot";
 
+static const std::string profile_basename = "profile";
+static const std::string frame_times_basename = "frametimes";
+
 static void initializeGL()
 {
     //Initialize GLEW
@@ -35,7 +41,12 @@ Viewer::KeyboardState::KeyboardState()
 {}
 
 Viewer::~Viewer()
-{}
+{
+    // Release the renderables first: the boids simulation thread reports its
+    // steps to m_fpsCounter until its renderable stops and joins it
+    m_renderables.clear();
+    AssetManager::clear();
+}
 
 Viewer::Viewer(float width, float height, int maxFPS) :
     m_window{
@@ -48,7 +59,8 @@ Viewer::Viewer(float width, float height, int maxFPS) :
     m_modeInformationText{ "Arcball Camera Activated" },
     m_applicationRunning{ true }, m_animationLoop{ false }, m_animationIsStarted{ false },
     m_loopDuration{0}, m_simulationTime{0},
-    m_screenshotCounter{0}, m_helpDisplayed{false},
+    m_screenshotCounter{0}, m_profileCounter{0}, m_frameTimesCounter{0},
+    m_frameTimeBudget{ 1000.0f / maxFPS }, m_helpDisplayed{false},
     m_lastEventHandleTime{ clock::now() },
 	m_mapGenerator(NULL)
 {
@@ -71,6 +83,8 @@ Viewer::Viewer(float width, float height, int maxFPS) :
     //engine store some data on the graphic card)
     m_tengine.init();
     m_tengine.setWindowDimensions( m_window.getSize().x, m_window.getSize().y );
+    m_frameTimeGraph.init();
+    m_frameTimeGraph.setWindowDimensions( m_window.getSize().x, m_window.getSize().y );
     
     m_window.setFramerateLimit(maxFPS);
 }
@@ -82,6 +96,8 @@ static const std::string g_help_message =
         "      [F3]  Reload all managed shader program from their sources\n"
         "      [F4]  Pause/Stop the animation\n"
         "      [F5]  Reset the animation\n"
+        "      [F6]  Export the CPU profile of the last frames as a Chrome trace\n"
+        "      [F7]  Export the frame time statistics as CSV\n"
         "       [c]  Switch the camera mode between Arcball / Space ship\n"
 		"       [e]  Export the map data\n" 
         "[ctrl]+[w]  Quit the application\n"
@@ -115,15 +131,12 @@ void Viewer::followParticle(ParticlePtr particle) {
 
 void Viewer::draw()
 {
+    PROFILE_SCOPE("Viewer::draw");
+
+    // Send to the GPU the textures decoded in the background since the last frame
+    AssetManager::processUploads();
 
     glcheck(glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT));
-    for( ShaderProgramPtr prog : m_programs )
-    {
-        prog->bind();
-        DirectionalLight::sendToGPU( prog, m_directionalLight);
-        SpotLight::sendToGPU( prog, m_spotLights);
-        PointLight::sendToGPU( prog, m_pointLights);
-    }
 
     // Eventually set the camera to follow a particle
     if (isFollowing) {
@@ -133,21 +146,31 @@ void Viewer::draw()
     					   glm::vec3(0, 0, 1)));
     }
 
+    // Send the camera and the lights once, for every shader program
+    CameraBlock camera;
+    camera.projMat = m_camera.projectionMatrix();
+    camera.viewMat = m_camera.viewMatrix();
+    camera.viewport = glm::vec4(m_window.getSize().x, m_window.getSize().y,
+                                1.0f/m_window.getSize().x, 1.0f/m_window.getSize().y);
+    m_cameraBuffer.update(&camera, sizeof(CameraBlock));
+    m_cameraBuffer.bind(CAMERA_BLOCK_BINDING);
+
+    LightsBlock lights = LightsBlock();
+    if (m_directionalLight) {
+        m_directionalLight->writeBlock(lights.directionalLight);
+    }
+    PointLight::writeBlock(lights, m_pointLights);
+    SpotLight::writeBlock(lights, m_spotLights);
+    m_lightsBuffer.update(&lights, sizeof(LightsBlock));
+    m_lightsBuffer.bind(LIGHTS_BLOCK_BINDING);
 
+    // Draw the renderables sorted to limit the changes of OpenGL state
+    m_renderQueue.clear(m_camera.getPosition());
     for(RenderablePtr r : m_renderables)
     {
-	      
-        if( r->getShaderProgram() )
-        {
-	    
-            r->bindShaderProgram();
-            glcheck(glUniformMatrix4fv(r->projectionLocation(), 1, GL_FALSE, glm::value_ptr(m_camera.projectionMatrix())));
-            glcheck(glUniformMatrix4fv(r->viewLocation(), 1, GL_FALSE, glm::value_ptr(m_camera.viewMatrix())));
-
-        }
-        r->draw();
-        r->unbindShaderProgram();
+        r->enqueue(m_renderQueue);
     }
+    m_renderQueue.draw();
 
     //Refresh the viewer.m_window
     if( clock::now() < m_modeInformationTextDisappearanceTime )
@@ -159,6 +182,23 @@ void Viewer::draw()
         ss << "FPS: " << std::setprecision( 2 ) << std::fixed << m_fpsCounter.getFPS();
         m_tengine.render( ss.str(), glm::vec2(m_window.getSize().x - 200, m_window.getSize().y - 30), glm::vec3(0.1,0.1,0.1) );
     }
+    {
+        // Durations of the last frames, and statistics of the last refresh interval in milliseconds
+        m_fpsCounter.getFrameTimes( m_frameTimes );
+        m_frameTimeGraph.render( m_frameTimes, glm::vec2(m_window.getSize().x - 260, m_window.getSize().y - 100),
+                                 glm::vec2(240, 60), m_frameTimeBudget );
+
+        const FPSCounter::Statistics& frames = m_fpsCounter.getFrameTimeStatistics();
+        const FPSCounter::Statistics& steps = m_fpsCounter.getSimulationStepStatistics();
+        std::ostringstream ss;
+        ss << std::setprecision( 1 ) << std::fixed
+           << "ms     min mean  p50  p95  p99   max\n"
+           << "frame" << std::setw(5) << frames.min << std::setw(5) << frames.mean << std::setw(5) << frames.p50
+           << std::setw(5) << frames.p95 << std::setw(5) << frames.p99 << std::setw(6) << frames.max << "\n"
+           << "step " << std::setw(5) << steps.min << std::setw(5) << steps.mean << std::setw(5) << steps.p50
+           << std::setw(5) << steps.p95 << std::setw(5) << steps.p99 << std::setw(6) << steps.max;
+        m_tengine.render( ss.str(), glm::vec2(m_window.getSize().x - 260, m_window.getSize().y - 118), glm::vec3(0.1,0.1,0.1), 0.55f );
+    }
     if( m_helpDisplayed )
         m_tengine.render( g_help_message, glm::vec2(100, 650), glm::vec3{.0, .1, .2});
 }
@@ -177,6 +217,7 @@ float Viewer::getTime()
 
 void Viewer::animate()
 {
+    PROFILE_SCOPE("Viewer::animate");
     if(m_animationIsStarted)
     {
         for(RenderablePtr r : m_renderables)
@@ -226,7 +267,10 @@ void Viewer::resetAnimation()
 
 void Viewer::addRenderable(RenderablePtr r)
 {
-    m_renderables.insert(r);
+    if( std::find(m_renderables.begin(), m_renderables.end(), r) == m_renderables.end() )
+    {
+        m_renderables.push_back(r);
+    }
     r->m_viewer = this;
 }
 
@@ -261,6 +305,12 @@ void Viewer::keyPressedEvent(sf::Event& e)
         for(RenderablePtr r : m_renderables)
             r->keyPressedEvent(e);
         break;
+    case sf::Keyboard::F6:
+        exportProfile();
+        break;
+    case sf::Keyboard::F7:
+        exportFrameTimes();
+        break;
     case sf::Keyboard::W:
         if( e.key.control )
             m_applicationRunning = false;
@@ -403,6 +453,7 @@ void Viewer::handleEvent()
             m_window.setView(sf::View(sf::FloatRect(0, 0, event.size.width, event.size.height)));
             m_camera.setRatio( (float)(m_window.getSize().x)/(float)(m_window.getSize().y) );
             m_tengine.setWindowDimensions( m_window.getSize().x, m_window.getSize().y );
+            m_frameTimeGraph.setWindowDimensions( m_window.getSize().x, m_window.getSize().y );
             glcheck(glViewport(0, 0, event.size.width, event.size.height));
             break;
         case sf::Event::KeyPressed:
@@ -463,6 +514,24 @@ void Viewer::takeScreenshot()
     m_screenshotCounter++;
 }
 
+void Viewer::exportProfile()
+{
+    int padding = 5;
+    std::ostringstream filename_sstr;
+    filename_sstr << profile_basename << std::setw(padding) << std::setfill('0') << m_profileCounter << ".json";
+    Profiler::exportChromeTrace(filename_sstr.str());
+    m_profileCounter++;
+}
+
+void Viewer::exportFrameTimes()
+{
+    int padding = 5;
+    std::ostringstream filename_sstr;
+    filename_sstr << frame_times_basename << std::setw(padding) << std::setfill('0') << m_frameTimesCounter << ".csv";
+    m_fpsCounter.exportCSV(filename_sstr.str());
+    m_frameTimesCounter++;
+}
+
 void Viewer::changeCameraMode()
 {
     if( m_camera.getMouseBehavior() == Camera::ARCBALL_BEHAVIOR ) {
@@ -505,6 +574,11 @@ Camera& Viewer::getCamera()
     return m_camera;
 }
 
+FPSCounter& Viewer::getFPSCounter()
+{
+    return m_fpsCounter;
+}
+
 glm::vec3 Viewer::windowToWorld( const glm::vec3& windowCoordinate )
 {
     sf::Vector2u size = m_window.getSize();
@@ -4,10 +4,10 @@
 #include "./../../include/gl_helper.hpp"
 #include "./../../include/log.hpp"
 #include "./../../include/Utils.hpp"
+#include "./../../include/AssetManager.hpp"
 
 #include <glm/gtc/type_ptr.hpp>
 #include <GL/glew.h>
-#include <SFML/Graphics/Image.hpp>
 #include <glm/gtx/vector_angle.hpp>
 
 BoidRenderable::BoidRenderable(ShaderProgramPtr shaderProgram, BoidPtr boid)
@@ -35,50 +35,33 @@ BoidRenderable::BoidRenderable(ShaderProgramPtr shaderProgram, BoidPtr boid)
     m_normals.resize(m_positions.size(), glm::vec3(0.0,0.0,1.0));
     m_colors.resize(m_positions.size(), glm::vec4(1.0,1.0,1.0,1.0));
 
-    //Create texture
-    glGenTextures(1, &m_texId);
-
-    //Bind the texture
-    glBindTexture(GL_TEXTURE_2D, m_texId);
-
-    //Textured options
-    glcheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE));
-    glcheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE));
-    glcheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR));
-    glcheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR));
-
-    std::vector<glm::vec3> positions;
-    std::vector<glm::vec3> normals;
-    std::vector<glm::vec2> texCoords;
-
-    sf::Image image;
+    // The texture is shared by all the boids of the same type
+    std::string textureFilename;
     switch(boid->getBoidType()) {
         case RABBIT:
-            image.loadFromFile("./../textures/rabbit.png");
+            textureFilename = "./../textures/rabbit.png";
             break;
 
         case WOLF:
-            image.loadFromFile("./../textures/wolf.png");
+            textureFilename = "./../textures/wolf.png";
             break;
 
         case TREE:
-            image.loadFromFile("./../textures/tree.png");
+            textureFilename = "./../textures/tree.png";
             break;
 
         case CARROT:
-            image.loadFromFile("./../textures/carrot.png");
+            textureFilename = "./../textures/carrot.png";
             break;
 
         default:
-            image.loadFromFile("./../textures/question-mark.png");
+            textureFilename = "./../textures/question-mark.png";
             break;
     }
-    
-    image.flipVertically(); // sfml inverts the v axis... put the image in OpenGL convention: lower left corner is (0,0)
-    glcheck(glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA32F, image.getSize().x, image.getSize().y, 0, GL_RGBA, GL_UNSIGNED_BYTE, (const GLvoid*)image.getPixelsPtr()));
+    m_texture = AssetManager::getTexture(textureFilename, false, LINEAR_FILTERING);
 
-    //Release the texture
-    glBindTexture(GL_TEXTURE_2D, 0);
+    // The sprites have transparent borders, blended over the terrain and the other sprites
+    setRenderPass(TRANSPARENT_PASS);
 
     //Create buffers
     glGenBuffers(1, &m_pBuffer); //vertices
@@ -103,13 +86,13 @@ void BoidRenderable::do_draw()
         return;
     }
     //Location
-    int positionLocation = m_shaderProgram->getAttributeLocation("vPosition");
-    int colorLocation = m_shaderProgram->getAttributeLocation("vColor");
-    int normalLocation = m_shaderProgram->getAttributeLocation("vNormal");
-    int modelLocation = m_shaderProgram->getUniformLocation("modelMat");
-    int nitLocation = m_shaderProgram->getUniformLocation("NIT");
-    int textureLocation = m_shaderProgram->getAttributeLocation("vTexCoord");
-    int texSampleLoc = m_shaderProgram->getUniformLocation("texSampler");
+    int positionLocation = m_shaderProgram->getAttributeLocation(SHADER_VARIABLE("vPosition"));
+    int colorLocation = m_shaderProgram->getAttributeLocation(SHADER_VARIABLE("vColor"));
+    int normalLocation = m_shaderProgram->getAttributeLocation(SHADER_VARIABLE("vNormal"));
+    int modelLocation = m_shaderProgram->getUniformLocation(SHADER_VARIABLE("modelMat"));
+    int nitLocation = m_shaderProgram->getUniformLocation(SHADER_VARIABLE("NIT"));
+    int textureLocation = m_shaderProgram->getAttributeLocation(SHADER_VARIABLE("vTexCoord"));
+    int texSampleLoc = m_shaderProgram->getUniformLocation(SHADER_VARIABLE("texSampler"));
 
     //Send material uniform to GPU
     Material::sendToGPU(m_shaderProgram, m_material);
@@ -154,7 +137,7 @@ void BoidRenderable::do_draw()
     if(textureLocation != ShaderProgram::null_location)
     {
         glcheck(glActiveTexture(GL_TEXTURE0));
-        glcheck(glBindTexture(GL_TEXTURE_2D, m_texId));
+        glcheck(glBindTexture(GL_TEXTURE_2D, m_texture ? m_texture->getId() : 0));
         //Send "texSampler" to Textured Unit 0
         glcheck(glUniform1i(texSampleLoc, 0));
         glcheck(glEnableVertexAttribArray(textureLocation));
@@ -221,5 +204,19 @@ BoidRenderable::~BoidRenderable()
     glcheck(glDeleteBuffers(1, &m_cBuffer));
     glcheck(glDeleteBuffers(1, &m_tBuffer));
     glcheck(glDeleteBuffers(1, &m_nBuffer));
-    glcheck(glDeleteTextures(1, &m_texId));
+}
+
+unsigned int BoidRenderable::do_getTextureKey() const
+{
+    return m_texture->getId();
+}
+
+unsigned int BoidRenderable::do_getMeshKey() const
+{
+    return m_pBuffer;
+}
+
+glm::vec3 BoidRenderable::do_getSortPosition() const
+{
+    return glm::vec3(getModelMatrix() * glm::vec4(m_boid->getLocation(), 1.0f));
 }
@@ -5,6 +5,7 @@
 #include "../../include/boids2D/SightRenderable.hpp"
 #include "../../include/boids2D/StateRenderable.hpp"
 #include "../../include/Utils.hpp"
+#include "../../include/Profiler.hpp"
 
 #define NB_RABBIT_MIN 6
 #define NB_RABBIT_MAX 10
@@ -14,12 +15,71 @@
 #define NB_TREE_MAX 15
 #define NB_CARROT_MIN 8
 #define NB_CARROT_MAX 15
+/** Size of the cells of the grids of boids */
+#define CELL_SIZE 20.0f
+/** Number of rings of cells searched around the cell of a boid looking for a target */
+#define SEARCH_RINGS 1
+
+/**
+ * @brief     Search the closest boid of a type seen by a boid, ring of cells by ring of cells
+ *            from the cell of the boid, until no cell left can hold a closer boid
+ * @param[in] grid Grid of the boids looked for
+ * @param[in] b    The boid looking around
+ * @param[in] type Type of the boid looked for
+ * @param[in] i    Index of the line of the cell of the boid
+ * @param[in] j    Index of the column of the cell of the boid
+ * @return    The closest boid found, nullptr if there is none
+ */
+template<typename T>
+static T closestInGrid(const Matrix<T> & grid, const MovableBoid & b, const BoidType & type, const unsigned int & i, const unsigned int & j)
+{
+	const glm::vec3 & location = b.getLocation();
+	const float distViewMax = b.getParameters()->getDistViewMax();
+	float closestDistance2 = distViewMax * distViewMax;
+	T target = (T) nullptr;
+
+	for (int ring = 0; ring <= SEARCH_RINGS; ++ring) {
+		const int iMin = (int) i - ring;
+		const int iMax = (int) i + ring;
+		const int jMin = (int) j - ring;
+		const int jMax = (int) j + ring;
+		for (int iloop = std::max(iMin, 0); iloop <= std::min(iMax, (int) grid.getNumLine() - 1); ++iloop) {
+			// Inside the ring, only its first and last columns
+			const int jStep = (iloop == iMin || iloop == iMax) ? 1 : jMax - jMin;
+			for (int jloop = jMin; jloop <= jMax; jloop += jStep) {
+				if (jloop < 0 || jloop >= (int) grid.getNumCol()) {
+					continue;
+				}
+				for (const T & other : grid.at(iloop, jloop)) {
+					if (other->getBoidType() != type) {
+						continue;
+					}
+					const glm::vec3 diffPos = other->getLocation() - location;
+					const float distance2 = glm::dot(diffPos, diffPos);
+					if (distance2 < closestDistance2 && b.angleVision(*other) && (const Boid *) &*other != (const Boid *) &b) {
+						closestDistance2 = distance2;
+						target = other;
+					}
+				}
+			}
+		}
+
+		// The cells of the next rings are further than the border of this one
+		const float border = std::min(
+			std::min(location.x - iMin * CELL_SIZE, (iMax + 1) * CELL_SIZE - location.x),
+			std::min(location.y - jMin * CELL_SIZE, (jMax + 1) * CELL_SIZE - location.y));
+		if (target != (T) nullptr && closestDistance2 <= border * border) {
+			break;
+		}
+	}
+	return target;
+}
 
 BoidsManager::BoidsManager(MapGenerator& map, Viewer& viewer, ShaderProgramPtr& shader) 
 	: m_map(map), m_viewer(viewer), m_shader(shader), m_updateCoeff(0), m_updatePeriod(10),
-		m_countCarrot(0)
+		m_interpolation(1.0f), m_countCarrot(0)
 {
-	int gridSize = (int) (map.getMapParameters().getMapSize() / 20);
+	int gridSize = (int) (map.getMapParameters().getMapSize() / CELL_SIZE);
 	m_movableBoids = std::make_shared<Matrix<MovableBoidPtr> >(gridSize, gridSize);
 	m_rootedBoids = std::make_shared<Matrix<RootedBoidPtr> >(gridSize, gridSize);
 }
@@ -142,6 +202,7 @@ MapGenerator& BoidsManager::getMap() const
 
 void BoidsManager::removeDead()
 {
+	PROFILE_SCOPE("BoidsManager::removeDead");
 	std::list<MovableBoidPtr>::iterator itm;
 	for (unsigned int i = 0; i < m_movableBoids->getNumLine(); ++i) {
 		for (unsigned int j = 0; j < m_movableBoids->getNumCol(); ++j) {
@@ -199,11 +260,21 @@ bool BoidsManager::getNearestLake(const glm::vec2 & position, glm::vec2 & result
 	return m_map.getClosestLake(position.x, position.y, result.x, result.y);
 }
 
+SteeringSample BoidsManager::getSteering(const float& x, const float& y) const
+{
+	return m_map.getSteeringField().sample(x, y);
+}
+
+bool BoidsManager::getNearestLakeShore(const glm::vec2 & position, glm::vec2 & result, float & distance) const
+{
+	return m_map.getClosestLakeShore(position.x, position.y, result.x, result.y, distance);
+}
+
 void BoidsManager::coordToBox(const glm::vec3 & location, unsigned int & i, unsigned int & j) const
 {
 	///< @todo : Mistake ?
-	i = (unsigned int) floor(location.x / 20.0f);
-	j = (unsigned int) floor(location.y / 20.0f);
+	i = (unsigned int) floor(location.x / CELL_SIZE);
+	j = (unsigned int) floor(location.y / CELL_SIZE);
 }
 
 void BoidsManager::updateBoidInGrid(MovableBoidPtr mvB, const unsigned int & iprev, const unsigned int & jprev)
@@ -216,6 +287,64 @@ void BoidsManager::updateBoidInGrid(MovableBoidPtr mvB, const unsigned int & ipr
 	}
 }
 
+bool BoidsManager::isTypeAround(const unsigned int & i, const unsigned int & j, const BoidType & type) const
+{
+	if (type == UNKNOWN) {
+		return false;
+	}
+	const unsigned int iMax = std::min(i + 1, (unsigned int) m_movableBoids->getNumLine() - 1);
+	const unsigned int jMax = std::min(j + 1, (unsigned int) m_movableBoids->getNumCol() - 1);
+	for (unsigned int iloop = (i > 0 ? i - 1 : 0); iloop <= iMax; ++iloop) {
+		for (unsigned int jloop = (j > 0 ? j - 1 : 0); jloop <= jMax; ++jloop) {
+			for (const MovableBoidPtr & m : m_movableBoids->at(iloop, jloop)) {
+				if (m->getBoidType() == type && !m->isDead()) {
+					return true;
+				}
+			}
+		}
+	}
+	return false;
+}
+
+bool BoidsManager::hasNeighbours(const unsigned int & i, const unsigned int & j) const
+{
+	const unsigned int iMax = std::min(i + 1, (unsigned int) m_movableBoids->getNumLine() - 1);
+	const unsigned int jMax = std::min(j + 1, (unsigned int) m_movableBoids->getNumCol() - 1);
+	std::size_t count = 0;
+	for (unsigned int iloop = (i > 0 ? i - 1 : 0); iloop <= iMax; ++iloop) {
+		for (unsigned int jloop = (j > 0 ? j - 1 : 0); jloop <= jMax; ++jloop) {
+			count += m_movableBoids->at(iloop, jloop).size();
+		}
+	}
+	return count > 1;
+}
+
+MovableBoidPtr BoidsManager::closestMovable(const MovableBoid & b, const BoidType & type, const unsigned int & i, const unsigned int & j) const
+{
+	return closestInGrid(*m_movableBoids, b, type, i, j);
+}
+
+RootedBoidPtr BoidsManager::closestRooted(const MovableBoid & b, const BoidType & type, const unsigned int & i, const unsigned int & j) const
+{
+	return closestInGrid(*m_rootedBoids, b, type, i, j);
+}
+
+void BoidsManager::publishFocus()
+{
+	m_focus.back() = m_viewer.getCamera().getPosition();
+	m_focus.publish();
+}
+
+void BoidsManager::acquireFocus()
+{
+	m_focus.acquire();
+}
+
+const glm::vec3 & BoidsManager::getFocus() const
+{
+	return m_focus.front();
+}
+
 void BoidsManager::updateTick()
 {
 	m_updateCoeff++;
@@ -231,6 +360,68 @@ void BoidsManager::resetTick()
 	m_updateCoeff = 0;
 }
 
+void BoidsManager::publishSnapshot(const double & time)
+{
+	BoidsSnapshot & snapshot = m_snapshots.back();
+	snapshot.time = time;
+
+	snapshot.movableBoids.resize(m_movableBoidsVec.size());
+	for (unsigned int k = 0; k < m_movableBoidsVec.size(); ++k) {
+		const MovableBoid & m = *m_movableBoidsVec[k];
+		BoidSnapshot & s = snapshot.movableBoids[k];
+		s.location = m.getLocation();
+		s.previousLocation = m.getPreviousLocation();
+		s.angle = m.getAngle();
+		s.previousAngle = m.getPreviousAngle();
+		s.scale = m.getScale();
+		s.type = m.getBoidType();
+		s.state = m.getStateType();
+		s.dead = m.isDead();
+		s.display = m.toDisplay();
+	}
+
+	snapshot.rootedBoids.clear();
+	for (unsigned int i = 0; i < m_rootedBoids->getNumLine(); ++i) {
+		for (unsigned int j = 0; j < m_rootedBoids->getNumCol(); ++j) {
+			for (const RootedBoidPtr & r : m_rootedBoids->at(i,j)) {
+				BoidSnapshot s;
+				s.location = r->getLocation();
+				s.previousLocation = s.location;
+				s.angle = r->getAngle();
+				s.previousAngle = s.angle;
+				s.scale = r->getScale();
+				s.type = r->getBoidType();
+				s.state = WALK_STATE;
+				s.dead = false;
+				s.display = r->toDisplay();
+				snapshot.rootedBoids.push_back(s);
+			}
+		}
+	}
+
+	m_snapshots.publish();
+}
+
+bool BoidsManager::acquireSnapshot()
+{
+	return m_snapshots.acquire();
+}
+
+const BoidsSnapshot & BoidsManager::getSnapshot() const
+{
+	return m_snapshots.front();
+}
+
+void BoidsManager::setInterpolation(const float & alpha)
+{
+	m_interpolation = alpha;
+}
+
+const float & BoidsManager::getInterpolation() const
+{
+	return m_interpolation;
+}
+
 void BoidsManager::addDebugMovableBoid(MovableBoidPtr m)
 {
     SightRenderablePtr sight = std::make_shared<SightRenderable>(m_shader, m);
@@ -242,6 +433,7 @@ void BoidsManager::addDebugMovableBoid(MovableBoidPtr m)
 
 void BoidsManager::repopCarrot()
 {
+	PROFILE_SCOPE("BoidsManager::repopCarrot");
 	float mapSize = getMap().getMapParameters().getMapSize();
 	float x = random(0, mapSize);
 	float y = random(0, mapSize);
@@ -0,0 +1,19 @@
+#include "../../include/boids2D/BoidsSnapshot.hpp"
+
+#include <cmath>
+
+glm::vec3 BoidSnapshot::interpolatedLocation(const float & alpha) const
+{
+	return previousLocation + alpha * (location - previousLocation);
+}
+
+float BoidSnapshot::interpolatedAngle(const float & alpha) const
+{
+	float delta = fmod(angle - previousAngle, 2.0f * M_PI);
+	if (delta > M_PI) {
+		delta -= 2.0f * M_PI;
+	} else if (delta < -M_PI) {
+		delta += 2.0f * M_PI;
+	}
+	return previousAngle + alpha * delta;
+}
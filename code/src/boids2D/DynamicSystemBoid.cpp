@@ -1,4 +1,5 @@
 #include "../../include/boids2D/DynamicSystemBoid.hpp"
+#include "../../include/Profiler.hpp"
 
 #include <iostream>
 
@@ -24,6 +25,27 @@ void DynamicSystemBoid::setSolver(SolverBoidPtr solver)
     m_solver = solver;
 }
 
+void DynamicSystemBoid::publishFocus()
+{
+    m_boidsManager->publishFocus();
+}
+
+void DynamicSystemBoid::publishSnapshot(double time)
+{
+    m_boidsManager->publishSnapshot(time);
+}
+
+const BoidsSnapshot& DynamicSystemBoid::acquireSnapshot()
+{
+    m_boidsManager->acquireSnapshot();
+    return m_boidsManager->getSnapshot();
+}
+
+void DynamicSystemBoid::setInterpolation(float alpha)
+{
+    m_boidsManager->setInterpolation(alpha);
+}
+
 void DynamicSystemBoid::setBoidsManager(BoidsManagerPtr boidsManager) {
     m_boidsManager = boidsManager;
 }
@@ -36,8 +58,10 @@ void DynamicSystemBoid::setBoidsManager(BoidsManagerPtr boidsManager) {
  */ 
 void DynamicSystemBoid::computeSimulationStep()
 {
+    PROFILE_SCOPE("DynamicSystemBoid::computeSimulationStep");
     std::vector<MovableBoidPtr> mvB = m_boidsManager->getMovableBoids();
     const bool updateTick = m_boidsManager->isUpdateTick();
+    m_boidsManager->acquireFocus();
     // #pragma omp parallel for
     for (unsigned int i = 0; i < mvB.size(); ++i) {
         mvB[i]->computeAcceleration(*m_boidsManager, m_dt, updateTick);
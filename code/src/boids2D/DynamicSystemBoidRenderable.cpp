@@ -1,26 +1,155 @@
 #include "../../include/boids2D/DynamicSystemBoidRenderable.hpp"
+#include "../../include/Profiler.hpp"
+#include "../../include/Viewer.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
 
 DynamicSystemBoidRenderable::DynamicSystemBoidRenderable(DynamicSystemBoidPtr system) :
-    HierarchicalRenderable(nullptr), m_lastUpdateTime( 0 )
+    HierarchicalRenderable(nullptr), m_lastUpdateTime( 0 ), m_scaledTime( 0 ),
+    m_targetTime( 0 ), m_simulatedTime( 0 ), m_timeScale( 1 ), m_maxSubsteps( 8 ),
+    m_asynchronous( true ), m_published( false ), m_running( false )
 {
     m_system = system;
 }
 
+DynamicSystemBoidRenderable::~DynamicSystemBoidRenderable()
+{
+    stop();
+}
+
 void DynamicSystemBoidRenderable::do_draw()
 {}
 
 void DynamicSystemBoidRenderable::do_animate(float time )
 {
-    if( time - m_lastUpdateTime >= m_system->getDt() )
+    const float dt = m_system->getDt();
+    m_scaledTime += std::max( time - m_lastUpdateTime, 0.0f ) * m_timeScale;
+    m_lastUpdateTime = time;
+
+    // The boids placed before the first animation are displayed right away
+    if( !m_published )
+    {
+        m_system->publishSnapshot( m_simulatedTime );
+        m_published = true;
+    }
+
+    m_system->publishFocus();
+
+    if( m_asynchronous )
+    {
+        start();
+        {
+            std::lock_guard<std::mutex> lock( m_mutex );
+            m_targetTime = m_scaledTime;
+        }
+        m_wakeUp.notify_one();
+    }
+    else
+    {
+        m_targetTime = m_scaledTime;
+        simulate();
+    }
+
+    const BoidsSnapshot& snapshot = m_system->acquireSnapshot();
+    const float alpha = ( m_scaledTime - snapshot.time ) / dt;
+    m_system->setInterpolation( std::min( std::max( alpha, 0.0f ), 1.0f ) );
+}
+
+void DynamicSystemBoidRenderable::simulate()
+{
+    const double dt = m_system->getDt();
+    const double target = m_targetTime;
+    const unsigned int maxSubsteps = m_maxSubsteps;
+    Viewer* viewer = m_viewer;
+
+    unsigned int substeps = 0;
+    while( m_simulatedTime + dt <= target && substeps < maxSubsteps )
     {
-        //Dynamic system step
+        //Dynamic system step, timed for the frame time statistics of the viewer
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
         m_system->computeSimulationStep();
-        m_lastUpdateTime = time;
+        if( viewer )
+        {
+            viewer->getFPSCounter().addSimulationStep(
+                std::chrono::duration<double>( std::chrono::steady_clock::now() - start ).count() );
+        }
+        m_simulatedTime += dt;
+        ++substeps;
+    }
+
+    // Drop the time out of the budget instead of catching up on later rounds
+    if( m_simulatedTime + dt <= target )
+    {
+        m_simulatedTime = target - std::fmod( target - m_simulatedTime, dt );
+    }
+
+    if( substeps > 0 )
+    {
+        m_system->publishSnapshot( m_simulatedTime );
     }
+}
+
+void DynamicSystemBoidRenderable::run()
+{
+    Profiler::setThreadName( "boids simulation" );
+    const double dt = m_system->getDt();
+    std::unique_lock<std::mutex> lock( m_mutex );
+    while( m_running )
+    {
+        lock.unlock();
+        simulate();
+        lock.lock();
+
+        m_wakeUp.wait( lock, [this, dt]() {
+            return !m_running || m_targetTime >= m_simulatedTime + dt;
+        });
+    }
+}
+
+void DynamicSystemBoidRenderable::start()
+{
+    if( m_thread.joinable() )
+        return;
+
+    m_running = true;
+    m_thread = std::thread( &DynamicSystemBoidRenderable::run, this );
+}
+
+void DynamicSystemBoidRenderable::stop()
+{
+    if( !m_thread.joinable() )
+        return;
 
+    {
+        std::lock_guard<std::mutex> lock( m_mutex );
+        m_running = false;
+    }
+    m_wakeUp.notify_one();
+    m_thread.join();
 }
 
 void DynamicSystemBoidRenderable::setDynamicSystem(const DynamicSystemBoidPtr &system)
 {
+    stop();
     m_system = system;
+    m_published = false;
+}
+
+void DynamicSystemBoidRenderable::setTimeScale(float timeScale)
+{
+    m_timeScale = timeScale;
+}
+
+void DynamicSystemBoidRenderable::setMaxSubsteps(unsigned int maxSubsteps)
+{
+    m_maxSubsteps = maxSubsteps;
+}
+
+void DynamicSystemBoidRenderable::setAsynchronous(bool asynchronous)
+{
+    if( !asynchronous )
+        stop();
+    m_asynchronous = asynchronous;
 }
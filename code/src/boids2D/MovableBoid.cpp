@@ -1,9 +1,18 @@
+#include <algorithm>
 #include <iostream>
 #include <cmath>
 #include "../../include/Utils.hpp"
 #include "../../include/boids2D/StateType.hpp"
 #include "../../include/boids2D/MovableBoid.hpp"
 
+/**
+ * Maximal number of ticks between two full updates of a boid. It must not
+ * exceed the period of the update ticks, so that a boid skips at most one.
+ */
+#define MAX_UPDATE_PERIOD 8
+/** Distance to the camera adding a tick to the update period of a walking boid */
+#define LOD_DISTANCE 100.0f
+
 MovableBoid::MovableBoid(glm::vec3 location, glm::vec3 landmarkPosition, BoidType t, MovableParametersPtr parameters) 
 	: MovableBoid(location, landmarkPosition, glm::vec3(0,0,0), t, parameters)
 {
@@ -27,14 +36,22 @@ MovableBoid::MovableBoid(glm::vec3 location, glm::vec3 landmarkPosition, glm::ve
     BoidType t, MovableParametersPtr parameters, int amountFood)
 	: Boid(location, t, amountFood), m_velocity(velocity), 
 	m_acceleration(glm::vec3(0,0,0)), m_mass(mass),
+	m_previousLocation(location), m_previousAngle(0.0f),
 	m_parameters(parameters), m_movablePrey((MovableBoidPtr) nullptr),
 	m_rootedPrey((RootedBoidPtr) nullptr), m_hunter((MovableBoidPtr) nullptr),
 	m_leader((MovableBoidPtr) nullptr), m_soulMate((MovableBoidPtr) nullptr),
 	m_isDead(false), m_waterTarget(glm::vec3(0,0,2.0f)), m_landmarkPosition(landmarkPosition),
-	m_mateStatus(0.0f)
+	m_mateStatus(0.0f), m_updatePeriod(1), m_updateTicks(0), m_missedUpdateTick(false),
+	m_predatorAround(false)
 {
+	// The boid faces its velocity, from which its first step is interpolated
+	if (glm::length(velocity) >= FLT_EPSILON) {
+		setAngle(atan2(velocity.y, velocity.x));
+	}
+	m_previousAngle = getAngle();
+
     m_stateType = WALK_STATE;
-	m_currentState.reset(new WalkState());
+	m_currentState = &MovableState::get(WALK_STATE);
 
 	switch(t) {
 		case RABBIT:
@@ -83,6 +100,21 @@ void MovableBoid::resetVelocity()
 
 void MovableBoid::computeAcceleration (BoidsManager & boidsManager, const float & dt, const bool & updateTick)
 {
+	unsigned int i;
+	unsigned int j;
+	boidsManager.coordToBox(m_location, i, j);
+
+	// Between two updates, the boid goes on with its last acceleration
+	++m_updateTicks;
+	m_missedUpdateTick = m_missedUpdateTick || updateTick;
+	m_predatorAround = boidsManager.isTypeAround(i, j, m_predator);
+	if (m_updateTicks < m_updatePeriod && !m_predatorAround) {
+		return;
+	}
+
+	// The handlers only checking the vitals have nothing to do until a threshold is crossed
+	const bool needsChanged = m_parameters->popNeedsChanged();
+
 	if(isDead()) {
 		switchToState(DEAD_STATE, boidsManager);
 		bodyDecomposition();
@@ -109,16 +141,22 @@ void MovableBoid::computeAcceleration (BoidsManager & boidsManager, const float
 			lostStateHandler(boidsManager);
 			break;
 		case SLEEP_STATE:
-			sleepStateHandler(boidsManager);
+			if (needsChanged) {
+				sleepStateHandler(boidsManager);
+			}
 			break;
 		case FLEE_STATE:
-			fleeStateHandler(boidsManager);
+			if (needsChanged) {
+				fleeStateHandler(boidsManager);
+			}
 			break;
 		case FIND_WATER_STATE:
 			findWaterStateHandler(boidsManager);
 			break;
 		case DRINK_STATE:
-			drinkStateHandler(boidsManager);
+			if (needsChanged) {
+				drinkStateHandler(boidsManager);
+			}
 			break;
 		case MATE_STATE:
 			mateStateHandler(boidsManager);
@@ -129,16 +167,52 @@ void MovableBoid::computeAcceleration (BoidsManager & boidsManager, const float
 			std::cerr << "Unknown state" << std::endl;
 			break;
 	}
-	unsigned int i;
-	unsigned int j;
-	boidsManager.coordToBox(m_location, i, j);
-	m_acceleration = m_currentState->computeAcceleration(*this, boidsManager, dt, i, j, updateTick);
+	m_acceleration = m_currentState->computeAcceleration(*this, boidsManager, dt, i, j, m_missedUpdateTick);
+
+	m_updatePeriod = computeUpdatePeriod(boidsManager, i, j);
+	m_updateTicks = 0;
+	m_missedUpdateTick = false;
+}
+
+const unsigned int & MovableBoid::getUpdateTicks() const
+{
+	return m_updateTicks;
+}
+
+bool MovableBoid::isPredatorAround() const
+{
+	return m_predatorAround;
+}
+
+unsigned int MovableBoid::computeUpdatePeriod(const BoidsManager & boidsManager, const unsigned int & i, const unsigned int & j) const
+{
+	switch (m_stateType) {
+		case SLEEP_STATE:
+		case STAY_STATE:
+			// Resting boids do not move, their vitals mostly change on update ticks
+			return MAX_UPDATE_PERIOD;
+		case WALK_STATE:
+		case LOST_STATE:
+		{
+			unsigned int period = 1 + (unsigned int) (glm::distance(m_location, boidsManager.getFocus()) / LOD_DISTANCE);
+			// The neighbours steer the boid, it has to react to them sooner
+			if (boidsManager.hasNeighbours(i, j)) {
+				period = (period + 1) / 2;
+			}
+			return std::min(period, (unsigned int) MAX_UPDATE_PERIOD);
+		}
+		default:
+			// Hunting, fleeing, eating, drinking and mating boids interact at each tick
+			return 1;
+	}
 }
 
 // x(t + dt) = x(t) + v(t+dt) * dt
 const glm::vec3 MovableBoid::computeNextStep(const float & dt, const BoidsManagerPtr & boidsManager)
 {
 	glm::vec3 prevLocation = m_location;
+	m_previousLocation = m_location;
+	m_previousAngle = getAngle();
 	glm::vec3 nextVelocity = m_velocity + (dt / m_mass) * limitVec3(m_acceleration, getParameters()->getMaxForce());
 	if (m_stateType == FLEE_STATE || m_stateType == ATTACK_STATE) {
 		nextVelocity = limitVec3(nextVelocity, getParameters()->getMaxSpeedRun());
@@ -146,17 +220,32 @@ const glm::vec3 MovableBoid::computeNextStep(const float & dt, const BoidsManage
 		nextVelocity = limitVec3(nextVelocity, getParameters()->getMaxSpeedWalk());
 	}
   	float k = 0.15f;
-  	if(glm::length(m_velocity) < FLT_EPSILON) {
+  	const bool hasHeading = glm::length(m_velocity) >= FLT_EPSILON;
+  	if(!hasHeading) {
   		m_velocity = 0.015f * nextVelocity + (1.0f - 0.015f) * m_velocity;
   	} else {
   		m_velocity = k * nextVelocity + (1.0f - k) * m_velocity;
   	}
 	setAngle(atan2(m_velocity.y, m_velocity.x));
+	if (!hasHeading) {
+		// A boid without velocity, like a newborn, is displayed with its first heading instead of turning from 0
+		m_previousAngle = getAngle();
+	}
     m_location += dt * m_velocity;
     m_location.z = boidsManager->getHeight(m_location.x, m_location.y);
     return prevLocation;
 }
 
+const glm::vec3 & MovableBoid::getPreviousLocation() const
+{
+	return m_previousLocation;
+}
+
+const float & MovableBoid::getPreviousAngle() const
+{
+	return m_previousAngle;
+}
+
 bool MovableBoid::canSee(const Boid & other, const float & distView) const
 {
 	return (distVision(other, distView)) && (angleVision(other) && &other != this);
@@ -195,55 +284,23 @@ void MovableBoid::switchToState(const StateType & stateType, const BoidsManager
 {
 	switch(stateType) {
 		case WALK_STATE:
-			if(isLeader()) {
-				if(std::rand() % 5 == 0) {
-					m_currentState.reset(new LostState()); // The leader return to the landmark
-				} else {
-					m_currentState.reset(new WalkState());
-				}
+			if(isLeader() && std::rand() % 5 == 0) {
+				m_currentState = &MovableState::get(LOST_STATE); // The leader return to the landmark
 			} else {
-				m_currentState.reset(new WalkState());
+				m_currentState = &MovableState::get(WALK_STATE);
 			}
 			break;
-		case STAY_STATE:
-			m_currentState.reset(new StayState());
-			break;
-		case SLEEP_STATE:
-			m_currentState.reset(new SleepState());
-			break;
-		case FLEE_STATE:
-			m_currentState.reset(new FleeState());
-			break;
-		case FIND_FOOD_STATE:
-			m_currentState.reset(new FindFoodState());
-			break;
-		case ATTACK_STATE:
-			m_currentState.reset(new AttackState());
-			break;
-		case EAT_STATE:
-			m_currentState.reset(new EatState());
-			break;
 		case FIND_WATER_STATE:
 			updateWaterTarget(boidsManager);
-			m_currentState.reset(new FindWaterState());
-			break;
-		case DRINK_STATE:
-			m_currentState.reset(new DrinkState());
-			break;
-		case MATE_STATE:
-			m_currentState.reset(new MateState());
-			break;
-		case LOST_STATE:
-			m_currentState.reset(new LostState()); 
-			break;
-		case DEAD_STATE:
-			m_currentState.reset(new DeadState());
+			m_currentState = &MovableState::get(FIND_WATER_STATE);
 			break;
 		default:
-			std::cerr << "Unknown state : " << stateType << std::endl;
+			m_currentState = &MovableState::get(stateType);
 			break;
 	}
 	m_stateType = stateType;
+	// The new state checks the current needs at least once
+	m_parameters->raiseNeedsChanged();
 }
 
 void MovableBoid::walkStateHandler(const BoidsManager & boidsManager)
@@ -460,8 +517,8 @@ bool MovableBoid::closeToPrey() const
 
 bool MovableBoid::nextToWater(const BoidsManager & boidsManager) const
 {
-	glm::vec3 posAhead = getLocation() + cNormalize(getVelocity()) * m_parameters->getDistSeeAhead();
-	return boidsManager.getBiome(posAhead.x, posAhead.y) == Lake;
+	SteeringSample steering = boidsManager.getSteering(getLocation().x, getLocation().y);
+	return steering.lakeDistance <= m_parameters->getDistSeeAhead();
 }
 
 bool MovableBoid::hasSoulMate() const
@@ -564,7 +621,11 @@ void MovableBoid::updateWaterTarget(const BoidsManager & b)
 {
 	glm::vec2 posBoid(m_location.x, m_location.y);
 	glm::vec2 result(0,0);
-	b.getNearestLake(posBoid, result);
+	float distance;
+	// Heading to the shore, the centroid of the lake being in the water
+	if (!b.getNearestLakeShore(posBoid, result, distance)) {
+		b.getNearestLake(posBoid, result);
+	}
 	m_waterTarget = glm::vec3(result.x, result.y, 0.0f);
 }
 
@@ -1,7 +1,7 @@
 #include "../../include/boids2D/MovableBoidsRenderable.hpp"
 #include "../../include/gl_helper.hpp"
 #include "../../include/log.hpp"
-#include "../../include/Io.hpp"
+#include "../../include/AssetManager.hpp"
 #include "../../include/Utils.hpp"
 
 #include <glm/gtc/matrix_transform.hpp>
@@ -11,44 +11,27 @@
 MovableBoidsRenderable::MovableBoidsRenderable(ShaderProgramPtr shaderProgram, BoidsManagerPtr boidsManager, BoidType boidType,
     const std::string& mesh, const std::string & texture) 
     : HierarchicalRenderable(shaderProgram),
-    m_instanceVBO(0), m_VBO(0), m_texId(0),m_boidType(boidType), m_boidsManager(boidsManager)
+    m_instanceVBO(0), m_VBO(0), m_boidType(boidType), m_boidsManager(boidsManager)
 {
-    std::vector< glm::vec2 > texCoords;
-    std::vector< glm::vec3 > positions;
-    std::vector< glm::vec3 > normals;
-    std::vector< unsigned int > indices;
-
-    read_obj(mesh, positions, indices, normals, texCoords);
-
-    for(unsigned int i = 0; i<indices.size(); i++) {
-        m_vectorBuffer.push_back(positions[indices[i]]);
-        m_vectorBuffer.push_back(glm::vec3(0.0, 0.0, 0.0));
-        m_vectorBuffer.push_back(normals[indices[i]]);
-        m_texCoords.push_back(texCoords[indices[i]]);
+    MeshDataPtr meshData = AssetManager::getMesh(mesh);
+
+    if (meshData) {
+        const std::vector< unsigned int >& indices = meshData->indices;
+        m_vectorBuffer.reserve(3 * indices.size());
+        m_texCoords.reserve(indices.size());
+        for(unsigned int i = 0; i<indices.size(); i++) {
+            m_vectorBuffer.push_back(meshData->positions[indices[i]]);
+            m_vectorBuffer.push_back(glm::vec3(0.0, 0.0, 0.0));
+            m_vectorBuffer.push_back(meshData->normals[indices[i]]);
+            m_texCoords.push_back(meshData->texCoords[indices[i]]);
+        }
     }
 
     // number of element in the m_vectorBuffer (positions, colors, normals, ...)
     m_nbElement = 3;
 
-    //Create texture
-    glcheck(glGenTextures(1, &m_texId));
-
-    //Bind the texture
-    glcheck(glBindTexture(GL_TEXTURE_2D, m_texId));
-
-    //Textured options
-    glcheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST));
-    glcheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST));
-    glcheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE));
-    glcheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE));
-
-    sf::Image image;
-    image.loadFromFile(texture);
-    image.flipVertically(); // sfml inverts the v axis... put the image in OpenGL convention: lower left corner is (0,0)
-    glcheck(glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA32F, image.getSize().x, image.getSize().y, 0, GL_RGBA, GL_UNSIGNED_BYTE, (const GLvoid*)image.getPixelsPtr()));
-
-    //Release the texture
-    glcheck(glBindTexture(GL_TEXTURE_2D, 0));
+    // The texture is shared with the other renderables using the same file
+    m_texture = AssetManager::getTexture(texture, false, NEAREST_FILTERING);
 
     for(MovableBoidPtr m : m_boidsManager->getMovableBoids()){
         m_VAOs.push_back(0); 
@@ -81,13 +64,13 @@ void MovableBoidsRenderable::do_draw()
     glcheck(glBindBuffer(GL_ARRAY_BUFFER, m_instanceVBO));
     glcheck(glBufferData(GL_ARRAY_BUFFER, m_modelMatrix.size() * sizeof(glm::mat4), m_modelMatrix.data(), GL_DYNAMIC_DRAW));
 
-    int positionLocation = m_shaderProgram->getAttributeLocation("position");
-    int colorLocation = m_shaderProgram->getAttributeLocation("color");
-    int normalLocation = m_shaderProgram->getAttributeLocation("normal");
-    int modelLocation = m_shaderProgram->getAttributeLocation("modelMat");
-    int nitLocation = m_shaderProgram->getUniformLocation("NIT");
-    int texcoordLocation = m_shaderProgram->getAttributeLocation("texCoord");
-    int texsamplerLocation = m_shaderProgram->getUniformLocation("texSampler");
+    int positionLocation = m_shaderProgram->getAttributeLocation(SHADER_VARIABLE("position"));
+    int colorLocation = m_shaderProgram->getAttributeLocation(SHADER_VARIABLE("color"));
+    int normalLocation = m_shaderProgram->getAttributeLocation(SHADER_VARIABLE("normal"));
+    int modelLocation = m_shaderProgram->getAttributeLocation(SHADER_VARIABLE("modelMat"));
+    int nitLocation = m_shaderProgram->getUniformLocation(SHADER_VARIABLE("NIT"));
+    int texcoordLocation = m_shaderProgram->getAttributeLocation(SHADER_VARIABLE("texCoord"));
+    int texsamplerLocation = m_shaderProgram->getUniformLocation(SHADER_VARIABLE("texSampler"));
 
     //Send material uniform to GPU
     Material::sendToGPU(m_shaderProgram, m_material);
@@ -141,7 +124,7 @@ void MovableBoidsRenderable::do_draw()
     if(texcoordLocation != ShaderProgram::null_location)
     {
         glcheck(glActiveTexture(GL_TEXTURE0));
-        glcheck(glBindTexture(GL_TEXTURE_2D, m_texId));
+        glcheck(glBindTexture(GL_TEXTURE_2D, m_texture ? m_texture->getId() : 0));
         //Send "texSampler" to Textured Unit 0
         glcheck(glUniform1i(texsamplerLocation, 0));
         glcheck(glEnableVertexAttribArray(texcoordLocation));
@@ -181,18 +164,19 @@ void MovableBoidsRenderable::do_animate(float time) {}
 void MovableBoidsRenderable::compute_modelMatrix()
 {
     m_modelMatrix.clear();
-    std::vector<MovableBoidPtr> mvB = m_boidsManager->getMovableBoids();
+    const float alpha = m_boidsManager->getInterpolation();
 
-    for (MovableBoidPtr m : mvB) {
-        if(m->getBoidType() == m_boidType && m->toDisplay()) {
+    for (const BoidSnapshot & m : m_boidsManager->getSnapshot().movableBoids) {
+        if(m.type == m_boidType && m.display) {
             glm::mat4 transformation(1.0);
             glm::mat4 model = getModelMatrix();
             
-            float cz = cos(m->getAngle() - M_PI / 2.0);
-            float sz = sin(m->getAngle() - M_PI / 2.0);
+            const float angle = m.interpolatedAngle(alpha);
+            float cz = cos(angle - M_PI / 2.0);
+            float sz = sin(angle - M_PI / 2.0);
             float cy;
             float sy;
-            if(m->isDead()) {
+            if(m.dead) {
                 cy = cos(M_PI / 2.0);
                 sy = sin(M_PI / 2.0);  
             } else {
@@ -203,14 +187,14 @@ void MovableBoidsRenderable::compute_modelMatrix()
             float cx = cos(- M_PI / 2.0);
             float sx = sin(- M_PI / 2.0);
 
-            float scale = m->getScale();
-            if(m->getBoidType() == RABBIT){
+            float scale = m.scale;
+            if(m.type == RABBIT){
                 scale /= 8.0;
-            } else if(m->getBoidType() == WOLF) {
+            } else if(m.type == WOLF) {
                 scale *= 2.0;
             }
              
-            glm::vec3 position = m->getLocation();
+            glm::vec3 position = m.interpolatedLocation(alpha);
             
             transformation[0][0] = scale * cz * cy;
             transformation[0][1] = scale * sz * cy;
@@ -242,10 +226,19 @@ MovableBoidsRenderable::~MovableBoidsRenderable()
     }
     glcheck(glDeleteBuffers(1, &m_VBO));
     glcheck(glDeleteBuffers(1, &m_tBuffer));
-    glcheck(glDeleteBuffers(1, &m_texId));
 }
 
 void MovableBoidsRenderable::setMaterial(const MaterialPtr& material)
 {
     m_material = material;
 }
+
+unsigned int MovableBoidsRenderable::do_getTextureKey() const
+{
+    return m_texture->getId();
+}
+
+unsigned int MovableBoidsRenderable::do_getMeshKey() const
+{
+    return m_VBO;
+}
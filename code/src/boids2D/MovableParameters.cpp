@@ -3,10 +3,96 @@
 #include <string>
 #include <fstream>
 #include <streambuf>
+#include <map>
+#include <mutex>
 #include "../../include/rapidjson/document.h"
 #include "../../include/Utils.hpp"
 #include "../../include/boids2D/MovableParameters.hpp"
 
+/**
+ * @brief     Read and parse a JSON file
+ * @param[in] filename Name of the file
+ * @param[out] d Document to fill
+ */
+static void parseFile(const std::string & filename, rapidjson::Document & d)
+{
+	std::ifstream t(filename);
+	std::string str;
+
+	t.seekg(0, std::ios::end);   
+	str.reserve(t.tellg());
+	t.seekg(0, std::ios::beg);
+
+	str.assign((std::istreambuf_iterator<char>(t)),
+	            std::istreambuf_iterator<char>());	
+
+	d.Parse(str.c_str());
+}
+
+/**
+ * @brief  Get the boundaries and coefficients of the vitals, common to every species.
+ *         VariableParameters.json is parsed at the first call only.
+ * @return Parameters of a species whose motion values are zero
+ */
+static const SpeciesParameters & variableParameters()
+{
+	static const SpeciesParameters parameters = []()
+	{
+		rapidjson::Document d;
+		parseFile("../boidData/VariableParameters.json", d);
+
+		SpeciesParameters p = SpeciesParameters();
+
+		p.lowStaminaValue = d["Boundaries"]["Stamina"]["low"].GetDouble();
+		p.highStaminaValue = d["Boundaries"]["Stamina"]["high"].GetDouble();
+
+		p.lowHungerValue = d["Boundaries"]["Hunger"]["low"].GetDouble();
+		p.highHungerValue = d["Boundaries"]["Hunger"]["high"].GetDouble();
+
+		p.lowThirstValue = d["Boundaries"]["Thirst"]["low"].GetDouble();
+		p.highThirstValue = d["Boundaries"]["Thirst"]["high"].GetDouble();
+
+		p.lowDangerValue = d["Boundaries"]["Danger"]["low"].GetDouble();
+		p.highDangerValue = d["Boundaries"]["Danger"]["high"].GetDouble();
+
+		p.hungerIncCoeff = d["Coefficient"]["Global state"]["Hunger"].GetDouble();
+		p.hungerDecCoeffWalk = d["Coefficient"]["WalkState"]["Hunger"].GetDouble();
+		p.hungerDecCoeffRun = d["Coefficient"]["RunState"]["Hunger"].GetDouble();
+
+		p.staminaIncCoeff = d["Coefficient"]["Global state"]["Stamina"].GetDouble();
+		p.staminaDecCoeffWalk = d["Coefficient"]["WalkState"]["Stamina"].GetDouble();
+		p.staminaDecCoeffRun = d["Coefficient"]["RunState"]["Stamina"].GetDouble();
+
+		p.thirstIncCoeff = d["Coefficient"]["Global state"]["Thirst"].GetDouble();
+		p.thirstDecCoeffWalk = d["Coefficient"]["WalkState"]["Thirst"].GetDouble();
+		p.thirstDecCoeffRun = d["Coefficient"]["RunState"]["Thirst"].GetDouble();
+
+		p.affinityIncCoeff = d["Coefficient"]["Global state"]["AffinityIncrease"].GetDouble();
+		p.affinityDecCoeff = d["Coefficient"]["Global state"]["AffinityDecrease"].GetDouble();
+
+		p.dangerIncCoeff = d["Coefficient"]["Global state"]["DangerIncrease"].GetDouble();
+		p.dangerDecCoeff = d["Coefficient"]["Global state"]["DangerDecrease"].GetDouble();
+
+		return p;
+	}();
+	return parameters;
+}
+
+/**
+ * @brief  Get the initial vitals of a new boid
+ * @return Random stamina, hunger and thirst, no danger nor affinity
+ */
+static BoidVitals initialVitals()
+{
+	BoidVitals vitals;
+	vitals.stamina = random(55,99);
+	vitals.hunger = random(55,99);
+	vitals.thirst = random(55,99);
+	vitals.danger = 0.0f;
+	vitals.affinity = 0.0f;
+	return vitals;
+}
+
 MovableParameters::MovableParameters()
 	: MovableParameters(3.5f, 7.0f, 2.0f, 3*M_PI/4, 2.0f, 4.0f, 5.0f, 1.0f, 1.5f, 0.8f, 20.0f)
 {
@@ -29,82 +115,33 @@ MovableParameters::MovableParameters(float maxSpeedWalk, float maxSpeedRun, floa
 	float angleView, float distSeparate, float distCohesion, float distViewMax,
 	float distToLeader, float distSeeAhead, float distAttack, float distMaxToLeader, float distStartSlowingDown, 
 	float rCircleWander, float distToCircle) :
-	m_maxSpeedWalk(maxSpeedWalk), m_maxSpeedRun(maxSpeedRun), m_maxForce(maxForce), m_angleView(angleView),
-	m_distSeparate(distSeparate), m_distCohesion(distCohesion),
-	m_distViewMax(distViewMax), m_distToLeader(distToLeader),
-	m_distStartSlowingDown(distStartSlowingDown), m_distSeeAhead(distSeeAhead), m_distAttack(distAttack),
-	m_distMaxToLeader(distMaxToLeader), m_rCircleWander(rCircleWander), m_distToCircle(distToCircle), 
-	m_danger(0.0f), m_affinity(0.0f), m_stamina(random(55,99)), m_hunger(random(55,99)), m_thirst(random(55,99))
+	m_vitals(initialVitals()), m_needs(0), m_needsChanged(true)
 {
-	rapidjson::Document d;
-
-	std::ifstream t("../boidData/VariableParameters.json");
-	std::string str;
+	std::shared_ptr<SpeciesParameters> species = std::make_shared<SpeciesParameters>(variableParameters());
 
-	t.seekg(0, std::ios::end);   
-	str.reserve(t.tellg());
-	t.seekg(0, std::ios::beg);
-
-	str.assign((std::istreambuf_iterator<char>(t)),
-	            std::istreambuf_iterator<char>());	
+	species->maxSpeedWalk = maxSpeedWalk;
+	species->maxSpeedRun = maxSpeedRun;
+	species->maxForce = maxForce;
+	species->angleView = angleView;
+	species->distSeparate = distSeparate;
+	species->distCohesion = distCohesion;
+	species->distViewMax = distViewMax;
+	species->distToLeader = distToLeader;
+	species->distStartSlowingDown = distStartSlowingDown;
+	species->distSeeAhead = distSeeAhead;
+	species->distAttack = distAttack;
+	species->distMaxToLeader = distMaxToLeader;
+	species->rCircleWander = rCircleWander;
+	species->distToCircle = distToCircle;
 
-	d.Parse(str.c_str());
-
-	m_lowStaminaValue = d["Boundaries"]["Stamina"]["low"].GetDouble();
-	m_highStaminaValue = d["Boundaries"]["Stamina"]["high"].GetDouble();
-
-	m_lowHungerValue = d["Boundaries"]["Hunger"]["low"].GetDouble();
-	m_highHungerValue = d["Boundaries"]["Hunger"]["high"].GetDouble();
-
-	m_lowThirstValue = d["Boundaries"]["Thirst"]["low"].GetDouble();
-	m_highThirstValue = d["Boundaries"]["Thirst"]["high"].GetDouble();
-
-	m_lowDangerValue = d["Boundaries"]["Danger"]["low"].GetDouble();
-	m_highDangerValue = d["Boundaries"]["Danger"]["high"].GetDouble();
-
-	m_hungerIncCoeff = d["Coefficient"]["Global state"]["Hunger"].GetDouble();
-	m_hungerDecCoeffWalk = d["Coefficient"]["WalkState"]["Hunger"].GetDouble();
-	m_hungerDecCoeffRun = d["Coefficient"]["RunState"]["Hunger"].GetDouble();
-
-	m_staminaIncCoeff = d["Coefficient"]["Global state"]["Stamina"].GetDouble();
-	m_staminaDecCoeffWalk = d["Coefficient"]["WalkState"]["Stamina"].GetDouble();
-	m_staminaDecCoeffRun = d["Coefficient"]["RunState"]["Stamina"].GetDouble();
-
-	m_thirstIncCoeff = d["Coefficient"]["Global state"]["Thirst"].GetDouble();
-	m_thirstDecCoeffWalk = d["Coefficient"]["WalkState"]["Thirst"].GetDouble();
-	m_thirstDecCoeffRun = d["Coefficient"]["RunState"]["Thirst"].GetDouble();
-
-	m_affinityIncCoeff = d["Coefficient"]["Global state"]["AffinityIncrease"].GetDouble();
-	m_affinityDecCoeff = d["Coefficient"]["Global state"]["AffinityDecrease"].GetDouble();
-
-	m_dangerIncCoeff = d["Coefficient"]["Global state"]["DangerIncrease"].GetDouble();
-	m_dangerDecCoeff = d["Coefficient"]["Global state"]["DangerDecrease"].GetDouble();
+	m_species = species;
+	updateNeeds();
 }
 
 MovableParameters::MovableParameters( const std::string & filename )
+	: m_species(loadSpecies(filename)), m_vitals(initialVitals()), m_needs(0), m_needsChanged(true)
 {
-	rapidjson::Document d;
-
-	std::ifstream t(filename);
-	std::string str;
-
-	t.seekg(0, std::ios::end);   
-	str.reserve(t.tellg());
-	t.seekg(0, std::ios::beg);
-
-	str.assign((std::istreambuf_iterator<char>(t)),
-	            std::istreambuf_iterator<char>());	
-
-	d.Parse(str.c_str());
-
-	*this = MovableParameters(d["maxSpeedWalk"].GetDouble(),
-		d["maxSpeedRun"].GetDouble(),
-		d["maxForce"].GetDouble(), d["angleView"].GetDouble(),
-		d["distSeparate"].GetDouble(), d["distCohesion"].GetDouble(),
-		d["distViewMax"].GetDouble(), d["distToLeader"].GetDouble(),
-		d["distSeeAhead"].GetDouble(), d["distAttack"].GetDouble(),
-		d["distMaxToLeader"].GetDouble(), d["distStartSlowingDown"].GetDouble(),
-		d["rCircleWander"].GetDouble(), d["distToCircle"].GetDouble());
+	updateNeeds();
 }
 
 MovableParameters::MovableParameters(const BoidType & type)
@@ -118,222 +155,290 @@ MovableParameters::MovableParameters(const BoidType & type)
 			break;
 		default:
 			std::cerr << "Unknown animal" << std::endl;
+			*this = MovableParameters();
 			break;
 	}
 }
 
+SpeciesParametersPtr MovableParameters::loadSpecies(const std::string & filename)
+{
+	static std::map<std::string, SpeciesParametersPtr> cache;
+	static std::mutex cacheMutex;
+
+	std::lock_guard<std::mutex> lock(cacheMutex);
+	SpeciesParametersPtr & species = cache[filename];
+	if (!species) {
+		rapidjson::Document d;
+		parseFile(filename, d);
+
+		species = MovableParameters(d["maxSpeedWalk"].GetDouble(),
+			d["maxSpeedRun"].GetDouble(),
+			d["maxForce"].GetDouble(), d["angleView"].GetDouble(),
+			d["distSeparate"].GetDouble(), d["distCohesion"].GetDouble(),
+			d["distViewMax"].GetDouble(), d["distToLeader"].GetDouble(),
+			d["distSeeAhead"].GetDouble(), d["distAttack"].GetDouble(),
+			d["distMaxToLeader"].GetDouble(), d["distStartSlowingDown"].GetDouble(),
+			d["rCircleWander"].GetDouble(), d["distToCircle"].GetDouble()).m_species;
+	}
+	return species;
+}
+
 float MovableParameters::getStamina() const
 {
-	return m_stamina;
+	return m_vitals.stamina;
 }
 
 void MovableParameters::staminaIncrease()
 {
-	m_stamina = fmin(m_stamina + m_staminaIncCoeff, 100.0f);
+	m_vitals.stamina = fmin(m_vitals.stamina + m_species->staminaIncCoeff, 100.0f);
+	updateNeeds();
 }
 
 void MovableParameters::staminaDecreaseWalk()
 {
-	m_stamina = fmax(m_stamina - m_staminaDecCoeffWalk, 0.0f);
+	m_vitals.stamina = fmax(m_vitals.stamina - m_species->staminaDecCoeffWalk, 0.0f);
+	updateNeeds();
 }
 
 void MovableParameters::staminaDecreaseRun()
 {
-	m_stamina = fmax(m_stamina - m_staminaDecCoeffRun, 0.0f);
+	m_vitals.stamina = fmax(m_vitals.stamina - m_species->staminaDecCoeffRun, 0.0f);
+	updateNeeds();
 }
 
 float MovableParameters::getHunger() const
 {
-	return m_hunger;
+	return m_vitals.hunger;
 }
 
 void MovableParameters::hungerIncrease()
 {
-	m_hunger = fmin(m_hunger + m_hungerIncCoeff, 100.0f);
+	m_vitals.hunger = fmin(m_vitals.hunger + m_species->hungerIncCoeff, 100.0f);
+	updateNeeds();
 }
 
 void MovableParameters::hungerDecreaseWalk()
 {
-	m_hunger = fmax(m_hunger - m_hungerDecCoeffWalk, 0.0f);
+	m_vitals.hunger = fmax(m_vitals.hunger - m_species->hungerDecCoeffWalk, 0.0f);
+	updateNeeds();
 }
 
 void MovableParameters::hungerDecreaseRun()
 {
-	m_hunger = fmax(m_hunger - m_hungerDecCoeffRun, 0.0f);
+	m_vitals.hunger = fmax(m_vitals.hunger - m_species->hungerDecCoeffRun, 0.0f);
+	updateNeeds();
 }
 
 float MovableParameters::getThirst() const
 {
-	return m_thirst;
+	return m_vitals.thirst;
 }
 
 void MovableParameters::thirstIncrease()
 {
-	m_thirst = fmin(m_thirst + m_thirstIncCoeff, 100.0f);
+	m_vitals.thirst = fmin(m_vitals.thirst + m_species->thirstIncCoeff, 100.0f);
+	updateNeeds();
 }
 
 void MovableParameters::thirstDecreaseWalk()
 {
-	m_thirst = fmax(m_thirst - m_thirstDecCoeffWalk, 0.0f);
+	m_vitals.thirst = fmax(m_vitals.thirst - m_species->thirstDecCoeffWalk, 0.0f);
+	updateNeeds();
 }
 
 void MovableParameters::thirstDecreaseRun()
 {
-	m_thirst = fmax(m_thirst - m_thirstDecCoeffRun, 0.0f);
+	m_vitals.thirst = fmax(m_vitals.thirst - m_species->thirstDecCoeffRun, 0.0f);
+	updateNeeds();
 }
 
 float MovableParameters::getDanger() const
 {
-	return m_danger;
+	return m_vitals.danger;
 }
 
 void MovableParameters::dangerIncrease()
 {
-	m_danger = fmin(m_danger + m_dangerIncCoeff, 100.0f);
+	m_vitals.danger = fmin(m_vitals.danger + m_species->dangerIncCoeff, 100.0f);
+	updateNeeds();
 }
 
 void MovableParameters::dangerDecrease()
 {
-	m_danger = fmax(m_danger - m_dangerDecCoeff, 0.0f);
+	m_vitals.danger = fmax(m_vitals.danger - m_species->dangerDecCoeff, 0.0f);
+	updateNeeds();
 }
 
 float MovableParameters::getAffinity() const
 {
-	return m_affinity;
+	return m_vitals.affinity;
 }
 
 void MovableParameters::affinityIncrease()
 {
-	m_affinity = fmin(m_affinity + m_affinityIncCoeff, 100.0f);
+	m_vitals.affinity = fmin(m_vitals.affinity + m_species->affinityIncCoeff, 100.0f);
+	updateNeeds();
 }
 
 void MovableParameters::affinityDecrease()
 {
-	m_affinity = fmax(m_affinity - m_affinityDecCoeff, 0.0f);
+	m_vitals.affinity = fmax(m_vitals.affinity - m_species->affinityDecCoeff, 0.0f);
+	updateNeeds();
 }
 
 bool MovableParameters::isTired() const
 {
-	return m_stamina <= m_lowStaminaValue;
+	return m_vitals.stamina <= m_species->lowStaminaValue;
 }
 
 bool MovableParameters::isHighStamina() const
 {
-	return m_stamina >= m_highStaminaValue;
+	return m_vitals.stamina >= m_species->highStaminaValue;
 }
 
 bool MovableParameters::isHungry() const
 {
-	return m_hunger <= m_lowHungerValue;
+	return m_vitals.hunger <= m_species->lowHungerValue;
 }
 
 bool MovableParameters::isStarving() const
 {
-	return m_hunger <= (m_lowHungerValue / 2);
+	return m_vitals.hunger <= (m_species->lowHungerValue / 2);
 }
 
 bool MovableParameters::isNotHungry() const
 {
-	return m_hunger >= m_highHungerValue;
+	return m_vitals.hunger >= m_species->highHungerValue;
 }
 
 float MovableParameters::getMaxSpeedWalk() const
 {
-	return m_maxSpeedWalk;
+	return m_species->maxSpeedWalk;
 }
 
 float MovableParameters::getMaxSpeedRun() const
 {
-	return m_maxSpeedRun;
+	return m_species->maxSpeedRun;
 }
 
 float MovableParameters::getMaxForce() const
 {
-	return m_maxForce;
+	return m_species->maxForce;
 }
 
 float MovableParameters::getRadiusCircleWander() const
 {
-	return m_rCircleWander;
+	return m_species->rCircleWander;
 }
 
 float MovableParameters::getDistToCircleWander() const
 {
-	return m_distToCircle;
+	return m_species->distToCircle;
 }
 
 float MovableParameters::getDistStartSlowingDown() const
 {
-	return m_distStartSlowingDown;
+	return m_species->distStartSlowingDown;
 }
 
 float MovableParameters::getDistSeparate() const
 {
-	return m_distSeparate;
+	return m_species->distSeparate;
 }
 
 float MovableParameters::getDistViewCohesion() const
 {
-	return m_distCohesion;
+	return m_species->distCohesion;
 }
 
 float MovableParameters::getAngleView() const
 {
-	return m_angleView;
+	return m_species->angleView;
 }
 
 float MovableParameters::getDistViewMax() const
 {
-	return m_distViewMax;
+	return m_species->distViewMax;
 }
 
 bool MovableParameters::isInDanger() const
 {
-	return m_danger >= m_highDangerValue;	
+	return m_vitals.danger >= m_species->highDangerValue;	
 }
 
 bool MovableParameters::isThirsty() const
 {
-	return m_thirst <= m_lowThirstValue;
+	return m_vitals.thirst <= m_species->lowThirstValue;
 }
 
 bool MovableParameters::isNotThirsty() const
 {
-	return m_thirst >= m_highThirstValue;	
+	return m_vitals.thirst >= m_species->highThirstValue;	
 }
 
 bool MovableParameters::isNotTired() const
 {
-	return m_stamina >= m_highStaminaValue;	
+	return m_vitals.stamina >= m_species->highStaminaValue;	
 }
 
 bool MovableParameters::isNotInDanger() const
 {
-	return m_danger <= m_lowDangerValue;	
+	return m_vitals.danger <= m_species->lowDangerValue;	
 }
 
 float MovableParameters::getDistToLeader() const
 {
-	return m_distToLeader;
+	return m_species->distToLeader;
 }
 
 float MovableParameters::getDistSeeAhead() const
 {
-	return m_distSeeAhead;
+	return m_species->distSeeAhead;
 }
 
 float MovableParameters::getDistAttack() const
 {
-	return m_distAttack;
+	return m_species->distAttack;
 }
 
 bool MovableParameters::isHighAffinity() const
 {
-	return m_affinity == 100.0f;
+	return m_vitals.affinity == 100.0f;
 }
 
 void MovableParameters::resetAffinity()
 {
-	m_affinity = 0.0f;
+	m_vitals.affinity = 0.0f;
+	updateNeeds();
 }
 
+bool MovableParameters::popNeedsChanged()
+{
+	const bool needsChanged = m_needsChanged;
+	m_needsChanged = false;
+	return needsChanged;
+}
+
+void MovableParameters::raiseNeedsChanged()
+{
+	m_needsChanged = true;
+}
+
+void MovableParameters::updateNeeds()
+{
+	const unsigned short needs = isTired()
+		| isHighStamina() << 1
+		| isNotTired() << 2
+		| isHungry() << 3
+		| isStarving() << 4
+		| isNotHungry() << 5
+		| isThirsty() << 6
+		| isNotThirsty() << 7
+		| isInDanger() << 8
+		| isNotInDanger() << 9
+		| isHighAffinity() << 10;
+	if (needs != m_needs) {
+		m_needs = needs;
+		m_needsChanged = true;
+	}
+}
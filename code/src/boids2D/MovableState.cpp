@@ -3,32 +3,31 @@
 #include "../../include/Utils.hpp"
 #include <iostream>
 
-MovableBoidPtr closestMovable(const MovableBoid & b, const BoidType & type, const std::list<MovableBoidPtr> & mvB) {
-	float tmpDistance = FLT_MAX;
-	MovableBoidPtr target = (MovableBoidPtr) nullptr;
-
-	for (MovableBoidPtr m : mvB) {
-		if (b.canSee(*m, b.getParameters()->getDistViewMax()) && b.distVision(*m, tmpDistance) && m->getBoidType() == type) { 
-			// TODO : optimization possible		
-			tmpDistance = glm::distance(m->getLocation(), b.getLocation());
-			target = m;
-		}
-	}
-	return target;
-}
-
-RootedBoidPtr closestRooted(const MovableBoid & b, const BoidType & type, const std::list<RootedBoidPtr> & rtB) {
-	float tmpDistance = FLT_MAX;
-	RootedBoidPtr target = (RootedBoidPtr) nullptr;
-
-	for (RootedBoidPtr r : rtB) {
-		if (b.canSee(*r, b.getParameters()->getDistViewMax()) && b.distVision(*r, tmpDistance) && r->getBoidType() == type) { 
-			// TODO : optimization possible		
-			tmpDistance = glm::distance(r->getLocation(), b.getLocation());
-			target = r;
-		}
-	}
-	return target;
+const MovableState & MovableState::get(const StateType & stateType)
+{
+	// Indexed by StateType
+	static const WalkState walkState = WalkState();
+	static const StayState stayState = StayState();
+	static const SleepState sleepState = SleepState();
+	static const FleeState fleeState = FleeState();
+	static const FindFoodState findFoodState = FindFoodState();
+	static const AttackState attackState = AttackState();
+	static const EatState eatState = EatState();
+	static const LostState lostState = LostState();
+	static const FindWaterState findWaterState = FindWaterState();
+	static const DrinkState drinkState = DrinkState();
+	static const MateState mateState = MateState();
+	static const DeadState deadState = DeadState();
+	static const MovableState * const states[] = {
+		&walkState, &stayState, &sleepState, &fleeState, &findFoodState, &attackState,
+		&eatState, &lostState, &findWaterState, &drinkState, &mateState, &deadState
+	};
+
+	if (stateType < 0 || stateType > DEAD_STATE) {
+		std::cerr << "Unknown state : " << stateType << std::endl;
+		return walkState;
+	}
+	return *states[stateType];
 }
 
 glm::vec3 MovableState::computeAcceleration(MovableBoid& b, const BoidsManager & boidsManager, const float & dt, const int & i, const int & j, const bool & updateTick) const
@@ -121,47 +120,24 @@ glm::vec3 MovableState::stayWithinWalls(const MovableBoid& b) const
     return steer;
 }
 
-glm::vec3 MovableState::stayOnIsland(const MovableBoid & b, const BoidsManager & boidsManager) const
+glm::vec3 MovableState::stayOnIsland(const MovableBoid & b, const SteeringSample & steering) const
 {
-	glm::vec3 posAheadMax = b.getLocation() + cNormalize(b.getVelocity()) * b.getParameters()->getDistViewMax();
-	glm::vec3 posAhead = b.getLocation() + cNormalize(b.getVelocity()) * b.getParameters()->getDistSeeAhead();
-
-	if(boidsManager.getBiome(posAheadMax.x, posAheadMax.y) == Sea 
-		|| boidsManager.getBiome(b.getLocation().x, b.getLocation().y) == Sea) {
-		
-		float mapSize = boidsManager.getMap().getMapParameters().getMapSize();
-		glm::vec3 islandCenter(mapSize/2.0f, mapSize/2.0f, 0.0);
-
-		return cNormalize(islandCenter - b.getLocation()) * b.getParameters()->getMaxForce();
-	} else if (b.getStateType() != FIND_WATER_STATE && 
-		(boidsManager.getBiome(posAhead.x, posAhead.y) == Lake || 
-			boidsManager.getBiome(b.getLocation().x, b.getLocation().y) == Lake)) 
-	{
-
-		glm::vec3 lakeCenter(0,0,0);
-
-		bool lakeFound = boidsManager.getMap().getClosestLake(b.getLocation().x, b.getLocation().y, lakeCenter.x, lakeCenter.y);
-		if(lakeFound) {
-			return cNormalize(b.getLocation() - lakeCenter) * b.getParameters()->getMaxForce();
-		} else {
-			return glm::vec3(0,0,0); // There is no lake
-		}
+	// The sea is avoided from the maximum distance of view, the lakes only
+	// from the shorter distance to see ahead, in every direction
+	if (steering.seaDistance <= b.getParameters()->getDistViewMax()) {
+		return glm::vec3(steering.seaEscape, 0.0f) * b.getParameters()->getMaxForce();
+	} else if (b.getStateType() != FIND_WATER_STATE 
+		&& steering.lakeDistance <= b.getParameters()->getDistSeeAhead()) {
+		return glm::vec3(steering.lakeEscape, 0.0f) * b.getParameters()->getMaxForce();
 	} else {
 		return glm::vec3(0,0,0);
 	}
 }
 
-glm::vec3 MovableState::coherentWalk(const MovableBoid & b, const BoidsManager & boidsManager) const
+glm::vec3 MovableState::coherentWalk(const MovableBoid & b, const SteeringSample & steering) const
 {
-	glm::vec3 posAheadMax = b.getLocation() + cNormalize(b.getVelocity()) * b.getParameters()->getDistSeeAhead();
-
-	float heightDifference = boidsManager.getHeight(posAheadMax.x, posAheadMax.y) - boidsManager.getHeight(b.getLocation().x, b.getLocation().y);
-	if(heightDifference > 2.0f || heightDifference < -2.0f
-		|| boidsManager.getBiome(posAheadMax.x, posAheadMax.y) == Mountain 
-		|| boidsManager.getBiome(b.getLocation().x, b.getLocation().y) == Mountain
-		|| boidsManager.getBiome(posAheadMax.x, posAheadMax.y) == Peak 
-		|| boidsManager.getBiome(b.getLocation().x, b.getLocation().y) == Peak) {
-		return 4000.0f * cNormalize(- posAheadMax) * b.getParameters()->getMaxForce();
+	if (steering.slopeDistance <= b.getParameters()->getDistSeeAhead()) {
+		return 4000.0f * glm::vec3(steering.slopeEscape, 0.0f) * b.getParameters()->getMaxForce();
 	} else {
 		return glm::vec3(0,0,0);
 	}
@@ -326,7 +302,8 @@ void MovableState::updateDanger(MovableBoid& b, const std::list<MovableBoidPtr>
 	bool predatorFound = false;
 	MovableBoidPtr predatorBoid;
 
-	std::list<MovableBoidPtr>::const_iterator it = mvB.begin();
+	// The neighbours are only searched when a predator entered the surrounding boxes
+	std::list<MovableBoidPtr>::const_iterator it = b.isPredatorAround() ? mvB.begin() : mvB.end();
 	while(!predatorFound && it != mvB.end()) {
 		if((*it)->getBoidType() == predator && b.canSee(**it, b.getParameters()->getDistViewMax())) {
 			predatorBoid = *it;
@@ -335,10 +312,13 @@ void MovableState::updateDanger(MovableBoid& b, const std::list<MovableBoidPtr>
 		++it;
 	}
 
-	if(predatorFound && !predatorBoid->isDead()) {
-		b.getParameters()->dangerIncrease();
-	} else {
-		b.getParameters()->dangerDecrease();
+	// The danger evolves for every tick covered by the update
+	for (unsigned int k = 0; k < b.getUpdateTicks(); ++k) {
+		if(predatorFound && !predatorBoid->isDead()) {
+			b.getParameters()->dangerIncrease();
+		} else {
+			b.getParameters()->dangerDecrease();
+		}
 	}
 }
 
@@ -354,10 +334,13 @@ void MovableState::updateAffinity(MovableBoid& b, const std::list<MovableBoidPtr
 		++it;
 	}
 
-	if(friendFound) {
-		b.getParameters()->affinityIncrease();
-	} else {
-		b.getParameters()->affinityDecrease();
+	// The affinity evolves for every tick covered by the update
+	for (unsigned int k = 0; k < b.getUpdateTicks(); ++k) {
+		if(friendFound) {
+			b.getParameters()->affinityIncrease();
+		} else {
+			b.getParameters()->affinityDecrease();
+		}
 	}
 }
 
@@ -377,8 +360,10 @@ glm::vec3 MovableState::globalAvoid(const MovableBoid & b, const BoidsManager &
 
 glm::vec3 MovableState::avoidEnvironment(const MovableBoid & b, const BoidsManager & boidsManager, const int & i, const int & j) const
 {
-	return boidsManager.m_forceController.getStayOnIsland() * stayOnIsland(b, boidsManager) 
-			+ boidsManager.m_forceController.getStayOnIsland() * coherentWalk(b, boidsManager)
+	// A single lookup of the terrain for both forces
+	SteeringSample steering = boidsManager.getSteering(b.getLocation().x, b.getLocation().y);
+	return boidsManager.m_forceController.getStayOnIsland() * stayOnIsland(b, steering) 
+			+ boidsManager.m_forceController.getStayOnIsland() * coherentWalk(b, steering)
 			+ boidsManager.m_forceController.getCollisionAvoidance() * collisionAvoid(b, boidsManager.getRootedBoids(i, j));
 }
 
@@ -512,7 +497,7 @@ glm::vec3 FleeState::computeNewForces(MovableBoid& b, const BoidsManager & boids
 			// nothing to do has no predator
 		break;
 		case RABBIT:
-			rabbitPredator = closestMovable(b, b.getPredatorType(), mvB);
+			rabbitPredator = boidsManager.closestMovable(b, b.getPredatorType(), i, j);
 			if (rabbitPredator == (MovableBoidPtr) nullptr) {
 				newForces += wander(b);
 			} else {
@@ -543,7 +528,6 @@ glm::vec3 FindFoodState::computeNewForces(MovableBoid& b, const BoidsManager & b
 	// if alone affinity <- ad(affinity)
 	glm::vec3 newForces(0,0,0);
 	const std::list<MovableBoidPtr> mvB = boidsManager.getNeighbour(i, j);
-	const std::list<RootedBoidPtr> rtB = boidsManager.getRootedBoids(i, j);
 
 	if (updateTick) {
 		b.getParameters()->staminaDecreaseWalk();
@@ -561,7 +545,7 @@ glm::vec3 FindFoodState::computeNewForces(MovableBoid& b, const BoidsManager & b
 	RootedBoidPtr rootedTarget;
 	switch (b.getBoidType()) {
 		case WOLF:
-			movableTarget = closestMovable(b, RABBIT, mvB);
+			movableTarget = boidsManager.closestMovable(b, RABBIT, i, j);
 			if (movableTarget == (MovableBoidPtr) nullptr) {
 				newForces += wander(b);
 			} else {
@@ -570,7 +554,7 @@ glm::vec3 FindFoodState::computeNewForces(MovableBoid& b, const BoidsManager & b
 			}
 			break;
 		case RABBIT:
-			rootedTarget = closestRooted(b, CARROT, rtB);
+			rootedTarget = boidsManager.closestRooted(b, CARROT, i, j);
 			if (rootedTarget == (RootedBoidPtr) nullptr) {
 				newForces += wander(b);
 			} else {
@@ -682,7 +666,7 @@ glm::vec3 MateState::computeNewForces(MovableBoid& b, const BoidsManager & boids
 	// if alone affinity <- ad(affinity)
 	const std::list<MovableBoidPtr> mvB = boidsManager.getNeighbour(i, j);
 
-	MovableBoidPtr mate = closestMovable(b, b.getBoidType(), mvB);
+	MovableBoidPtr mate = boidsManager.closestMovable(b, b.getBoidType(), i, j);
 	
 	if (updateTick) {
 		b.getParameters()->staminaDecreaseWalk();
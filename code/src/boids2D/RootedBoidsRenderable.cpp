@@ -1,7 +1,7 @@
 #include "../../include/boids2D/RootedBoidsRenderable.hpp"
 #include "../../include/gl_helper.hpp"
 #include "../../include/log.hpp"
-#include "../../include/Io.hpp"
+#include "../../include/AssetManager.hpp"
 #include "../../include/Utils.hpp"
 
 #include <glm/gtc/matrix_transform.hpp>
@@ -13,42 +13,25 @@ RootedBoidsRenderable::RootedBoidsRenderable(ShaderProgramPtr shaderProgram, Boi
     : HierarchicalRenderable(shaderProgram),
     m_instanceVBO(0), m_VBO(0), m_boidType(boidType), m_boidsManager(boidsManager)
 {
-    std::vector< glm::vec2 > texCoords;
-    std::vector< glm::vec3 > positions;
-    std::vector< glm::vec3 > normals;
-    std::vector< unsigned int > indices;
-
-    read_obj(mesh, positions, indices, normals, texCoords);
-
-    for(unsigned int i = 0; i<indices.size(); i++) {
-        m_vectorBuffer.push_back(positions[indices[i]]);
-        m_vectorBuffer.push_back(glm::vec3(0.0, 0.0, 0.0));
-        m_vectorBuffer.push_back(normals[indices[i]]);
-        m_texCoords.push_back(texCoords[indices[i]]);
+    MeshDataPtr meshData = AssetManager::getMesh(mesh);
+
+    if (meshData) {
+        const std::vector< unsigned int >& indices = meshData->indices;
+        m_vectorBuffer.reserve(3 * indices.size());
+        m_texCoords.reserve(indices.size());
+        for(unsigned int i = 0; i<indices.size(); i++) {
+            m_vectorBuffer.push_back(meshData->positions[indices[i]]);
+            m_vectorBuffer.push_back(glm::vec3(0.0, 0.0, 0.0));
+            m_vectorBuffer.push_back(meshData->normals[indices[i]]);
+            m_texCoords.push_back(meshData->texCoords[indices[i]]);
+        }
     }
 
     // number of element in the m_vectorBuffer (positions, colors, normals, ...)
     m_nbElement = 3;
 
-    //Create texture
-    glcheck(glGenTextures(1, &m_texId));
-
-    //Bind the texture
-    glcheck(glBindTexture(GL_TEXTURE_2D, m_texId));
-
-    //Textured options
-    glcheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST));
-    glcheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST));
-    glcheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE));
-    glcheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE));
-
-    sf::Image image;
-    image.loadFromFile(texture);
-    image.flipVertically(); // sfml inverts the v axis... put the image in OpenGL convention: lower left corner is (0,0)
-    glcheck(glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA32F, image.getSize().x, image.getSize().y, 0, GL_RGBA, GL_UNSIGNED_BYTE, (const GLvoid*)image.getPixelsPtr()));
-
-    //Release the texture
-    glcheck(glBindTexture(GL_TEXTURE_2D, 0));
+    // The texture is shared with the other renderables using the same file
+    m_texture = AssetManager::getTexture(texture, false, NEAREST_FILTERING);
 
     for(RootedBoidPtr m : m_boidsManager->getAllRootedBoids()){
         m_VAOs.push_back(0); 
@@ -81,13 +64,13 @@ void RootedBoidsRenderable::do_draw()
     glcheck(glBindBuffer(GL_ARRAY_BUFFER, m_instanceVBO));
     glcheck(glBufferData(GL_ARRAY_BUFFER, m_modelMatrix.size() * sizeof(glm::mat4), m_modelMatrix.data(), GL_DYNAMIC_DRAW));
 
-    int positionLocation = m_shaderProgram->getAttributeLocation("position");
-    int colorLocation = m_shaderProgram->getAttributeLocation("color");
-    int normalLocation = m_shaderProgram->getAttributeLocation("normal");
-    int modelLocation = m_shaderProgram->getAttributeLocation("modelMat");
-    int nitLocation = m_shaderProgram->getUniformLocation("NIT");
-    int texcoordLocation = m_shaderProgram->getAttributeLocation("texCoord");
-    int texsamplerLocation = m_shaderProgram->getUniformLocation("texSampler");
+    int positionLocation = m_shaderProgram->getAttributeLocation(SHADER_VARIABLE("position"));
+    int colorLocation = m_shaderProgram->getAttributeLocation(SHADER_VARIABLE("color"));
+    int normalLocation = m_shaderProgram->getAttributeLocation(SHADER_VARIABLE("normal"));
+    int modelLocation = m_shaderProgram->getAttributeLocation(SHADER_VARIABLE("modelMat"));
+    int nitLocation = m_shaderProgram->getUniformLocation(SHADER_VARIABLE("NIT"));
+    int texcoordLocation = m_shaderProgram->getAttributeLocation(SHADER_VARIABLE("texCoord"));
+    int texsamplerLocation = m_shaderProgram->getUniformLocation(SHADER_VARIABLE("texSampler"));
 
     //Send material uniform to GPU
     Material::sendToGPU(m_shaderProgram, m_material);
@@ -141,7 +124,7 @@ void RootedBoidsRenderable::do_draw()
     if(texcoordLocation != ShaderProgram::null_location)
     {
         glcheck(glActiveTexture(GL_TEXTURE0));
-        glcheck(glBindTexture(GL_TEXTURE_2D, m_texId));
+        glcheck(glBindTexture(GL_TEXTURE_2D, m_texture ? m_texture->getId() : 0));
         //Send "texSampler" to Textured Unit 0
         glcheck(glUniform1i(texsamplerLocation, 0));
         glcheck(glEnableVertexAttribArray(texcoordLocation));
@@ -181,22 +164,20 @@ void RootedBoidsRenderable::do_animate(float time) {}
 void RootedBoidsRenderable::compute_modelMatrix()
 {
     m_modelMatrix.clear();
-    std::vector<RootedBoidPtr> rtB = m_boidsManager->getAllRootedBoids();
-
-    for (RootedBoidPtr r : rtB) {
-        if(r->getBoidType() == m_boidType && r->toDisplay()) {
+    for (const BoidSnapshot & r : m_boidsManager->getSnapshot().rootedBoids) {
+        if(r.type == m_boidType && r.display) {
             glm::mat4 transformation(1.0);
             glm::mat4 model = getModelMatrix();
             
-            float cz = cos(r->getAngle() - M_PI / 2.0);
-            float sz = sin(r->getAngle() - M_PI / 2.0);
+            float cz = cos(r.angle - M_PI / 2.0);
+            float sz = sin(r.angle - M_PI / 2.0);
             float cy = cos(0.0);
             float sy = sin(0.0);
             float cx = cos(- M_PI / 2.0);
             float sx = sin(- M_PI / 2.0);
-            float scale = r->getScale();
+            float scale = r.scale;
              
-            glm::vec3 position = r->getLocation();
+            glm::vec3 position = r.location;
 
             transformation[0][0] = scale * cz * cy;
             transformation[0][1] = scale * sz * cy;
@@ -233,3 +214,13 @@ void RootedBoidsRenderable::setMaterial(const MaterialPtr& material)
 {
     m_material = material;
 }
+
+unsigned int RootedBoidsRenderable::do_getTextureKey() const
+{
+    return m_texture->getId();
+}
+
+unsigned int RootedBoidsRenderable::do_getMeshKey() const
+{
+    return m_VBO;
+}
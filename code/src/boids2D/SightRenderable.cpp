@@ -65,10 +65,10 @@ void SightRenderable::do_draw()
         return;
     }
     //Location
-    int positionLocation = m_shaderProgram->getAttributeLocation("vPosition");
-    int colorLocation = m_shaderProgram->getAttributeLocation("vColor");
-    int normalLocation = m_shaderProgram->getAttributeLocation("vNormal");
-    int modelLocation = m_shaderProgram->getUniformLocation("modelMat");
+    int positionLocation = m_shaderProgram->getAttributeLocation(SHADER_VARIABLE("vPosition"));
+    int colorLocation = m_shaderProgram->getAttributeLocation(SHADER_VARIABLE("vColor"));
+    int normalLocation = m_shaderProgram->getAttributeLocation(SHADER_VARIABLE("vNormal"));
+    int modelLocation = m_shaderProgram->getUniformLocation(SHADER_VARIABLE("modelMat"));
 
     //Send data to GPU
     if(modelLocation != ShaderProgram::null_location)
@@ -1,5 +1,6 @@
 #include "../../include/boids2D/SolverBoid.hpp"
 #include "../../include/boids2D/MovableBoid.hpp"
+#include "../../include/Profiler.hpp"
 
 #include <iostream>
 
@@ -8,14 +9,20 @@ SolverBoid::SolverBoid() {
 }
 
 void SolverBoid::solve( const float& dt, BoidsManagerPtr boidsManager) {
-    glm::vec3 prevLocation;
-    unsigned int iprev;
-    unsigned int jprev;
+    PROFILE_SCOPE("SolverBoid::solve");
     std::vector<MovableBoidPtr> mvB = boidsManager->getMovableBoids();
-    #pragma omp parallel for private(prevLocation, iprev, jprev)
-    for (signed int i = 0; i < mvB.size(); ++i) {
-        prevLocation = mvB[i]->computeNextStep(dt, boidsManager);
-        boidsManager->coordToBox(prevLocation, iprev, jprev);
-        boidsManager->updateBoidInGrid(mvB[i], iprev, jprev);
+    #pragma omp parallel
+    {
+        // One marker per thread, to see how the boids are shared between them
+        PROFILE_SCOPE("SolverBoid::solve worker");
+        glm::vec3 prevLocation;
+        unsigned int iprev;
+        unsigned int jprev;
+        #pragma omp for
+        for (signed int i = 0; i < mvB.size(); ++i) {
+            prevLocation = mvB[i]->computeNextStep(dt, boidsManager);
+            boidsManager->coordToBox(prevLocation, iprev, jprev);
+            boidsManager->updateBoidInGrid(mvB[i], iprev, jprev);
+        }
     }
 }
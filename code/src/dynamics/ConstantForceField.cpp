@@ -6,11 +6,22 @@ ConstantForceField::ConstantForceField(const std::vector<ParticlePtr>& particles
     m_force = force;
 }
 
-void ConstantForceField::do_addForce()
+void ConstantForceField::do_bind(const ParticleArrays& particles)
 {
+    m_indices.clear();
     for(ParticlePtr p : m_particles)
     {
-        p->incrForce(m_force*p->getMass());
+        const std::size_t index = particles.indexOf(p);
+        if(index != ParticleArrays::npos)
+            m_indices.push_back(index);
+    }
+}
+
+void ConstantForceField::do_addForce(const ParticleArrays& particles, std::vector<glm::vec3>& forces)
+{
+    for(std::size_t i : m_indices)
+    {
+        forces[i] += m_force*particles.masses[i];
     }
 }
 
@@ -22,6 +33,7 @@ const std::vector<ParticlePtr> ConstantForceField::getParticles()
 void ConstantForceField::setParticles(const std::vector<ParticlePtr>& particles)
 {
     m_particles = particles;
+    unbind();
 }
 
 const glm::vec3& ConstantForceField::getForce()
@@ -67,10 +67,10 @@ void ConstantForceFieldRenderable::do_draw()
     glcheck(glBufferData(GL_ARRAY_BUFFER, m_positions.size()*sizeof(glm::vec3), m_positions.data(), GL_STATIC_DRAW));
 
     //Draw geometric data
-    int positionLocation = m_shaderProgram->getAttributeLocation("vPosition");
-    int colorLocation = m_shaderProgram->getAttributeLocation("vColor");
-    int normalLocation = m_shaderProgram->getAttributeLocation("vNormal");
-    int modelLocation = m_shaderProgram->getUniformLocation("modelMat");
+    int positionLocation = m_shaderProgram->getAttributeLocation(SHADER_VARIABLE("vPosition"));
+    int colorLocation = m_shaderProgram->getAttributeLocation(SHADER_VARIABLE("vColor"));
+    int normalLocation = m_shaderProgram->getAttributeLocation(SHADER_VARIABLE("vNormal"));
+    int modelLocation = m_shaderProgram->getUniformLocation(SHADER_VARIABLE("modelMat"));
 
     if(modelLocation != ShaderProgram::null_location)
     {
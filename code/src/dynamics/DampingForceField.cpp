@@ -6,11 +6,30 @@ DampingForceField::DampingForceField(const std::vector<ParticlePtr> particles, c
     m_damping = damping;
 }
 
-void DampingForceField::do_addForce()
+void DampingForceField::do_bind(const ParticleArrays& particles)
 {
+    m_indices.clear();
     for(ParticlePtr p : m_particles)
     {
-        p->incrForce(-m_damping*p->getVelocity());
+        const std::size_t index = particles.indexOf(p);
+        if(index != ParticleArrays::npos)
+            m_indices.push_back(index);
+    }
+}
+
+void DampingForceField::do_addForce(const ParticleArrays& particles, std::vector<glm::vec3>& forces)
+{
+    for(std::size_t i : m_indices)
+    {
+        forces[i] -= m_damping*particles.velocities[i];
+    }
+}
+
+void DampingForceField::do_addJacobians(const ParticleArrays& particles, SparseBlockMatrix& dfdx, SparseBlockMatrix& dfdv)
+{
+    for(std::size_t i : m_indices)
+    {
+        dfdv.addBlock(i, i, glm::mat3(-m_damping));
     }
 }
 
@@ -22,6 +41,7 @@ const std::vector<ParticlePtr> DampingForceField::getParticles()
 void DampingForceField::setParticles(const std::vector<ParticlePtr>& particles)
 {
     m_particles = particles;
+    unbind();
 }
 
 const float& DampingForceField::getDamping()
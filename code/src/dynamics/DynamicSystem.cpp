@@ -1,5 +1,7 @@
+#include <algorithm>
 #include <cmath>
 #include <iostream>
+#include <omp.h>
 #include <GL/glew.h>
 #include <glm/gtc/type_ptr.hpp>
 #include <glm/gtx/norm.hpp>
@@ -10,8 +12,11 @@
 #include "./../../include/dynamics/Particle.hpp"
 #include "./../../include/dynamics/RoundedParticle.hpp"
 
+/** Number of force fields above which they are accumulated in parallel */
+#define PARALLEL_MIN_FORCE_FIELDS 1024
+
 DynamicSystem::DynamicSystem() :
-    m_dt(0.1)
+    m_dt(0.1), m_particlesChanged(false)
 {
 }
 
@@ -24,6 +29,7 @@ const std::vector<ParticlePtr>& DynamicSystem::getParticles() const
 void DynamicSystem::setParticles(const std::vector<ParticlePtr> &particles)
 {
     m_particles = particles;
+    m_particlesChanged = true;
 }
 
 const std::vector<ForceFieldPtr>& DynamicSystem::getForceFields() const
@@ -53,11 +59,13 @@ void DynamicSystem::clear()
 {
     m_particles.clear();
     m_forceFields.clear();
+    m_particlesChanged = true;
 }
 
 void DynamicSystem::addParticle(ParticlePtr p)
 {
     m_particles.push_back(p);
+    m_particlesChanged = true;
 }
 
 void DynamicSystem::addForceField(ForceFieldPtr forceField)
@@ -77,18 +85,76 @@ void DynamicSystem::setSolver(SolverPtr solver)
 
 void DynamicSystem::computeSimulationStep()
 {
+    //Copy the particles in the arrays, with null forces
+    if(m_particlesChanged)
+    {
+        m_arrays.setParticles(m_particles);
+        m_particlesChanged = false;
+    }
+    m_arrays.gather();
+
     //Compute particle's force
-    for(ParticlePtr p : m_particles)
+    computeForces();
+
+    //Integrate position and velocity of particles
+    m_solver->solve(m_dt, *this);
+    m_arrays.scatter();
+}
+
+ParticleArrays& DynamicSystem::getParticleArrays()
+{
+    return m_arrays;
+}
+
+void DynamicSystem::computeForces()
+{
+    std::fill(m_arrays.forces.begin(), m_arrays.forces.end(), glm::vec3(0.0,0.0,0.0));
+
+    const int nbForceFields = (int) m_forceFields.size();
+    if(nbForceFields < PARALLEL_MIN_FORCE_FIELDS)
     {
-        p->setForce(glm::vec3(0.0,0.0,0.0));
+        for(ForceFieldPtr f : m_forceFields)
+        {
+            f->addForce(m_arrays, m_arrays.forces);
+        }
+        return;
     }
-    for(ForceFieldPtr f : m_forceFields)
+
+    const int nbParticles = (int) m_arrays.size();
+    m_threadForces.resize(omp_get_max_threads());
+
+    #pragma omp parallel
     {
-        f->addForce();
+        const int nbThreads = omp_get_num_threads();
+        std::vector<glm::vec3>& threadForces = m_threadForces[omp_get_thread_num()];
+        threadForces.assign(nbParticles, glm::vec3(0.0,0.0,0.0));
+
+        #pragma omp for schedule(static)
+        for(int f = 0; f < nbForceFields; ++f)
+        {
+            m_forceFields[f]->addForce(m_arrays, threadForces);
+        }
+
+        // Sum the buffers of the threads, each thread on its own particles
+        #pragma omp for schedule(static)
+        for(int i = 0; i < nbParticles; ++i)
+        {
+            for(int t = 0; t < nbThreads; ++t)
+            {
+                m_arrays.forces[i] += m_threadForces[t][i];
+            }
+        }
     }
+}
 
-    //Integrate position and velocity of particles
-    m_solver->solve(m_dt, m_particles);
+void DynamicSystem::computeJacobians(SparseBlockMatrix& dfdx, SparseBlockMatrix& dfdv)
+{
+    dfdx.reset(m_arrays.size());
+    dfdv.reset(m_arrays.size());
+    for(ForceFieldPtr f : m_forceFields)
+    {
+        f->addJacobians(m_arrays, dfdx, dfdv);
+    }
 }
 
 std::ostream& operator<<(std::ostream& os, const DynamicSystemPtr& system)
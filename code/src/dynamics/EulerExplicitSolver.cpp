@@ -1,4 +1,8 @@
 #include "./../../include/dynamics/EulerExplicitSolver.hpp"
+#include "./../../include/dynamics/DynamicSystem.hpp"
+
+/** Number of particles above which they are integrated in parallel */
+#define PARALLEL_MIN_PARTICLES 4096
 
 EulerExplicitSolver::EulerExplicitSolver()
 {
@@ -10,18 +14,17 @@ EulerExplicitSolver::~EulerExplicitSolver()
 
 }
 
-void EulerExplicitSolver::do_solve(const float& dt, std::vector<ParticlePtr>& particles)
+void EulerExplicitSolver::do_solve(const float& dt, DynamicSystem& system)
 {
-    for(ParticlePtr p : particles)
+    ParticleArrays& particles = system.getParticleArrays();
+    const int n = (int) particles.size();
+    #pragma omp parallel for if(n > PARALLEL_MIN_PARTICLES)
+    for(int i = 0; i < n; ++i)
     {
-        if(!p->isFixed())
+        if(!particles.fixed[i])
         {
-            //TODO: Implement explicit euler solver
-            //Functions to use:
-            //Particle::getPosition(), Particle::getVelocity(), Particle::getMass(), Particle::getForce()
-            //Particle::setPosition(), Particle::setVelocity()
-            p->setVelocity( p->getVelocity() + dt * ( 1.0f/p->getMass() ) * p->getForce() );
-            p->setPosition( p->getPosition() + dt * p->getVelocity() );
+            particles.positions[i] += dt * particles.velocities[i];
+            particles.velocities[i] += dt * ( 1.0f/particles.masses[i] ) * particles.forces[i];
         }
     }
 }
@@ -1,10 +1,37 @@
 #include "../../include/dynamics/ForceField.hpp"
 
-ForceField::ForceField(){}
+ForceField::ForceField() :
+  m_boundArrays(nullptr), m_boundVersion(0)
+{}
 
 ForceField::~ForceField(){}
 
-void ForceField::addForce()
+void ForceField::addForce(const ParticleArrays& particles, std::vector<glm::vec3>& forces)
 {
-  do_addForce();
+  bind(particles);
+  do_addForce(particles, forces);
+}
+
+void ForceField::addJacobians(const ParticleArrays& particles, SparseBlockMatrix& dfdx, SparseBlockMatrix& dfdv)
+{
+  bind(particles);
+  do_addJacobians(particles, dfdx, dfdv);
+}
+
+void ForceField::bind(const ParticleArrays& particles)
+{
+  if(m_boundArrays != &particles || m_boundVersion != particles.getVersion())
+  {
+    do_bind(particles);
+    m_boundArrays = &particles;
+    m_boundVersion = particles.getVersion();
+  }
+}
+
+void ForceField::do_addJacobians(const ParticleArrays& particles, SparseBlockMatrix& dfdx, SparseBlockMatrix& dfdv)
+{}
+
+void ForceField::unbind()
+{
+  m_boundArrays = nullptr;
 }
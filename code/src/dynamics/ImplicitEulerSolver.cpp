@@ -0,0 +1,121 @@
+#include "./../../include/dynamics/ImplicitEulerSolver.hpp"
+#include "./../../include/dynamics/DynamicSystem.hpp"
+
+/** Number of particles above which they are integrated in parallel */
+#define PARALLEL_MIN_PARTICLES 4096
+
+/**
+ * @brief Dot product of two vectors of 3D vectors
+ */
+static double dot(const std::vector<glm::vec3>& a, const std::vector<glm::vec3>& b)
+{
+    const int n = (int) a.size();
+    double sum = 0.0;
+    #pragma omp parallel for reduction(+:sum) if(n > PARALLEL_MIN_PARTICLES)
+    for(int i = 0; i < n; ++i)
+    {
+        sum += glm::dot(a[i], b[i]);
+    }
+    return sum;
+}
+
+ImplicitEulerSolver::ImplicitEulerSolver(unsigned int maxIterations, float tolerance) :
+    m_maxIterations(maxIterations), m_tolerance(tolerance)
+{
+
+}
+
+ImplicitEulerSolver::~ImplicitEulerSolver()
+{
+
+}
+
+void ImplicitEulerSolver::multiply(const ParticleArrays& particles, const float& dt,
+                                   const std::vector<glm::vec3>& x, std::vector<glm::vec3>& y)
+{
+    // y = (M - dt * df/dv - dt^2 * df/dx) x
+    m_dfdv.multiply(x, y);
+    m_dfdx.multiply(x, m_tmp);
+    const int n = (int) particles.size();
+    #pragma omp parallel for if(n > PARALLEL_MIN_PARTICLES)
+    for(int i = 0; i < n; ++i)
+    {
+        y[i] = particles.fixed[i] ? glm::vec3(0.0,0.0,0.0)
+            : particles.masses[i] * x[i] - dt * y[i] - dt * dt * m_tmp[i];
+    }
+}
+
+void ImplicitEulerSolver::do_solve(const float& dt, DynamicSystem& system)
+{
+    ParticleArrays& particles = system.getParticleArrays();
+    const int n = (int) particles.size();
+    system.computeJacobians(m_dfdx, m_dfdv);
+
+    //Right hand side dt * (f + dt * df/dx * v), and the inverse of the diagonal of the system
+    m_dfdx.multiply(particles.velocities, m_b);
+    m_preconditioner.resize(n);
+    #pragma omp parallel for if(n > PARALLEL_MIN_PARTICLES)
+    for(int i = 0; i < n; ++i)
+    {
+        if(particles.fixed[i])
+        {
+            m_b[i] = glm::vec3(0.0,0.0,0.0);
+            m_preconditioner[i] = glm::vec3(0.0,0.0,0.0);
+        }
+        else
+        {
+            m_b[i] = dt * (particles.forces[i] + dt * m_b[i]);
+            const glm::mat3& dfdx = m_dfdx.getDiagonalBlock(i);
+            const glm::mat3& dfdv = m_dfdv.getDiagonalBlock(i);
+            for(int c = 0; c < 3; ++c)
+            {
+                m_preconditioner[i][c] = 1.0f / (particles.masses[i] - dt * dfdv[c][c] - dt * dt * dfdx[c][c]);
+            }
+        }
+    }
+
+    //Preconditioned conjugate gradient, starting from a null change of velocity
+    m_dv.assign(n, glm::vec3(0.0,0.0,0.0));
+    m_r = m_b;
+    m_z.resize(n);
+    for(int i = 0; i < n; ++i)
+        m_z[i] = m_preconditioner[i] * m_r[i];
+    m_p = m_z;
+    double rz = dot(m_r, m_z);
+    const double threshold = (double) m_tolerance * m_tolerance * dot(m_b, m_b);
+
+    for(unsigned int k = 0; k < m_maxIterations && dot(m_r, m_r) > threshold; ++k)
+    {
+        multiply(particles, dt, m_p, m_q);
+        const double pq = dot(m_p, m_q);
+        if(pq <= 0.0)
+            break;
+        const float alpha = (float) (rz / pq);
+        #pragma omp parallel for if(n > PARALLEL_MIN_PARTICLES)
+        for(int i = 0; i < n; ++i)
+        {
+            m_dv[i] += alpha * m_p[i];
+            m_r[i] -= alpha * m_q[i];
+            m_z[i] = m_preconditioner[i] * m_r[i];
+        }
+        const double rzNext = dot(m_r, m_z);
+        const float beta = (float) (rzNext / rz);
+        rz = rzNext;
+        #pragma omp parallel for if(n > PARALLEL_MIN_PARTICLES)
+        for(int i = 0; i < n; ++i)
+        {
+            m_p[i] = m_z[i] + beta * m_p[i];
+        }
+    }
+
+    //Integrate with the new velocities
+    #pragma omp parallel for if(n > PARALLEL_MIN_PARTICLES)
+    for(int i = 0; i < n; ++i)
+    {
+        if(!particles.fixed[i])
+        {
+            particles.velocities[i] += m_dv[i];
+            particles.positions[i] += dt * particles.velocities[i];
+        }
+    }
+}
@@ -0,0 +1,68 @@
+#include "./../../include/dynamics/ParticleArrays.hpp"
+
+const std::size_t ParticleArrays::npos;
+
+ParticleArrays::ParticleArrays() :
+    m_version(0)
+{}
+
+ParticleArrays::~ParticleArrays()
+{}
+
+void ParticleArrays::setParticles(const std::vector<ParticlePtr>& particles)
+{
+    m_particles = particles;
+
+    m_indices.clear();
+    m_indices.reserve(m_particles.size());
+    for(std::size_t i = 0; i < m_particles.size(); ++i)
+    {
+        m_indices[m_particles[i].get()] = i;
+    }
+
+    positions.resize(m_particles.size());
+    velocities.resize(m_particles.size());
+    forces.resize(m_particles.size());
+    masses.resize(m_particles.size());
+    fixed.resize(m_particles.size());
+    ++m_version;
+}
+
+std::size_t ParticleArrays::indexOf(const ParticlePtr& particle) const
+{
+    std::unordered_map<const Particle*, std::size_t>::const_iterator it = m_indices.find(particle.get());
+    return it == m_indices.end() ? npos : it->second;
+}
+
+std::size_t ParticleArrays::size() const
+{
+    return m_particles.size();
+}
+
+unsigned int ParticleArrays::getVersion() const
+{
+    return m_version;
+}
+
+void ParticleArrays::gather()
+{
+    for(std::size_t i = 0; i < m_particles.size(); ++i)
+    {
+        const Particle& p = *m_particles[i];
+        positions[i] = p.getPosition();
+        velocities[i] = p.getVelocity();
+        masses[i] = p.getMass();
+        fixed[i] = p.isFixed();
+    }
+}
+
+void ParticleArrays::scatter() const
+{
+    for(std::size_t i = 0; i < m_particles.size(); ++i)
+    {
+        Particle& p = *m_particles[i];
+        p.setPosition(positions[i]);
+        p.setVelocity(velocities[i]);
+        p.setForce(forces[i]);
+    }
+}
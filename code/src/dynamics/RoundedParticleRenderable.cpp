@@ -88,11 +88,11 @@ void RoundedParticleRenderable::do_draw()
     setLocalTransform(translate*scale);
 
     //Draw geometric data
-    int positionLocation = m_shaderProgram->getAttributeLocation("vPosition");
-    int colorLocation = m_shaderProgram->getAttributeLocation("vColor");
-    int normalLocation = m_shaderProgram->getAttributeLocation("vNormal");
-    int modelLocation = m_shaderProgram->getUniformLocation("modelMat");
-    int nitLocation = m_shaderProgram->getUniformLocation("NIT");
+    int positionLocation = m_shaderProgram->getAttributeLocation(SHADER_VARIABLE("vPosition"));
+    int colorLocation = m_shaderProgram->getAttributeLocation(SHADER_VARIABLE("vColor"));
+    int normalLocation = m_shaderProgram->getAttributeLocation(SHADER_VARIABLE("vNormal"));
+    int modelLocation = m_shaderProgram->getUniformLocation(SHADER_VARIABLE("modelMat"));
+    int nitLocation = m_shaderProgram->getUniformLocation(SHADER_VARIABLE("NIT"));
   
 
     //Send material uniform to GPU
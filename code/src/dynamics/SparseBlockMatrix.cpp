@@ -0,0 +1,54 @@
+#include "./../../include/dynamics/SparseBlockMatrix.hpp"
+
+/** Number of block rows above which the diagonal is multiplied in parallel */
+#define PARALLEL_MIN_ROWS 4096
+
+SparseBlockMatrix::SparseBlockMatrix()
+{}
+
+SparseBlockMatrix::~SparseBlockMatrix()
+{}
+
+void SparseBlockMatrix::reset(std::size_t size)
+{
+    m_diagonal.assign(size, glm::mat3(0.0f));
+    m_entries.clear();
+}
+
+std::size_t SparseBlockMatrix::size() const
+{
+    return m_diagonal.size();
+}
+
+void SparseBlockMatrix::addBlock(std::size_t i, std::size_t j, const glm::mat3& block)
+{
+    if(i == j)
+    {
+        m_diagonal[i] += block;
+    }
+    else
+    {
+        Entry entry = { i, j, block };
+        m_entries.push_back(entry);
+    }
+}
+
+const glm::mat3& SparseBlockMatrix::getDiagonalBlock(std::size_t i) const
+{
+    return m_diagonal[i];
+}
+
+void SparseBlockMatrix::multiply(const std::vector<glm::vec3>& x, std::vector<glm::vec3>& y) const
+{
+    const int n = (int) m_diagonal.size();
+    y.resize(n);
+    #pragma omp parallel for if(n > PARALLEL_MIN_ROWS)
+    for(int i = 0; i < n; ++i)
+    {
+        y[i] = m_diagonal[i] * x[i];
+    }
+    for(const Entry& entry : m_entries)
+    {
+        y[entry.i] += entry.block * x[entry.j];
+    }
+}
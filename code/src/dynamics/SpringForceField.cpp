@@ -1,25 +1,45 @@
 #include "./../../include/dynamics/SpringForceField.hpp"
 
+#include <algorithm>
+#include <limits>
+
 SpringForceField::SpringForceField(const ParticlePtr p1, const ParticlePtr p2, float stiffness, float equilibriumLength, float damping) :
     m_p1(p1),
     m_p2(p2),
     m_stiffness(stiffness),
     m_equilibriumLength(equilibriumLength),
-    m_damping(damping)
+    m_damping(damping),
+    m_index1(ParticleArrays::npos),
+    m_index2(ParticleArrays::npos)
 {}
 
-void SpringForceField::do_addForce()
+void SpringForceField::do_bind(const ParticleArrays& particles)
+{
+    m_index1 = particles.indexOf(m_p1);
+    m_index2 = particles.indexOf(m_p2);
+}
+
+void SpringForceField::do_addForce(const ParticleArrays& particles, std::vector<glm::vec3>& forces)
+{
+    if(m_index1 == ParticleArrays::npos || m_index2 == ParticleArrays::npos)
+        return;
+
+    addSpringForce(particles, forces, m_index1, m_index2, m_stiffness, m_equilibriumLength, m_damping);
+}
+
+void SpringForceField::do_addJacobians(const ParticleArrays& particles, SparseBlockMatrix& dfdx, SparseBlockMatrix& dfdv)
 {
-    //TODO: Implement a damped spring
-    //Functions to use:
-    //glm::length( vec3 ): Return the length of a vector
-    //glm::normalize( vec3 ): Return the normalization of a vector
-    //Particle::getVelocity(), Particle::getForce(), Particle::setForce()
-    //Nb:   Compute force ONLY IF the displacement length is above std::numeric_limits<float>::epsilon()
-    //      Otherwise the computation is useless
+    if(m_index1 == ParticleArrays::npos || m_index2 == ParticleArrays::npos)
+        return;
 
+    addSpringJacobians(particles, dfdx, dfdv, m_index1, m_index2, m_stiffness, m_equilibriumLength, m_damping);
+}
+
+void SpringForceField::addSpringForce(const ParticleArrays& particles, std::vector<glm::vec3>& forces,
+        std::size_t index1, std::size_t index2, float stiffness, float equilibriumLength, float damping)
+{
     //Compute displacement vector
-    glm::vec3 u = m_p1->getPosition() - m_p2->getPosition();
+    glm::vec3 u = particles.positions[index1] - particles.positions[index2];
 
     //Compute displacement length
     float uNorm = glm::length(u);
@@ -30,11 +50,38 @@ void SpringForceField::do_addForce()
     if (uNorm > std::numeric_limits<float>::epsilon())
     {
         //Compute the stiffness term of the spring force
-        glm::vec3 sF = -m_stiffness * (uNorm - m_equilibriumLength) * u;
+        glm::vec3 sF = -stiffness * (uNorm - equilibriumLength) * u;
         //Compute the damping term of the spring force
-        glm::vec3 dF = -m_damping * glm::dot(m_p1->getVelocity() - m_p2->getVelocity(), u) * u;
-        m_p1->setForce(m_p1->getForce() + (sF + dF));
-        m_p2->setForce(m_p2->getForce() - (sF + dF));
+        glm::vec3 dF = -damping * glm::dot(particles.velocities[index1] - particles.velocities[index2], u) * u;
+        forces[index1] += sF + dF;
+        forces[index2] -= sF + dF;
+    }
+}
+
+void SpringForceField::addSpringJacobians(const ParticleArrays& particles, SparseBlockMatrix& dfdx, SparseBlockMatrix& dfdv,
+        std::size_t index1, std::size_t index2, float stiffness, float equilibriumLength, float damping)
+{
+    glm::vec3 u = particles.positions[index1] - particles.positions[index2];
+    float uNorm = glm::length(u);
+    if (uNorm > std::numeric_limits<float>::epsilon())
+    {
+        u /= uNorm;
+        const glm::mat3 uuT = glm::outerProduct(u, u);
+
+        //Derivative of the force on the first particle with respect to its position
+        const float transverse = std::max(1.0f - equilibriumLength / uNorm, 0.0f);
+        const glm::mat3 dFdx = -stiffness * (uuT + transverse * (glm::mat3(1.0f) - uuT));
+        dfdx.addBlock(index1, index1, dFdx);
+        dfdx.addBlock(index2, index2, dFdx);
+        dfdx.addBlock(index1, index2, -dFdx);
+        dfdx.addBlock(index2, index1, -dFdx);
+
+        //Derivative of the force on the first particle with respect to its velocity
+        const glm::mat3 dFdv = -damping * uuT;
+        dfdv.addBlock(index1, index1, dFdv);
+        dfdv.addBlock(index2, index2, dFdv);
+        dfdv.addBlock(index1, index2, -dFdv);
+        dfdv.addBlock(index2, index1, -dFdv);
     }
 }
 
@@ -47,3 +94,18 @@ ParticlePtr SpringForceField::getParticle2() const
 {
     return m_p2;
 }
+
+float SpringForceField::getStiffness() const
+{
+    return m_stiffness;
+}
+
+float SpringForceField::getEquilibriumLength() const
+{
+    return m_equilibriumLength;
+}
+
+float SpringForceField::getDamping() const
+{
+    return m_damping;
+}
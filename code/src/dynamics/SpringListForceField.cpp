@@ -0,0 +1,92 @@
+#include "./../../include/dynamics/SpringListForceField.hpp"
+
+#include <omp.h>
+
+/** Number of springs above which their forces are accumulated in parallel */
+#define PARALLEL_MIN_SPRINGS 1024
+
+SpringListForceField::SpringListForceField(const std::list<SpringForceFieldPtr>& springForceFields) :
+    m_springForceFields(springForceFields)
+{}
+
+const std::list<SpringForceFieldPtr>& SpringListForceField::getSpringForceFields() const
+{
+    return m_springForceFields;
+}
+
+void SpringListForceField::setSpringForceFields(const std::list<SpringForceFieldPtr>& springForceFields)
+{
+    m_springForceFields = springForceFields;
+    unbind();
+}
+
+void SpringListForceField::do_bind(const ParticleArrays& particles)
+{
+    m_springs.clear();
+    m_springs.reserve(m_springForceFields.size());
+    for(SpringForceFieldPtr s : m_springForceFields)
+    {
+        BoundSpring spring;
+        spring.index1 = particles.indexOf(s->getParticle1());
+        spring.index2 = particles.indexOf(s->getParticle2());
+        if(spring.index1 == ParticleArrays::npos || spring.index2 == ParticleArrays::npos)
+            continue;
+        spring.stiffness = s->getStiffness();
+        spring.equilibriumLength = s->getEquilibriumLength();
+        spring.damping = s->getDamping();
+        m_springs.push_back(spring);
+    }
+}
+
+void SpringListForceField::do_addForce(const ParticleArrays& particles, std::vector<glm::vec3>& forces)
+{
+    const int nbSprings = (int) m_springs.size();
+
+    // Already in a parallel region when the dynamic system accumulates many force fields
+    if(nbSprings < PARALLEL_MIN_SPRINGS || omp_in_parallel())
+    {
+        for(const BoundSpring& s : m_springs)
+        {
+            SpringForceField::addSpringForce(particles, forces, s.index1, s.index2,
+                    s.stiffness, s.equilibriumLength, s.damping);
+        }
+        return;
+    }
+
+    const int nbParticles = (int) forces.size();
+    m_threadForces.resize(omp_get_max_threads());
+
+    #pragma omp parallel
+    {
+        const int nbThreads = omp_get_num_threads();
+        std::vector<glm::vec3>& threadForces = m_threadForces[omp_get_thread_num()];
+        threadForces.assign(nbParticles, glm::vec3(0.0,0.0,0.0));
+
+        #pragma omp for schedule(static)
+        for(int i = 0; i < nbSprings; ++i)
+        {
+            const BoundSpring& s = m_springs[i];
+            SpringForceField::addSpringForce(particles, threadForces, s.index1, s.index2,
+                    s.stiffness, s.equilibriumLength, s.damping);
+        }
+
+        // Sum the buffers of the threads, each thread on its own particles
+        #pragma omp for schedule(static)
+        for(int i = 0; i < nbParticles; ++i)
+        {
+            for(int t = 0; t < nbThreads; ++t)
+            {
+                forces[i] += m_threadForces[t][i];
+            }
+        }
+    }
+}
+
+void SpringListForceField::do_addJacobians(const ParticleArrays& particles, SparseBlockMatrix& dfdx, SparseBlockMatrix& dfdv)
+{
+    for(const BoundSpring& s : m_springs)
+    {
+        SpringForceField::addSpringJacobians(particles, dfdx, dfdv, s.index1, s.index2,
+                s.stiffness, s.equilibriumLength, s.damping);
+    }
+}
@@ -0,0 +1,30 @@
+#include "./../../include/dynamics/SymplecticEulerSolver.hpp"
+#include "./../../include/dynamics/DynamicSystem.hpp"
+
+/** Number of particles above which they are integrated in parallel */
+#define PARALLEL_MIN_PARTICLES 4096
+
+SymplecticEulerSolver::SymplecticEulerSolver()
+{
+
+}
+
+SymplecticEulerSolver::~SymplecticEulerSolver()
+{
+
+}
+
+void SymplecticEulerSolver::do_solve(const float& dt, DynamicSystem& system)
+{
+    ParticleArrays& particles = system.getParticleArrays();
+    const int n = (int) particles.size();
+    #pragma omp parallel for if(n > PARALLEL_MIN_PARTICLES)
+    for(int i = 0; i < n; ++i)
+    {
+        if(!particles.fixed[i])
+        {
+            particles.velocities[i] += dt * ( 1.0f/particles.masses[i] ) * particles.forces[i];
+            particles.positions[i] += dt * particles.velocities[i];
+        }
+    }
+}
@@ -0,0 +1,43 @@
+#include "./../../include/dynamics/VelocityVerletSolver.hpp"
+#include "./../../include/dynamics/DynamicSystem.hpp"
+
+/** Number of particles above which they are integrated in parallel */
+#define PARALLEL_MIN_PARTICLES 4096
+
+VelocityVerletSolver::VelocityVerletSolver()
+{
+
+}
+
+VelocityVerletSolver::~VelocityVerletSolver()
+{
+
+}
+
+void VelocityVerletSolver::do_solve(const float& dt, DynamicSystem& system)
+{
+    ParticleArrays& particles = system.getParticleArrays();
+    const int n = (int) particles.size();
+
+    //First half of the velocity step, then the whole position step
+    #pragma omp parallel for if(n > PARALLEL_MIN_PARTICLES)
+    for(int i = 0; i < n; ++i)
+    {
+        if(!particles.fixed[i])
+        {
+            particles.velocities[i] += 0.5f * dt * ( 1.0f/particles.masses[i] ) * particles.forces[i];
+            particles.positions[i] += dt * particles.velocities[i];
+        }
+    }
+
+    //Second half of the velocity step, with the forces at the new positions
+    system.computeForces();
+    #pragma omp parallel for if(n > PARALLEL_MIN_PARTICLES)
+    for(int i = 0; i < n; ++i)
+    {
+        if(!particles.fixed[i])
+        {
+            particles.velocities[i] += 0.5f * dt * ( 1.0f/particles.masses[i] ) * particles.forces[i];
+        }
+    }
+}
@@ -56,9 +56,9 @@ void FrameRenderable::do_draw()
     // reasons:
     //  - those locations are stored in a look up table in the c++ side
     //  - we are in do_draw(), the shader program is guaranteed to be bound
-    GLint mLoc = m_shaderProgram->getUniformLocation("modelMat");
-    GLint vLoc = m_shaderProgram->getAttributeLocation("vPosition");
-    GLint cLoc = m_shaderProgram->getAttributeLocation("vColor");
+    GLint mLoc = m_shaderProgram->getUniformLocation(SHADER_VARIABLE("modelMat"));
+    GLint vLoc = m_shaderProgram->getAttributeLocation(SHADER_VARIABLE("vPosition"));
+    GLint cLoc = m_shaderProgram->getAttributeLocation(SHADER_VARIABLE("vColor"));
 
 
     //Change width of line primitive to 3 pixels
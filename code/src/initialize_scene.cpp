@@ -1,6 +1,7 @@
 #include "./../include/initialize_scene.hpp"
 
 #include "../include/ShaderProgram.hpp"
+#include "../include/AssetManager.hpp"
 #include "../include/graphicPrimitives/FrameRenderable.hpp"
 #include "../include/texturing/TexturedPlaneRenderable.hpp"
 #include "../include/texturing/TexturedCubeRenderable.hpp"
@@ -35,7 +36,7 @@
 #include "../include/boids2D/DynamicSystemBoidRenderable.hpp"
 
 #include "../include/dynamics/DynamicSystem.hpp"
-#include "../include/dynamics/EulerExplicitSolver.hpp"
+#include "../include/dynamics/SymplecticEulerSolver.hpp"
 #include "../include/dynamics/DynamicSystemRenderable.hpp"
 #include "../include/dynamics/ParticleRenderable.hpp"
 #include "../include/dynamics/ConstantForceField.hpp"
@@ -48,6 +49,9 @@
 void display_2Dboids( Viewer& viewer, BoidsManagerPtr boidsManager, 
     DynamicSystemBoidRenderablePtr systemRenderable, ShaderProgramPtr texShader, ShaderProgramPtr flatShader )
 {
+    // The boid renderables read the boids, which must not move while they are drawn
+    systemRenderable->setAsynchronous(false);
+
     for(MovableBoidPtr m : boidsManager->getMovableBoids())
     {
         BoidRenderablePtr br = std::make_shared<BoidRenderable>(texShader, m);
@@ -100,6 +104,8 @@ void display_3Dboids( Viewer& viewer, BoidsManagerPtr boidsManager,
     viewer.addRenderable(carrotsRenderable); 
 
     #ifdef DEBUG
+    // The debug renderables read the boids, which must not move while they are drawn
+    systemRenderable->setAsynchronous(false);
     for(MovableBoidPtr m : boidsManager->getMovableBoids())
     {
         SightRenderablePtr sight = std::make_shared<SightRenderable>(flatShader, m);
@@ -200,6 +206,20 @@ void initialize_map2D(Viewer& viewer, MapGenerator& mapGenerator, float mapSize)
 
 void initialize_test_scene( Viewer& viewer, MapGenerator& mapGenerator, float mapSize)    
 {
+    /*
+     * Starting to parse the meshes in the background, while the map is
+     * built on the main thread. The textures are decoded in the background
+     * as soon as they are requested.
+     */
+    AssetManager::prefetchMesh("../meshes/skybox.obj");
+    if (mapGenerator.getMapParameters().getBoidsEnabled()) {
+        AssetManager::prefetchMesh("../meshes/rabbit.obj");
+        AssetManager::prefetchMesh("../meshes/wolf.obj");
+        AssetManager::prefetchMesh("../meshes/trunk.obj");
+        AssetManager::prefetchMesh("../meshes/leaf.obj");
+        AssetManager::prefetchMesh("../meshes/carrot.obj");
+    }
+
     /*
      * Positionning the camera.
      */
@@ -370,7 +390,7 @@ void initialize_test_scene( Viewer& viewer, MapGenerator& mapGenerator, float ma
     // Particle camera for the demonstration
     // System particle for the camera
     DynamicSystemPtr systemParticle = std::make_shared<DynamicSystem>();
-    EulerExplicitSolverPtr solverParticle = std::make_shared<EulerExplicitSolver>();
+    SymplecticEulerSolverPtr solverParticle = std::make_shared<SymplecticEulerSolver>();
     systemParticle->setSolver(solverParticle);
     systemParticle->setDt(0.01);
 
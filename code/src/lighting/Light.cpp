@@ -70,57 +70,12 @@ void DirectionalLight::setSpecular(const glm::vec3 &specular)
     m_specular = specular;
 }
 
-bool DirectionalLight::sendToGPU(const ShaderProgramPtr& program, const DirectionalLightPtr& light)
+void DirectionalLight::writeBlock(DirectionalLightBlock& block) const
 {
-    bool success = true;
-    int location = -1;
-
-    if(program==nullptr || light==nullptr)
-    {
-        return false;
-    }
-
-    location = program->getUniformLocation(light->lightName()+"."+light->directionName());
-    if(location!=ShaderProgram::null_location)
-    {
-        glcheck(glUniform3fv(location, 1, glm::value_ptr(light->direction())));
-    }
-    else
-    {
-        success = false;
-    }
-
-    location = program->getUniformLocation(light->lightName()+"."+light->ambientName());
-    if(location!=ShaderProgram::null_location)
-    {
-        glcheck(glUniform3fv(location, 1, glm::value_ptr(light->ambient())));
-    }
-    else
-    {
-        success = false;
-    }
-
-    location = program->getUniformLocation(light->lightName()+"."+light->diffuseName());
-    if(location!=ShaderProgram::null_location)
-    {
-        glcheck(glUniform3fv(location, 1, glm::value_ptr(light->diffuse())));
-    }
-    else
-    {
-        success = false;
-    }
-
-    location = program->getUniformLocation(light->lightName()+"."+light->specularName());
-    if(location!=ShaderProgram::null_location)
-    {
-        glcheck(glUniform3fv(location, 1, glm::value_ptr(light->specular())));
-    }
-    else
-    {
-        success = false;
-    }
-
-    return success;
+    block.direction = m_direction;
+    block.ambient = m_ambient;
+    block.diffuse = m_diffuse;
+    block.specular = m_specular;
 }
 
 PointLight::~PointLight()
@@ -232,188 +187,29 @@ void PointLight::setQuadratic(float quadratic)
     m_quadratic = quadratic;
 }
 
-bool PointLight::sendToGPU(const ShaderProgramPtr& program, const PointLightPtr& light)
+void PointLight::writeBlock(PointLightBlock& block) const
 {
-    bool success = true;
-    int location = -1;
-
-    if(program==nullptr || light==nullptr)
-    {
-        return false;
-    }
-
-    location = program->getUniformLocation(light->lightName()+"."+light->positionName());
-    if(location!=ShaderProgram::null_location)
-    {
-        glcheck(glUniform3fv(location, 1, glm::value_ptr(light->position())));
-    }
-    else
-    {
-        success = false;
-    }
-
-    location = program->getUniformLocation(light->lightName()+"."+light->ambientName());
-    if(location!=ShaderProgram::null_location)
-    {
-        glcheck(glUniform3fv(location, 1, glm::value_ptr(light->ambient())));
-    }
-    else
-    {
-        success = false;
-    }
-
-    location = program->getUniformLocation(light->lightName()+"."+light->diffuseName());
-    if(location!=ShaderProgram::null_location)
-    {
-        glcheck(glUniform3fv(location, 1, glm::value_ptr(light->diffuse())));
-    }
-    else
-    {
-        success = false;
-    }
-
-    location = program->getUniformLocation(light->lightName()+"."+light->specularName());
-    if(location!=ShaderProgram::null_location)
-    {
-        glcheck(glUniform3fv(location, 1, glm::value_ptr(light->specular())));
-    }
-    else
-    {
-        success = false;
-    }
-
-    location = program->getUniformLocation(light->lightName()+"."+light->constantName());
-    if(location!=ShaderProgram::null_location)
-    {
-        glcheck(glUniform1f(location, light->constant()));
-    }
-    else
-    {
-        success = false;
-    }
-
-    location = program->getUniformLocation(light->lightName()+"."+light->linearName());
-    if(location!=ShaderProgram::null_location)
-    {
-        glcheck(glUniform1f(location, light->linear()));
-    }
-    else
-    {
-        success = false;
-    }
-
-    location = program->getUniformLocation(light->lightName()+"."+light->quadraticName());
-    if(location!=ShaderProgram::null_location)
-    {
-        glcheck(glUniform1f(location, light->quadratic()));
-    }
-    else
-    {
-        success = false;
-    }
-
-    return success;
+    block.position = m_position;
+    block.ambient = m_ambient;
+    block.diffuse = m_diffuse;
+    block.specular = m_specular;
+    block.constant = m_constant;
+    block.linear = m_linear;
+    block.quadratic = m_quadratic;
 }
 
 
-bool PointLight::sendToGPU(const ShaderProgramPtr& program, const std::vector<PointLightPtr>& lights)
+void PointLight::writeBlock(LightsBlock& block, const std::vector<PointLightPtr>& lights)
 {
-    bool success = true;
-    int location = -1;
-
-    if(program==nullptr || lights.empty())
+    int count = 0;
+    for(size_t i=0; i<lights.size() && count<MAX_NR_POINT_LIGHTS; ++i)
     {
-        return false;
-    }
-
-    for(size_t i=0; i<lights.size(); ++i)
-    {
-        if(lights[i]==nullptr)
-        {
-            return false;
-        }
-
-        location = program->getUniformLocation(lights[i]->numberOfLightsName());
-        if(location!=ShaderProgram::null_location)
-        {
-            glcheck(glUniform1i(location, (int)lights.size()));
-        }
-        else
-        {
-            success = false;
-        }
-
-        location = program->getUniformLocation(lights[i]->lightName()+std::string("[")+std::to_string(i)+std::string("]")+"."+lights[i]->positionName());
-        if(location!=ShaderProgram::null_location)
-        {
-            glcheck(glUniform3fv(location, 1, glm::value_ptr(lights[i]->position())));
-        }
-        else
-        {
-            success = false;
-        }
-
-        location = program->getUniformLocation(lights[i]->lightName()+std::string("[")+std::to_string(i)+std::string("]")+"."+lights[i]->ambientName());
-        if(location!=ShaderProgram::null_location)
+        if(lights[i]!=nullptr)
         {
-            glcheck(glUniform3fv(location, 1, glm::value_ptr(lights[i]->ambient())));
-        }
-        else
-        {
-            success = false;
-        }
-
-        location = program->getUniformLocation(lights[i]->lightName()+std::string("[")+std::to_string(i)+std::string("]")+"."+lights[i]->diffuseName());
-        if(location!=ShaderProgram::null_location)
-        {
-            glcheck(glUniform3fv(location, 1, glm::value_ptr(lights[i]->diffuse())));
-        }
-        else
-        {
-            success = false;
-        }
-
-        location = program->getUniformLocation(lights[i]->lightName()+std::string("[")+std::to_string(i)+std::string("]")+"."+lights[i]->specularName());
-        if(location!=ShaderProgram::null_location)
-        {
-            glcheck(glUniform3fv(location, 1, glm::value_ptr(lights[i]->specular())));
-        }
-        else
-        {
-            success = false;
-        }
-
-        location = program->getUniformLocation(lights[i]->lightName()+std::string("[")+std::to_string(i)+std::string("]")+"."+lights[i]->constantName());
-        if(location!=ShaderProgram::null_location)
-        {
-            glcheck(glUniform1f(location, lights[i]->constant()));
-        }
-        else
-        {
-            success = false;
-        }
-
-        location = program->getUniformLocation(lights[i]->lightName()+std::string("[")+std::to_string(i)+std::string("]")+"."+lights[i]->linearName());
-        if(location!=ShaderProgram::null_location)
-        {
-            glcheck(glUniform1f(location, lights[i]->linear()));
-        }
-        else
-        {
-            success = false;
-        }
-
-        location = program->getUniformLocation(lights[i]->lightName()+std::string("[")+std::to_string(i)+std::string("]")+"."+lights[i]->quadraticName());
-        if(location!=ShaderProgram::null_location)
-        {
-            glcheck(glUniform1f(location, lights[i]->quadratic()));
-        }
-        else
-        {
-            success = false;
+            lights[i]->writeBlock(block.pointLight[count++]);
         }
     }
-    return success;
+    block.numberOfPointLight = count;
 }
 
 SpotLight::~SpotLight()
@@ -566,245 +362,29 @@ void SpotLight::setOuterCutOff(float outerCutOff)
     m_outerCutOff = outerCutOff;
 }
 
-bool SpotLight::sendToGPU(const ShaderProgramPtr& program, const SpotLightPtr& light)
+void SpotLight::writeBlock(SpotLightBlock& block) const
 {
-    bool success = true;
-    int location = -1;
-
-    if(program==nullptr || light==nullptr)
-    {
-        return false;
-    }
-
-    location = program->getUniformLocation(light->lightName()+"."+light->positionName());
-    if(location!=ShaderProgram::null_location)
-    {
-        glcheck(glUniform3fv(location, 1, glm::value_ptr(light->position())));
-    }
-    else
-    {
-        success = false;
-    }
-
-    location = program->getUniformLocation(light->lightName()+"."+light->spotDirectionName());
-    if(location!=ShaderProgram::null_location)
-    {
-        glcheck(glUniform3fv(location, 1, glm::value_ptr(light->spotDirection())));
-    }
-    else
-    {
-        success = false;
-    }
-
-    location = program->getUniformLocation(light->lightName()+"."+light->ambientName());
-    if(location!=ShaderProgram::null_location)
-    {
-        glcheck(glUniform3fv(location, 1, glm::value_ptr(light->ambient())));
-    }
-    else
-    {
-        success = false;
-    }
-
-    location = program->getUniformLocation(light->lightName()+"."+light->diffuseName());
-    if(location!=ShaderProgram::null_location)
-    {
-        glcheck(glUniform3fv(location, 1, glm::value_ptr(light->diffuse())));
-    }
-    else
-    {
-        success = false;
-    }
-
-    location = program->getUniformLocation(light->lightName()+"."+light->specularName());
-    if(location!=ShaderProgram::null_location)
-    {
-        glcheck(glUniform3fv(location, 1, glm::value_ptr(light->specular())));
-    }
-    else
-    {
-        success = false;
-    }
-
-    location = program->getUniformLocation(light->lightName()+"."+light->constantName());
-    if(location!=ShaderProgram::null_location)
-    {
-        glcheck(glUniform1f(location, light->constant()));
-    }
-    else
-    {
-        success = false;
-    }
-
-    location = program->getUniformLocation(light->lightName()+"."+light->linearName());
-    if(location!=ShaderProgram::null_location)
-    {
-        glcheck(glUniform1f(location, light->linear()));
-    }
-    else
-    {
-        success = false;
-    }
-
-    location = program->getUniformLocation(light->lightName()+"."+light->quadraticName());
-    if(location!=ShaderProgram::null_location)
-    {
-        glcheck(glUniform1f(location, light->quadratic()));
-    }
-    else
-    {
-        success = false;
-    }
-
-    location = program->getUniformLocation(light->lightName()+"."+light->innerCutOffName());
-    if(location!=ShaderProgram::null_location)
-    {
-        glcheck(glUniform1f(location, light->innerCutOff()));
-    }
-    else
-    {
-        success = false;
-    }
-
-    location = program->getUniformLocation(light->lightName()+"."+light->outerCutOffName());
-    if(location!=ShaderProgram::null_location)
-    {
-        glcheck(glUniform1f(location, light->outerCutOff()));
-    }
-    else
-    {
-        success = false;
-    }
-
-    return success;
+    block.position = m_position;
+    block.spotDirection = m_spotDirection;
+    block.ambient = m_ambient;
+    block.diffuse = m_diffuse;
+    block.specular = m_specular;
+    block.constant = m_constant;
+    block.linear = m_linear;
+    block.quadratic = m_quadratic;
+    block.innerCutOff = m_innerCutOff;
+    block.outerCutOff = m_outerCutOff;
 }
 
-bool SpotLight::sendToGPU(const ShaderProgramPtr& program, const std::vector<SpotLightPtr>& lights)
+void SpotLight::writeBlock(LightsBlock& block, const std::vector<SpotLightPtr>& lights)
 {
-    bool success = true;
-    int location = -1;
-
-    if(program==nullptr || lights.empty())
-    {
-        return false;
-    }
-
-    for(size_t i=0; i<lights.size(); ++i)
+    int count = 0;
+    for(size_t i=0; i<lights.size() && count<MAX_NR_SPOT_LIGHTS; ++i)
     {
-        if(lights[i]==nullptr)
-        {
-            return false;
-        }
-
-        location = program->getUniformLocation(lights[i]->numberOfLightsName());
-        if(location!=ShaderProgram::null_location)
-        {
-            glcheck(glUniform1i(location, (int)lights.size()));
-        }
-        else
-        {
-            success = false;
-        }
-
-        location = program->getUniformLocation(lights[i]->lightName()+std::string("[")+std::to_string(i)+std::string("]")+"."+lights[i]->positionName());
-        if(location!=ShaderProgram::null_location)
-        {
-            glcheck(glUniform3fv(location, 1, glm::value_ptr(lights[i]->position())));
-        }
-        else
-        {
-            success = false;
-        }
-
-        location = program->getUniformLocation(lights[i]->lightName()+std::string("[")+std::to_string(i)+std::string("]")+"."+lights[i]->spotDirectionName());
-        if(location!=ShaderProgram::null_location)
-        {
-            glcheck(glUniform3fv(location, 1, glm::value_ptr(lights[i]->spotDirection())));
-        }
-        else
-        {
-            success = false;
-        }
-
-        location = program->getUniformLocation(lights[i]->lightName()+std::string("[")+std::to_string(i)+std::string("]")+"."+lights[i]->ambientName());
-        if(location!=ShaderProgram::null_location)
-        {
-            glcheck(glUniform3fv(location, 1, glm::value_ptr(lights[i]->ambient())));
-        }
-        else
-        {
-            success = false;
-        }
-
-        location = program->getUniformLocation(lights[i]->lightName()+std::string("[")+std::to_string(i)+std::string("]")+"."+lights[i]->diffuseName());
-        if(location!=ShaderProgram::null_location)
-        {
-            glcheck(glUniform3fv(location, 1, glm::value_ptr(lights[i]->diffuse())));
-        }
-        else
-        {
-            success = false;
-        }
-
-        location = program->getUniformLocation(lights[i]->lightName()+std::string("[")+std::to_string(i)+std::string("]")+"."+lights[i]->specularName());
-        if(location!=ShaderProgram::null_location)
-        {
-            glcheck(glUniform3fv(location, 1, glm::value_ptr(lights[i]->specular())));
-        }
-        else
-        {
-            success = false;
-        }
-
-        location = program->getUniformLocation(lights[i]->lightName()+std::string("[")+std::to_string(i)+std::string("]")+"."+lights[i]->constantName());
-        if(location!=ShaderProgram::null_location)
-        {
-            glcheck(glUniform1f(location, lights[i]->constant()));
-        }
-        else
-        {
-            success = false;
-        }
-
-        location = program->getUniformLocation(lights[i]->lightName()+std::string("[")+std::to_string(i)+std::string("]")+"."+lights[i]->linearName());
-        if(location!=ShaderProgram::null_location)
-        {
-            glcheck(glUniform1f(location, lights[i]->linear()));
-        }
-        else
-        {
-            success = false;
-        }
-
-        location = program->getUniformLocation(lights[i]->lightName()+std::string("[")+std::to_string(i)+std::string("]")+"."+lights[i]->quadraticName());
-        if(location!=ShaderProgram::null_location)
-        {
-            glcheck(glUniform1f(location, lights[i]->quadratic()));
-        }
-        else
-        {
-            success = false;
-        }
-
-        location = program->getUniformLocation(lights[i]->lightName()+std::string("[")+std::to_string(i)+std::string("]")+"."+lights[i]->innerCutOffName());
-        if(location!=ShaderProgram::null_location)
-        {
-            glcheck(glUniform1f(location, lights[i]->innerCutOff()));
-        }
-        else
-        {
-            success = false;
-        }
-
-        location = program->getUniformLocation(lights[i]->lightName()+std::string("[")+std::to_string(i)+std::string("]")+"."+lights[i]->outerCutOffName());
-        if(location!=ShaderProgram::null_location)
-        {
-            glcheck(glUniform1f(location, lights[i]->outerCutOff()));
-        }
-        else
+        if(lights[i]!=nullptr)
         {
-            success = false;
+            lights[i]->writeBlock(block.spotLight[count++]);
         }
     }
-    return success;
+    block.numberOfSpotLight = count;
 }
@@ -5,6 +5,7 @@ Material::~Material()
 {}
 
 Material::Material()
+    : m_dirty(true)
 {
     m_ambient = glm::vec3(0.0,0.0,0.0);
     m_diffuse = glm::vec3(0.0,0.0,0.0);
@@ -13,6 +14,7 @@ Material::Material()
 }
 
 Material::Material(const glm::vec3& ambient, const glm::vec3& diffuse, const glm::vec3& specular, const float &shininess)
+    : m_dirty(true)
 {
     m_ambient = ambient;
     m_diffuse = diffuse;
@@ -21,6 +23,7 @@ Material::Material(const glm::vec3& ambient, const glm::vec3& diffuse, const glm
 }
 
 Material::Material(const Material& material)
+    : m_dirty(true)
 {
     m_ambient = material.m_ambient;
     m_diffuse = material.m_diffuse;
@@ -28,6 +31,16 @@ Material::Material(const Material& material)
     m_shininess = material.m_shininess;
 }
 
+Material& Material::operator=(const Material& material)
+{
+    m_ambient = material.m_ambient;
+    m_diffuse = material.m_diffuse;
+    m_specular = material.m_specular;
+    m_shininess = material.m_shininess;
+    m_dirty = true;
+    return *this;
+}
+
 const glm::vec3& Material::ambient() const
 {
     return m_ambient;
@@ -36,6 +49,7 @@ const glm::vec3& Material::ambient() const
 void Material::setAmbient(const glm::vec3 &ambient)
 {
     m_ambient = ambient;
+    m_dirty = true;
 }
 
 const glm::vec3& Material::diffuse() const
@@ -46,6 +60,7 @@ const glm::vec3& Material::diffuse() const
 void Material::setDiffuse(const glm::vec3 &diffuse)
 {
     m_diffuse = diffuse;
+    m_dirty = true;
 }
 
 const glm::vec3& Material::specular() const
@@ -56,11 +71,13 @@ const glm::vec3& Material::specular() const
 void Material::setSpecular(const glm::vec3 &specular)
 {
     m_specular = specular;
+    m_dirty = true;
 }
 
 void Material::setShininess(float shininess)
 {
     m_shininess = shininess;
+    m_dirty = true;
 }
 
 const float &Material::shininess() const
@@ -70,55 +87,29 @@ const float &Material::shininess() const
 
 bool Material::sendToGPU(const ShaderProgramPtr& program, const MaterialPtr &material)
 {
-    bool success = true;
-    int location = -1;
-
     if(program==nullptr || material==nullptr)
     {
         return false;
     }
 
-    location = program->getUniformLocation("material.ambient");
-    if(location!=ShaderProgram::null_location)
-    {
-        glcheck(glUniform3fv(location, 1, glm::value_ptr(material->ambient())));
-    }
-    else
-    {
-        success = false;
-    }
-
-    location = program->getUniformLocation("material.diffuse");
-    if(location!=ShaderProgram::null_location)
-    {
-        glcheck(glUniform3fv(location, 1, glm::value_ptr(material->diffuse())));
-    }
-    else
+    if(!material->m_buffer)
     {
-        success = false;
+        material->m_buffer.reset(new UniformBuffer());
     }
 
-    location = program->getUniformLocation("material.specular");
-    if(location!=ShaderProgram::null_location)
-    {
-        glcheck(glUniform3fv(location, 1, glm::value_ptr(material->specular())));
-    }
-    else
-    {
-        success = false;
-    }
-
-    location = program->getUniformLocation("material.shininess");
-    if(location!=ShaderProgram::null_location)
-    {
-        glcheck(glUniform1f(location, material->shininess()));
-    }
-    else
+    if(material->m_dirty)
     {
-        success = false;
+        MaterialBlock block;
+        block.ambient = material->m_ambient;
+        block.diffuse = material->m_diffuse;
+        block.specular = material->m_specular;
+        block.shininess = material->m_shininess;
+        material->m_buffer->update(&block, sizeof(MaterialBlock));
+        material->m_dirty = false;
     }
 
-    return success;
+    material->m_buffer->bind(MATERIAL_BLOCK_BINDING);
+    return true;
 }
 
 MaterialPtr Material::Pearl()
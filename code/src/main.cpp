@@ -1,8 +1,10 @@
 #include "../include/Viewer.hpp"
 #include "../include/log.hpp"
+#include "../include/Profiler.hpp"
 
 #include <glm/glm.hpp>
 #include <iostream>
+#include <cstring>
 #include <sstream>
 #include <vector>
 
@@ -12,7 +14,16 @@
 int main( int argc, char* argv[] )
 {
     std::srand(std::time(0));
-    Viewer viewer(1280,720);
+    Profiler::setThreadName("main");
+
+    /*
+     * With the --profile option, the CPU profile of the last frames and the
+     * frame time statistics are exported at exit, see Profiler and FPSCounter.
+     */
+    bool profileAtExit = false;
+    for (int i = 1; i < argc; ++i) {
+        profileAtExit = profileAtExit || std::strcmp(argv[i], "--profile") == 0;
+    }
 
     /*
      * Parsing the JSon file containing the simulation parameters for the map.
@@ -25,6 +36,13 @@ int main( int argc, char* argv[] )
     MapGenerator mapGenerator(mapParameters, mapParameters.getMapSize());
     mapGenerator.compute();
 
+    /*
+     * The viewer is destroyed first, with its renderables: the boids keep
+     * being simulated on their own thread until then, so the map they walk
+     * on must outlive it.
+     */
+    Viewer viewer(1280,720);
+
 	/*
 		Setting the pointer on the "mapGenerator" inside the viewer.
 	*/
@@ -40,5 +58,10 @@ int main( int argc, char* argv[] )
     	viewer.display();
     }
 
+    if (profileAtExit) {
+        Profiler::exportChromeTrace("profile.json");
+        viewer.getFPSCounter().exportCSV("frametimes.csv");
+    }
+
     return EXIT_SUCCESS;
 }
@@ -0,0 +1,41 @@
+#include "./../../include/structures/DisjointSets.hpp"
+
+DisjointSets::DisjointSets(std::size_t size)
+  : m_parents(size), m_ranks(size, 0)
+{
+  for (std::size_t i = 0; i < size; ++i) {
+    m_parents[i] = (int) i;
+  }
+}
+
+int DisjointSets::find(int element)
+{
+  while (m_parents[element] != element) {
+    m_parents[element] = m_parents[m_parents[element]];
+    element = m_parents[element];
+  }
+  return element;
+}
+
+void DisjointSets::unite(int a, int b)
+{
+  a = find(a);
+  b = find(b);
+  if (a == b) {
+    return;
+  }
+
+  if (m_ranks[a] < m_ranks[b]) {
+    m_parents[a] = b;
+  } else if (m_ranks[a] > m_ranks[b]) {
+    m_parents[b] = a;
+  } else {
+    m_parents[b] = a;
+    m_ranks[a]++;
+  }
+}
+
+std::size_t DisjointSets::size() const
+{
+  return m_parents.size();
+}
@@ -143,8 +143,7 @@ void computeLand(
 
 void computeLake(
     MapParameters& parameters, 
-    std::vector<Seed>& seeds,
-    std::vector<glm::vec2>& lakes
+    std::vector<Seed>& seeds
 ) 
 {
     // Plains that are surrounded by land can turn into a lake
@@ -201,11 +200,6 @@ void computeLake(
 			&&  ((random(0.0, 1.0)) <= (parameters.getLakeProbTransform() + probOffset))
 		) {
 			currentSeedIt->setBiome(Lake);
-			lakes.push_back(glm::vec2(
-								currentSeedIt->getCentroidX(),
-								currentSeedIt->getCentroidY()
-							)
-			);
 		}
     }
 
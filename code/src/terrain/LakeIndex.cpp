@@ -0,0 +1,175 @@
+/**
+ * @file LakeIndex.cpp
+ *
+ * @see LakeIndex.hpp
+ */
+
+#include "../../include/terrain/LakeIndex.hpp"
+#include "../../include/terrain/MapUtils.hpp"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+LakeIndex::LakeIndex()
+    : m_lakes(NULL), m_bucketSize(1.0f), m_bucketCount(0),
+      m_fieldSize(0), m_fieldScaling(1.0f)
+{}
+
+void LakeIndex::build(
+    const std::vector<glm::vec2>& lakes,
+    const Biome* biomeMap,
+    int effMapSize,
+    int mapScaling
+)
+{
+    m_lakes = &lakes;
+    m_fieldSize = effMapSize;
+    m_fieldScaling = (float) mapScaling;
+    m_bucketStarts.clear();
+    m_bucketLakes.clear();
+    m_closestLakes.clear();
+    m_closestShores.clear();
+    if (lakes.empty() || effMapSize <= 0) {
+        m_bucketCount = 0;
+        return;
+    }
+
+    /*
+     * Sorting the centroids into buckets, about one per bucket, by a
+     * counting sort.
+     */
+    float mapLength = (float) effMapSize / m_fieldScaling;
+    m_bucketCount = std::max(1, (int) std::ceil(std::sqrt((float) lakes.size())));
+    m_bucketSize = mapLength / (float) m_bucketCount;
+
+    int lakeCount = (int) lakes.size();
+    std::vector<int> lakeBuckets(lakeCount);
+    m_bucketStarts.assign(m_bucketCount*m_bucketCount + 1, 0);
+    for (int l = 0; l < lakeCount; l++) {
+        int bi = glm::clamp((int) std::floor(lakes[l].x / m_bucketSize), 0, m_bucketCount - 1);
+        int bj = glm::clamp((int) std::floor(lakes[l].y / m_bucketSize), 0, m_bucketCount - 1);
+        lakeBuckets[l] = bi + bj*m_bucketCount;
+        m_bucketStarts[lakeBuckets[l] + 1]++;
+    }
+    for (int b = 0; b < m_bucketCount*m_bucketCount; b++) {
+        m_bucketStarts[b + 1] += m_bucketStarts[b];
+    }
+    std::vector<int> bucketEnds(m_bucketStarts.begin(), m_bucketStarts.end() - 1);
+    m_bucketLakes.resize(lakeCount);
+    for (int l = 0; l < lakeCount; l++) {
+        m_bucketLakes[bucketEnds[lakeBuckets[l]]++] = l;
+    }
+
+    /*
+     * Rasterising the Voronoi diagram of the centroids, each texel being
+     * independent.
+     */
+    int texelCount = effMapSize*effMapSize;
+    m_closestLakes.resize(texelCount);
+    #pragma omp parallel for
+    for (int j = 0; j < effMapSize; j++) {
+        for (int i = 0; i < effMapSize; i++) {
+            m_closestLakes[i + j*effMapSize] = searchBuckets(glm::vec2(i, j) / m_fieldScaling);
+        }
+    }
+
+    /*
+     * Distance transform of the Lake texels.
+     */
+    std::vector<char> lakeTexels(texelCount);
+    for (int t = 0; t < texelCount; t++) {
+        lakeTexels[t] = (biomeMap[t] == Lake);
+    }
+    computeClosestTexels(lakeTexels, effMapSize, m_closestShores);
+}
+
+bool LakeIndex::closestLake(float x, float y, glm::vec2& lake) const
+{
+    if (m_bucketCount == 0) {
+        return false;
+    }
+
+    /*
+     * The field covers the map only: beyond, the buckets are searched.
+     */
+    float mapLength = (float) m_fieldSize / m_fieldScaling;
+    int closest;
+    if (x < 0.0f || y < 0.0f || x > mapLength || y > mapLength) {
+        closest = searchBuckets(glm::vec2(x, y));
+    } else {
+        closest = m_closestLakes[texel(x, y)];
+    }
+    lake = (*m_lakes)[closest];
+    return true;
+}
+
+bool LakeIndex::closestShore(float x, float y, glm::vec2& shore, float& distance) const
+{
+    if (m_closestShores.empty()) {
+        return false;
+    }
+
+    int t = texel(x, y);
+    int closest = m_closestShores[t];
+    if (closest < 0) {
+        return false;
+    }
+
+    shore = glm::vec2(closest % m_fieldSize, closest / m_fieldSize) / m_fieldScaling;
+    distance = (closest == t) ? 0.0f : glm::length(shore - glm::vec2(x, y));
+    return true;
+}
+
+int LakeIndex::searchBuckets(const glm::vec2& position) const
+{
+    if (m_bucketCount == 0) {
+        return -1;
+    }
+
+    /*
+     * The buckets are visited by rings of increasing distance around the
+     * bucket of the position, clamped to the map. A bucket of the ring r is
+     * at least (r - 1) buckets away, even from a position beyond the map:
+     * the search stops once this bound exceeds the closest distance found.
+     */
+    int bi = glm::clamp((int) std::floor(position.x / m_bucketSize), 0, m_bucketCount - 1);
+    int bj = glm::clamp((int) std::floor(position.y / m_bucketSize), 0, m_bucketCount - 1);
+    int closest = -1;
+    float closestDistance2 = FLT_MAX;
+
+    for (int r = 0; r < m_bucketCount; r++) {
+        float bound = (float) (r - 1) * m_bucketSize;
+        if (closest >= 0 && bound > 0.0f && bound*bound > closestDistance2) {
+            break;
+        }
+
+        for (int nj = std::max(bj - r, 0); nj <= std::min(bj + r, m_bucketCount - 1); nj++) {
+            // Only the border of the ring is new
+            bool borderRow = (nj == bj - r) || (nj == bj + r);
+            int step = borderRow ? 1 : 2*r;
+            for (int ni = bi - r; ni <= bi + r; ni += std::max(step, 1)) {
+                if (ni < 0 || ni >= m_bucketCount) {
+                    continue;
+                }
+                int bucket = ni + nj*m_bucketCount;
+                for (int e = m_bucketStarts[bucket]; e < m_bucketStarts[bucket + 1]; e++) {
+                    glm::vec2 offset = (*m_lakes)[m_bucketLakes[e]] - position;
+                    float distance2 = glm::dot(offset, offset);
+                    if (distance2 < closestDistance2) {
+                        closestDistance2 = distance2;
+                        closest = m_bucketLakes[e];
+                    }
+                }
+            }
+        }
+    }
+    return closest;
+}
+
+int LakeIndex::texel(float x, float y) const
+{
+    int i = glm::clamp((int) (x*m_fieldScaling + 0.5f), 0, m_fieldSize - 1);
+    int j = glm::clamp((int) (y*m_fieldScaling + 0.5f), 0, m_fieldSize - 1);
+    return i + j*m_fieldSize;
+}
@@ -11,7 +11,7 @@
 #include "./../../include/log.hpp"
 #include "./../../include/Utils.hpp"
 #include "./../../include/terrain/MapUtils.hpp"
-#include "./../../include/texturing/TexUtils.hpp"
+#include "./../../include/AssetManager.hpp"
 
 #include <cfloat>
 #include <glm/gtc/matrix_transform.hpp>
@@ -23,12 +23,7 @@
 
 LakeRenderable::LakeRenderable(
     ShaderProgramPtr shaderProgram,
-    std::list<
-        std::pair<
-            std::vector<int>, 
-            std::vector<glm::vec3> 
-        >
-    >& lakesTriangles
+    const std::vector<ConnexLake>& lakesTriangles
 )
     :   HierarchicalRenderable(shaderProgram),
         m_positions(0)
@@ -46,16 +41,19 @@ LakeRenderable::LakeRenderable(
          * So as to set the altitude of the lake coherently, we compute the
          * average altitude of the vertices constituting the connexe lakes.
          */
+        if (globalIt->triangles.empty()) {
+            continue;
+        }
         float averageAltitude = 0.0;
         for (
-            auto localIt = globalIt->second.begin();
-            localIt != globalIt->second.end();
+            auto localIt = globalIt->triangles.begin();
+            localIt != globalIt->triangles.end();
             localIt++
         )
         {
             averageAltitude += localIt->z;
         }
-        averageAltitude /= (float)(globalIt->second.size());
+        averageAltitude /= (float)(globalIt->triangles.size());
         
         /*
          * If the average altitude is below the sea altitude, we slightly
@@ -66,8 +64,8 @@ LakeRenderable::LakeRenderable(
         //}
 
         for (
-            auto localIt = globalIt->second.begin();
-            localIt != globalIt->second.end();
+            auto localIt = globalIt->triangles.begin();
+            localIt != globalIt->triangles.end();
             localIt++
         )
         {
@@ -103,7 +101,7 @@ LakeRenderable::LakeRenderable(
     for (int i = minRes; i <= maxRes; ++i) {
         filenames.push_back(name + std::to_string(i) + extension);
     }
-    sendMipMapTextures(filenames, &m_textureId);
+    m_texture = AssetManager::getMipMapTexture(filenames);
 }
 
 LakeRenderable::~LakeRenderable()
@@ -121,16 +119,16 @@ void LakeRenderable::do_draw()
      */
 
     // Position.
-    int positionLocation        = m_shaderProgram->getAttributeLocation("coord");
+    int positionLocation        = m_shaderProgram->getAttributeLocation(SHADER_VARIABLE("coord"));
 
      // Model matrix.
-    int modelLocation           = m_shaderProgram->getUniformLocation("modelMat");
+    int modelLocation           = m_shaderProgram->getUniformLocation(SHADER_VARIABLE("modelMat"));
 
     // The texture scale parameter.
-    int scaleTextureLocation    = m_shaderProgram->getUniformLocation("scaleTexture");
+    int scaleTextureLocation    = m_shaderProgram->getUniformLocation(SHADER_VARIABLE("scaleTexture"));
 
     // Texture.
-    int lakeTextureLocation     = m_shaderProgram->getUniformLocation("seaTex"); 
+    int lakeTextureLocation     = m_shaderProgram->getUniformLocation(SHADER_VARIABLE("seaTex")); 
 
 
     /*
@@ -184,7 +182,7 @@ void LakeRenderable::do_draw()
     if (lakeTextureLocation != ShaderProgram::null_location)
 	{
         glcheck(glActiveTexture(GL_TEXTURE0));
-        glcheck(glBindTexture(GL_TEXTURE_2D, m_textureId));
+        glcheck(glBindTexture(GL_TEXTURE_2D, m_texture->getId()));
         glcheck(glUniform1i(lakeTextureLocation, 0)); 
 	}
     
@@ -214,3 +212,13 @@ void LakeRenderable::do_animate( float time )
 void LakeRenderable::setMaterial(const MaterialPtr& material) {
     m_material = material;
 }
+
+unsigned int LakeRenderable::do_getTextureKey() const
+{
+    return m_texture->getId();
+}
+
+unsigned int LakeRenderable::do_getMeshKey() const
+{
+    return m_pBuffer;
+}
@@ -40,12 +40,21 @@
 #include "../../include/terrain/MapParser.hpp"
 #include "../../include/terrain/MapUtils.hpp"
 #include "../../include/terrain/Seed.hpp"
+#include "../../include/structures/DisjointSets.hpp"
+#include "../../include/Profiler.hpp"
 
 #include <ctime>
 #include <fstream>
 #include <iostream>
 #include <string>
 
+/**
+ * @brief
+ * The height difference per unit of length beyond which the boids do not
+ * walk: 2 meters over their usual look-ahead distance of 2.5 meters.
+ */
+#define MAX_WALKABLE_SLOPE 0.8f
+
 MapGenerator::MapGenerator(MapParameters& parameters, float size) :
     m_mapParameters(parameters),
     mapSize{ size },
@@ -86,6 +95,8 @@ MapGenerator::~MapGenerator()
 
 
 void MapGenerator::compute() {
+    PROFILE_SCOPE("MapGenerator::compute");
+    ProfileScope phase("MapGenerator::compute seeds");
 
     // Position Generation
     /*
@@ -152,6 +163,7 @@ void MapGenerator::compute() {
 		voronoiSeedsGenerator.generateSeeds(seeds);
 	}
     // Voronoi step
+    phase.next("MapGenerator::compute voronoi");
     /*
      * Adding all the seeds to the container so as to generate Voronoi
      * diagram.
@@ -204,6 +216,7 @@ void MapGenerator::compute() {
     }
 
     // Biome step
+    phase.next("MapGenerator::compute biomes");
 	/*
 		If the seeds' data are importerd, this step has to be shunted.
 	*/
@@ -218,10 +231,15 @@ void MapGenerator::compute() {
 		computeMountains(m_mapParameters, seeds);
 
 		// Adding the lakes
-		computeLake(m_mapParameters, seeds, m_lakes);
+		computeLake(m_mapParameters, seeds);
 	}
 
+	// Grouping the lakes, whether their biomes were computed or imported
+	phase.next("MapGenerator::compute lakes");
+	computeLakeComponents();
 
+
+	phase.next("MapGenerator::compute height tree");
 	if (!m_mapParameters.getImportingHeightmap()) {
 		// HeightTree step
 		// Creating the initial map : a deep dark sea
@@ -238,6 +256,7 @@ void MapGenerator::compute() {
 	}
     
     // Biome map and height map
+    phase.next("MapGenerator::compute sampled maps");
     // These sampled maps are used to accelerate the search of a biome or of a height associated
     // to a position, altough the result is obviously approximative
     // Filling the biome map and the height map
@@ -320,6 +339,13 @@ void MapGenerator::compute() {
 			}
 		}
 	}
+
+	// Indexing the lakes, now that the biome map is known
+	phase.next("MapGenerator::compute boids fields");
+	m_lakeIndex.build(m_lakes, biomeMap, effMapSize, heightmapScaling);
+
+	// Steering the boids from the sampled maps
+	m_steeringField.build(biomeMap, heightMap, effMapSize, heightmapScaling, MAX_WALKABLE_SLOPE);
 }
 
 // To ensure that voro++ does not raise an exception, we
@@ -417,7 +443,87 @@ bool MapGenerator::getClosestLake(
     float& yLake
 )
 {
-    return findClosestLake(m_lakes, x, y, xLake, yLake);
+    glm::vec2 lake;
+    if (m_lakeIndex.closestLake(x, y, lake)) {
+        xLake = lake.x;
+        yLake = lake.y;
+        return true;
+    }
+    return false;
+}
+
+const SteeringField& MapGenerator::getSteeringField() const
+{
+    return m_steeringField;
+}
+
+bool MapGenerator::getClosestLakeShore(
+    float x,
+    float y,
+    float& xShore,
+    float& yShore,
+    float& distance
+) const
+{
+    glm::vec2 shore;
+    if (m_lakeIndex.closestShore(x, y, shore, distance)) {
+        xShore = shore.x;
+        yShore = shore.y;
+        return true;
+    }
+    return false;
+}
+
+int MapGenerator::getLakeComponentCount() const
+{
+    return m_lakeComponentCount;
+}
+
+int MapGenerator::getLakeComponent(int seed) const
+{
+    return m_lakeComponents[seed];
+}
+
+void MapGenerator::computeLakeComponents()
+{
+    int seedCount = (int) seeds.size();
+    DisjointSets lakes(seedCount);
+
+    /*
+     * Each Lake biome is merged with its neighbouring Lake biomes.
+     */
+    m_lakes.clear();
+    std::vector<int> neighbours;
+    for (int s = 0; s < seedCount; s++) {
+        if (seeds[s].getBiome() != Lake) {
+            continue;
+        }
+        m_lakes.push_back(glm::vec2(seeds[s].getCentroidX(), seeds[s].getCentroidY()));
+
+        seeds[s].getCell()->neighbors(neighbours);
+        for (int neighbour : neighbours) {
+            if (neighbour >= 0 && neighbour < seedCount && seeds[neighbour].getBiome() == Lake) {
+                lakes.unite(s, neighbour);
+            }
+        }
+    }
+
+    /*
+     * Numbering the connexe lakes, in the order of their first seed.
+     */
+    std::vector<int> rootComponents(seedCount, -1);
+    m_lakeComponents.assign(seedCount, -1);
+    m_lakeComponentCount = 0;
+    for (int s = 0; s < seedCount; s++) {
+        if (seeds[s].getBiome() != Lake) {
+            continue;
+        }
+        int root = lakes.find(s);
+        if (rootComponents[root] < 0) {
+            rootComponents[root] = m_lakeComponentCount++;
+        }
+        m_lakeComponents[s] = rootComponents[root];
+    }
 }
 
 void MapGenerator::exportMapData()
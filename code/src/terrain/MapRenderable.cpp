@@ -8,7 +8,7 @@
 #include "./../../include/log.hpp"
 #include "./../../include/Utils.hpp"
 #include "./../../include/terrain/MapUtils.hpp"
-#include "./../../include/texturing/TexUtils.hpp"
+#include "./../../include/AssetManager.hpp"
 
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
@@ -16,7 +16,11 @@
 #include <SFML/Graphics/Image.hpp>
 #include <omp.h>
 
+#include <algorithm>
+#include <cmath>
 #include <iostream>
+#include <stdexcept>
+#include <unordered_map>
 
 /**
  * @brief
@@ -30,6 +34,18 @@
     if((x)<0.0) x = 0.0;\
     if((y)<0.0) y = 0.0;
 
+/**
+ * @brief
+ * Convert a blending coefficient in [0, 1] to its 8 bits representation.
+ *
+ * @param coefficient The coefficient to convert.
+ * @return The normalized unsigned byte representing the coefficient.
+ */
+static inline GLubyte toUnorm8(float coefficient)
+{
+    return (GLubyte) (glm::clamp(coefficient, 0.0f, 1.0f)*255.0f + 0.5f);
+}
+
 MapRenderable::MapRenderable(
     ShaderProgramPtr shaderProgram, 
     MapGenerator& mapGenerator
@@ -40,6 +56,21 @@ MapRenderable::MapRenderable(
         m_scaleAltitude(0.0),
         m_mapGenerator(mapGenerator)
 {
+    // Send the textures for the map. They are requested first, so that
+    // they are decoded in the background while the map data is computed.
+    // The layers of the array are, in this order, the sea (ground), the
+    // beach, the plains, the lake, the mountain and the peak textures.
+    const char* biomeNames[6] = { "sand_sea", "sand_beach", "grass", "lake", "mountain", "snow" };
+    std::vector< std::vector<std::string> > chains(6);
+    int minRes = 2;
+    int maxRes = 8;
+    for (int layer = 0; layer < 6; ++layer) {
+        for (int i = minRes; i <= maxRes; ++i) {
+            chains[layer].push_back("../textures/shutter_texture_" + std::string(biomeNames[layer]) + std::to_string(i) + ".png");
+        }
+    }
+    m_biomesTexture = AssetManager::getTextureArray("../textures/shutter_texture_biomes.ktx", chains);
+    m_locations.revision = 0;
 
     // Geometry part : decomposing the voronoi diagram in triangles
     // and sending them
@@ -48,56 +79,6 @@ MapRenderable::MapRenderable(
     // Computing and binding the height map
     sendHeightMap();
 
-    
-    std::vector<std::string> filenames;
-    std::string name;
-    std::string extension = ".png";
-    int minRes = 2;
-    int maxRes = 8;
-    // Send the textures for the map
-    // Sea (ground)
-    name = "../textures/shutter_texture_sand_sea";
-    for (int i = minRes; i <= maxRes; ++i) {
-	filenames.push_back(name + std::to_string(i) + extension);
-    }
-    sendMipMapTextures(filenames, &m_seaTexId);
-    filenames.clear();
-    // Beach
-    name = "../textures/shutter_texture_sand_beach";
-    for (int i = minRes; i <= maxRes; ++i) {
-	filenames.push_back(name + std::to_string(i) + extension);
-    }
-    sendMipMapTextures(filenames, &m_sandTexId);
-    filenames.clear();
-    // Plains
-    name = "../textures/shutter_texture_grass";
-    for (int i = minRes; i <= maxRes; ++i) {
-	filenames.push_back(name + std::to_string(i) + extension);
-    }
-    sendMipMapTextures(filenames, &m_plainsTexId);
-    filenames.clear();
-    // Lake
-    name = "../textures/shutter_texture_lake";
-    for (int i = minRes; i <= maxRes; ++i) {
-	filenames.push_back(name + std::to_string(i) + extension);
-    }    
-    sendMipMapTextures(filenames, &m_lakeTexId);
-    filenames.clear();
-    // Mountain
-    name = "../textures/shutter_texture_mountain";
-    for (int i = minRes; i <= maxRes; ++i) {
-	filenames.push_back(name + std::to_string(i) + extension);
-    }
-    sendMipMapTextures(filenames, &m_mountainTexId);
-    filenames.clear();
-    // Peak
-    name = "../textures/shutter_texture_snow";
-    for (int i = minRes; i <= maxRes; ++i) {
-	filenames.push_back(name + std::to_string(i) + extension);
-    }
-    sendMipMapTextures(filenames, &m_peakTexId);
-    filenames.clear();
-
     // Compute the masks
     sendMasks();
 }
@@ -109,51 +90,75 @@ MapRenderable::~MapRenderable()
      */
     glcheck(glDeleteBuffers(1, &m_positionsBufferID));
     glcheck(glDeleteBuffers(1, &m_texCoordsID));
-    glcheck(glDeleteBuffers(1, &m_heightmapID));
+    glcheck(glDeleteBuffers(1, &m_indicesBufferID));
+    glcheck(glDeleteBuffers(1, &m_patchBoundsID));
+    glcheck(glDeleteTextures(1, &m_patchBoundsTextureID));
+    glcheck(glDeleteTextures(1, &m_heightmapID));
+    glcheck(glDeleteTextures(1, &m_normalMapID));
+    glcheck(glDeleteTextures(1, &m_masksId));
 
 }
 
-void MapRenderable::do_draw()
+void MapRenderable::updateLocations()
 {
-    /*
-     * Drawing geometric data
-     */
+    m_locations.revision          = m_shaderProgram->getRevision();
 
-    // Position
-    int positionLocation        = m_shaderProgram->getAttributeLocation("coord");
-    
-    // TexCoords
-    int texCoordLocation        = m_shaderProgram->getAttributeLocation("texCoord");
+    // Geometry
+    m_locations.position          = m_shaderProgram->getAttributeLocation(SHADER_VARIABLE("coord"));
+    m_locations.texCoord          = m_shaderProgram->getAttributeLocation(SHADER_VARIABLE("texCoord"));
+    m_locations.model             = m_shaderProgram->getUniformLocation(SHADER_VARIABLE("modelMat"));
 
-    // Model matrix
-    int modelLocation           = m_shaderProgram->getUniformLocation("modelMat");
-    
     // Height map
-    int heightmapLocation       = m_shaderProgram->getUniformLocation("heightMap");
-    int heightMinLocation       = m_shaderProgram->getUniformLocation("heightMin");
-    int heightScaleLocation     = m_shaderProgram->getUniformLocation("heightScale");
+    m_locations.heightMap         = m_shaderProgram->getUniformLocation(SHADER_VARIABLE("heightMap"));
+    m_locations.normalMap         = m_shaderProgram->getUniformLocation(SHADER_VARIABLE("normalMap"));
+    m_locations.heightMin         = m_shaderProgram->getUniformLocation(SHADER_VARIABLE("heightMin"));
+    m_locations.heightScale       = m_shaderProgram->getUniformLocation(SHADER_VARIABLE("heightScale"));
+    m_locations.patchBounds       = m_shaderProgram->getUniformLocation(SHADER_VARIABLE("patchBounds"));
+
+    // Tessellation and texture scale parameters
+    m_locations.tessellationLevel = m_shaderProgram->getUniformLocation(SHADER_VARIABLE("tessellationLevel"));
+    m_locations.scaleTexture      = m_shaderProgram->getUniformLocation(SHADER_VARIABLE("scaleTexture"));
+
+    // Textures and masks (ie blending coefficients)
+    m_locations.biomes            = m_shaderProgram->getUniformLocation(SHADER_VARIABLE("biomeTex"));
+    m_locations.masks             = m_shaderProgram->getUniformLocation(SHADER_VARIABLE("biomeMasks"));
+
+    /*
+     * The samplers always read the same texture units: they are part of
+     * the program state, no need to send them at each frame.
+     * Unit 0: height map, unit 1: masks, unit 2: biomes, unit 3: normals,
+     * unit 4: bounds of the patches.
+     */
+    if (m_locations.heightMap != ShaderProgram::null_location)
+    {
+        glcheck(glUniform1i(m_locations.heightMap, 0));
+    }
+    if (m_locations.masks != ShaderProgram::null_location)
+    {
+        glcheck(glUniform1i(m_locations.masks, 1));
+    }
+    if (m_locations.biomes != ShaderProgram::null_location)
+    {
+        glcheck(glUniform1i(m_locations.biomes, 2));
+    }
+    if (m_locations.normalMap != ShaderProgram::null_location)
+    {
+        glcheck(glUniform1i(m_locations.normalMap, 3));
+    }
+    if (m_locations.patchBounds != ShaderProgram::null_location)
+    {
+        glcheck(glUniform1i(m_locations.patchBounds, 4));
+    }
+}
+
+void MapRenderable::do_draw()
+{
+    // The locations change only when the program is linked again
+    if (m_locations.revision != m_shaderProgram->getRevision())
+    {
+        updateLocations();
+    }
 
-    // Tesselation parameters
-    int tessLevelLocation       = m_shaderProgram->getUniformLocation("tessellationLevel");
-    //int maxDistLocation         = m_shaderProgram->getUniformLocation("maxDist");
-    
-    // The texture scale parameter
-    int scaleTextureLocation    = m_shaderProgram->getUniformLocation("scaleTexture");
-
-    // Textures
-    int seaTextureLocation      = m_shaderProgram->getUniformLocation("seaTex"); 
-    int sandTextureLocation     = m_shaderProgram->getUniformLocation("sandTex"); 
-    int plainsTextureLocation   = m_shaderProgram->getUniformLocation("plainsTex"); 
-    int lakeTextureLocation     = m_shaderProgram->getUniformLocation("lakeTex"); 
-    int mountainTextureLocation = m_shaderProgram->getUniformLocation("mountainTex"); 
-    int peakTextureLocation     = m_shaderProgram->getUniformLocation("peakTex"); 
-    
-    // Masks (ie blending coefficients)
-    // (x, y, z, w) = (sea, sand, plains, lake)
-    int seaSandPlainsLakeMaskLocation = m_shaderProgram->getUniformLocation("seaSandPlainsLakeMask"); 
-    // (x, y)       = (mountain, peak)
-    int mountainPeakMaskLocation     = m_shaderProgram->getUniformLocation("mountainPeakMask");
-    
     //Send material uniform to GPU
     Material::sendToGPU(m_shaderProgram, m_material);
 
@@ -163,12 +168,12 @@ void MapRenderable::do_draw()
      */
     
     // Positions
-    if(positionLocation != ShaderProgram::null_location)
+    if(m_locations.position != ShaderProgram::null_location)
     {
-        glcheck(glEnableVertexAttribArray(positionLocation));
+        glcheck(glEnableVertexAttribArray(m_locations.position));
         glcheck(glBindBuffer(GL_ARRAY_BUFFER, m_positionsBufferID));
         glcheck(glVertexAttribPointer(
-                    positionLocation, 
+                    m_locations.position, 
                     3,
                     GL_FLOAT, 
                     GL_FALSE, 
@@ -179,12 +184,12 @@ void MapRenderable::do_draw()
     }
 
     // Texture coordinates
-    if(texCoordLocation != ShaderProgram::null_location)
+    if(m_locations.texCoord != ShaderProgram::null_location)
     {
-        glcheck(glEnableVertexAttribArray(texCoordLocation));
+        glcheck(glEnableVertexAttribArray(m_locations.texCoord));
         glcheck(glBindBuffer(GL_ARRAY_BUFFER, m_texCoordsID));
         glcheck(glVertexAttribPointer(
-                    texCoordLocation, 
+                    m_locations.texCoord, 
                     2,
                     GL_FLOAT, 
                     GL_FALSE, 
@@ -195,10 +200,10 @@ void MapRenderable::do_draw()
     }
 
     // Model matrix
-    if(modelLocation != ShaderProgram::null_location)
+    if(m_locations.model != ShaderProgram::null_location)
     {
         glcheck(glUniformMatrix4fv(
-                    modelLocation, 
+                    m_locations.model, 
                     1, 
                     GL_FALSE, 
                     glm::value_ptr(getModelMatrix())
@@ -207,129 +212,97 @@ void MapRenderable::do_draw()
     }
 
     // Height map as a texture
-    if (heightmapLocation != ShaderProgram::null_location)
+    if (m_locations.heightMap != ShaderProgram::null_location)
     {
         glcheck(glActiveTexture(GL_TEXTURE0));
         glcheck(glBindTexture(GL_TEXTURE_2D, m_heightmapID));
-        glcheck(glUniform1i(heightmapLocation, 0));
     }
 
     // Minimal height
-    if (heightMinLocation != ShaderProgram::null_location)
+    if (m_locations.heightMin != ShaderProgram::null_location)
     {
-        glcheck(glUniform1f(heightMinLocation, m_minAltitude));
+        glcheck(glUniform1f(m_locations.heightMin, m_minAltitude));
     }
 
     // Height scale
-    if (heightScaleLocation != ShaderProgram::null_location)
+    if (m_locations.heightScale != ShaderProgram::null_location)
     {
-        glcheck(glUniform1f(heightScaleLocation, m_scaleAltitude));
+        glcheck(glUniform1f(m_locations.heightScale, m_scaleAltitude));
     }
 
     // Tesselation level
-    if (tessLevelLocation != ShaderProgram::null_location)
+    if (m_locations.tessellationLevel != ShaderProgram::null_location)
     {
         glcheck(glUniform1f(
-                    tessLevelLocation, 
+                    m_locations.tessellationLevel, 
                     m_mapGenerator.m_mapParameters.getTessellationLevel()
                 )
         );
     }
 
-    
-    // First texture mask (Sea, sand, plains, lake)
-    if (seaSandPlainsLakeMaskLocation != ShaderProgram::null_location)
+    // Texture masks, both layers at once
+    if (m_locations.masks != ShaderProgram::null_location)
     {
         glcheck(glActiveTexture(GL_TEXTURE1));
-        glcheck(glBindTexture(GL_TEXTURE_2D, m_seaSandPlainsLakeMaskId));
-        glcheck(glUniform1i(seaSandPlainsLakeMaskLocation, 1));
-    }
-
-    // Second mask (Mountain, peak)
-    if (mountainPeakMaskLocation != ShaderProgram::null_location)
-    {
-        glcheck(glActiveTexture(GL_TEXTURE2));
-        glcheck(glBindTexture(GL_TEXTURE_2D, m_mountainPeakMaskId));
-        glcheck(glUniform1i(mountainPeakMaskLocation, 2));
+        glcheck(glBindTexture(GL_TEXTURE_2D_ARRAY, m_masksId));
     }
 
     // Texture scale
-    if (scaleTextureLocation != ShaderProgram::null_location)
+    if (m_locations.scaleTexture != ShaderProgram::null_location)
     {
-        glcheck(glUniform1f(scaleTextureLocation, 
+        glcheck(glUniform1f(m_locations.scaleTexture, 
 			    m_mapGenerator.m_mapParameters.getLandTextureScaling()));
     }
 
-    // Sea Texture
-    if (seaTextureLocation != ShaderProgram::null_location)
+    // Biome textures, all the layers at once
+    if (m_locations.biomes != ShaderProgram::null_location)
     {
-        glcheck(glActiveTexture(GL_TEXTURE3));
-        glcheck(glBindTexture(GL_TEXTURE_2D, m_seaTexId));
-        glcheck(glUniform1i(seaTextureLocation, 3)); // ?
-    }
-
-
-    // Sand Texture
-    if (sandTextureLocation != ShaderProgram::null_location)
-    {
-        glcheck(glActiveTexture(GL_TEXTURE4));
-        glcheck(glBindTexture(GL_TEXTURE_2D, m_sandTexId));
-        glcheck(glUniform1i(sandTextureLocation, 4)); // ?
-    }
-
-
-    // Plains Texture
-    if (plainsTextureLocation != ShaderProgram::null_location)
-    {
-        glcheck(glActiveTexture(GL_TEXTURE5));
-        glcheck(glBindTexture(GL_TEXTURE_2D, m_plainsTexId));
-        glcheck(glUniform1i(plainsTextureLocation, 5)); // ?
-    }
-
-
-    // Lake Texture
-    if (lakeTextureLocation != ShaderProgram::null_location)
-    {
-        glcheck(glActiveTexture(GL_TEXTURE6));
-        glcheck(glBindTexture(GL_TEXTURE_2D, m_lakeTexId));
-        glcheck(glUniform1i(lakeTextureLocation, 6)); // ?
+        glcheck(glActiveTexture(GL_TEXTURE2));
+        glcheck(glBindTexture(GL_TEXTURE_2D_ARRAY, m_biomesTexture->getId()));
     }
 
-
-    // Mountain Texture
-    if (mountainTextureLocation != ShaderProgram::null_location)
+    // Normals of the height map
+    if (m_locations.normalMap != ShaderProgram::null_location)
     {
-        glcheck(glActiveTexture(GL_TEXTURE7));
-        glcheck(glBindTexture(GL_TEXTURE_2D, m_mountainTexId));
-        glcheck(glUniform1i(mountainTextureLocation, 7)); // ?
+        glcheck(glActiveTexture(GL_TEXTURE3));
+        glcheck(glBindTexture(GL_TEXTURE_2D, m_normalMapID));
     }
 
-    // Peak Texture
-    if (peakTextureLocation != ShaderProgram::null_location)
+    // Bounds of the patches, read by index of patch
+    if (m_locations.patchBounds != ShaderProgram::null_location)
     {
-        glcheck(glActiveTexture(GL_TEXTURE8));
-        glcheck(glBindTexture(GL_TEXTURE_2D, m_peakTexId));
-        glcheck(glUniform1i(peakTextureLocation, 8)); // ?
+        glcheck(glActiveTexture(GL_TEXTURE4));
+        glcheck(glBindTexture(GL_TEXTURE_BUFFER, m_patchBoundsTextureID));
     }
 
     /*
      * Tessellating the map, and rendering it.
      */
     glcheck(glPatchParameteri(GL_PATCH_VERTICES, 3));
-    glcheck(glDrawArrays(GL_PATCHES, 0, m_positions.size()));
+    glcheck(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_indicesBufferID));
+    glcheck(glDrawElements(GL_PATCHES, m_indices.size(), GL_UNSIGNED_INT, (void*)0));
 
-    // Release texture 
+    // Release textures
+    glcheck(glActiveTexture(GL_TEXTURE4));
+    glcheck(glBindTexture(GL_TEXTURE_BUFFER, 0));
+    glcheck(glActiveTexture(GL_TEXTURE3));
+    glcheck(glBindTexture(GL_TEXTURE_2D, 0));
+    glcheck(glActiveTexture(GL_TEXTURE2));
+    glcheck(glBindTexture(GL_TEXTURE_2D_ARRAY, 0));
+    glcheck(glActiveTexture(GL_TEXTURE1));
+    glcheck(glBindTexture(GL_TEXTURE_2D_ARRAY, 0));
+    glcheck(glActiveTexture(GL_TEXTURE0));
     glcheck(glBindTexture(GL_TEXTURE_2D, 0));
     /*
      * Disabling the buffers.
      */
-    if(positionLocation != ShaderProgram::null_location)
+    if(m_locations.position != ShaderProgram::null_location)
     {
-        glcheck(glDisableVertexAttribArray(positionLocation));
+        glcheck(glDisableVertexAttribArray(m_locations.position));
     }
-    if(texCoordLocation != ShaderProgram::null_location)
+    if(m_locations.texCoord != ShaderProgram::null_location)
     { 
-	glcheck(glDisableVertexAttribArray(texCoordLocation));
+	glcheck(glDisableVertexAttribArray(m_locations.texCoord));
     }
 
 
@@ -346,384 +319,209 @@ void MapRenderable::setMaterial(const MaterialPtr& material)
 }
 
 
-void MapRenderable::insertIntoList(
-    std::list< std::pair<float, float> >& list,
-    float x,
-    float y,
-    float centerX,
-    float centerY
-)
+/**
+ * @brief
+ * A vertex of a Voronoi cell, with its angle around the seed of the cell.
+ * The angle is computed once per vertex, and used as the sort key of the
+ * polygon.
+ */
+struct CellVertex
 {
-    /*
-     * If the list is empty, just pushing back the new pair.
-     * Otherwise, we have to determine the position to insert the pair to.
-     *  In order to do so, we simply iterate over the pairs, comparing the
-     *  orientation of the radial vector (with the center of the cell) of
-     *  pair to insert with the latter's ones.
-     *  The last comparison needs extra care, since we may have to push
-     *  back the pair to insert if its orientation is greater than
-     *  the one of the list's last pair.
-     */
-    if (list.empty()) {
-        list.push_back(std::pair<float, float>(x, y));
-    } else {
-        auto current = list.begin();
-        auto previous = current;
-        auto last = list.end();
-        float angle = atan2(y - centerY, x - centerX);
-        float currentAngle;
-        
-        do {
-            currentAngle = atan2(
-                current->second - centerY,
-                current->first - centerX
-            );
-            previous = current;
-            current++;   
-        } while ((current != last) && (angle > currentAngle));
-        
-        if (angle <= currentAngle) {
-            list.insert(previous, std::pair<float, float>(x,y));
-        } else {
-            list.push_back(std::pair<float, float>(x,y));
-        }
+    float angle;        /*!< The angle of the vertex around the seed. */
+    glm::vec2 position; /*!< The position of the vertex. */
+
+    bool operator<(const CellVertex& other) const
+    {
+        return angle < other.angle;
     }
-}
+};
 
 /**
  * @brief
- * Static function aiming at finding if, considering a lake, a connexe lake, 
- * identified by "lakeID", has already been inserted into the associated
- * data structure (namely the vector storing information about lake connexity,
- * "m_lakesTriangles").
- * If "newLake" is set to "true" when given to the function, then no need for
- * fusionning lakes (since, if a connexe lake biome is found, it is the first
- * to be).
- * On the contrary, if "newLake" has been set to "false" by the current function
- * during a previous execution, and another connexe lake is found, the latter has
- * to be fused with the first found connexe lake.
+ * Get the key identifying a vertex shared by several cells. The coordinates
+ * are rounded to the millimeter, since voro++ computes the vertices of each
+ * cell separately and may give slightly different coordinates for a same
+ * vertex.
  *
- * @param lakes A reference on the data structure containing information about
- * lakes connexity.
- * @param lakeID The ID of the connexe lake to search for.
- * @param resultPair A pointer on the pointer in which the address of the pair
- * of "lakes" to consider will be stored, if the connexe lake is found.
- * @param newLake A boolean representing "the connexe lake has been found".
+ * @param position The position of the vertex.
+ * @return The key of the vertex.
  */
-static void findList(
-    std::list< std::pair< std::vector<int>, std::vector<glm::vec3> > >& lakes,
-    int lakeID,
-    std::pair< std::vector<int>, std::vector<glm::vec3> >** resultPair,
-	bool& newLake
-)
+static inline unsigned long long vertexKey(const glm::vec2& position)
 {
-    for (
-        auto itLakes = lakes.begin(); 
-        itLakes != lakes.end(); 
-        itLakes++
-    ) {
-        for (
-            auto itLakeIDs = itLakes->first.begin();
-            itLakeIDs != itLakes->first.end();
-            itLakeIDs++
-        ) {
-			if (*itLakeIDs == lakeID) {
-				if (newLake) {
-					*resultPair = &(*itLakes);
-					newLake = false;
-				} else {
-					/*
-					 * If the connexe Lake biome is within the current connexe
-					 * lake, nothing to do.
-					 * Otherwise, we have to fuse the found connexe lake with
-					 * the current one. In other words, to push back the content
-					 * of the associated vectors into those of the final lake, and
-					 * remove of the list the pair which has been fused. 
-					 */
-					if (*resultPair != &(*itLakes)) {
-						for (
-							auto intIt = itLakes->first.begin();
-							intIt != itLakes->first.end();
-							intIt++
-						) {
-							(*resultPair)->first.push_back(*intIt);
-						}
-						for (
-							auto glmIt = itLakes->second.begin();
-							glmIt != itLakes->second.end();
-							glmIt++
-						) {
-							(*resultPair)->second.push_back(*glmIt);
-						}
-						lakes.erase(itLakes);
-					}
-				}
-				/*
-				 * Since a biome lake can be involded in only one connexe lake,
-				 * if the considered biome lake has been found, no need to iterate
-				 * over the remaining connexe lakes.
-				 */
-				return;
-			}
-        }
-    }
+    unsigned long long x = (unsigned int) (long long) std::floor(position.x*1000.0f + 0.5f);
+    unsigned long long y = (unsigned int) (long long) std::floor(position.y*1000.0f + 0.5f);
+    return (x << 32) | y;
 }
 
 void MapRenderable::sendVoronoiDiagram(MapGenerator& mapGenerator) 
 {
-   
+    int seedCount = (int) m_mapGenerator.seeds.size();
+
     /*
      * Iterating on each cell in order to obtain the coordinates of each
-     * of its vertices.
-     * This will be used to draw the cells.
-     * We are going to store in a list, a list by cell, containing the
-     * vertices of the latter.
-     * Since we are interested in bi-dimensional Voronoi diagrams, the
-     * vertices are going to be stored as pairs of float/coordinates.
+     * of its vertices, in parallel since the cells are independent.
+     * The vertices of each cell are stored in the order of their angles
+     * around the seed, which is the order of the polygon of the cell.
      */
-    std::list< std::list< std::pair<float, float> >* > listOfVertices;
+    std::vector< std::vector<glm::vec2> > polygons(seedCount);
 
-    for (
-        auto seedsIterator = m_mapGenerator.seeds.begin();
-        seedsIterator != m_mapGenerator.seeds.end();
-        seedsIterator++
-    ) {
-        /*
-         * First, we have to compute the vertices of the considered cell.
-         * Thanks to one of the voro++ primitives, we can obtain a vector
-         * containing all the concatened coordinates of the cell's vertices.
-         */
+    #pragma omp parallel
+    {
+        // Buffers reused from a cell to the next one
         std::vector<double> verticesCoordinates;
-        seedsIterator->getCell()->vertices(
-            (double)seedsIterator->getX(),
-            (double)seedsIterator->getY(),
-            0.0,
-            verticesCoordinates
-        );
+        std::vector<CellVertex> cellVertices;
 
-        /*
-         * Then, we parse the computed coordinates to create the vectors of
-         * points.
-         */
-        auto cellVertices = new std::list< std::pair<float, float> >();
-        for (
-            auto iterator = verticesCoordinates.begin(); 
-            iterator != verticesCoordinates.end(); 
-        ) {
-            /*  
-             * As voro++ is working with a tridimensional space, and we are
-             * interested in plane diagrams, we have to keep the only the
-             * vertices in the positive "half-3Dspace".
-             * Indeed, we set to 0.0 all the z-coordinates of the seeds, so
-             * as to obtain a "plane 3D Voronoi diagram" center on the origin.
-             * Thus, the plane (Oxy) is a median plane of the global diagram,
-             * and the 3D diagram can be view has a solid obtained by extruding
-             * the 2D diagram shape.
-             * That is why, by only selecting the vertices of one of the half-spaces,
-             * we obtain the shape of the 2D diagram.
+        #pragma omp for schedule(dynamic, 64)
+        for (int s = 0; s < seedCount; s++) {
+            const Seed& seed = m_mapGenerator.seeds[s];
+            float seedX = seed.getX();
+            float seedY = seed.getY();
+
+            /*
+             * Thanks to one of the voro++ primitives, we can obtain a vector
+             * containing all the concatened coordinates of the cell's vertices.
              */
-            float x = *(iterator)++;
-            float y = *(iterator)++;
-            float z = *(iterator)++;
-
-            if (z >= 0.0) {
-                COMPENSATE_COMPUTATION_ERROR(x,y);
-                insertIntoList(
-                    *cellVertices, 
-                    x,
-                    y,
-                    seedsIterator->getX(), 
-                    seedsIterator->getY() 
-                );
+            seed.getCell()->vertices((double)seedX, (double)seedY, 0.0, verticesCoordinates);
+
+            cellVertices.clear();
+            for (std::size_t v = 0; v + 2 < verticesCoordinates.size(); v += 3) {
+                /*  
+                 * As voro++ is working with a tridimensional space, and we are
+                 * interested in plane diagrams, we have to keep the only the
+                 * vertices in the positive "half-3Dspace".
+                 * Indeed, we set to 0.0 all the z-coordinates of the seeds, so
+                 * as to obtain a "plane 3D Voronoi diagram" center on the origin.
+                 * Thus, the plane (Oxy) is a median plane of the global diagram,
+                 * and the 3D diagram can be view has a solid obtained by extruding
+                 * the 2D diagram shape.
+                 * That is why, by only selecting the vertices of one of the half-spaces,
+                 * we obtain the shape of the 2D diagram.
+                 */
+                float x = verticesCoordinates[v];
+                float y = verticesCoordinates[v + 1];
+                float z = verticesCoordinates[v + 2];
+
+                if (z >= 0.0) {
+                    COMPENSATE_COMPUTATION_ERROR(x,y);
+                    CellVertex vertex;
+                    vertex.angle = std::atan2(y - seedY, x - seedX);
+                    vertex.position = glm::vec2(x, y);
+                    cellVertices.push_back(vertex);
+                }
+            }
+
+            std::sort(cellVertices.begin(), cellVertices.end());
+            polygons[s].reserve(cellVertices.size());
+            for (const CellVertex& vertex : cellVertices) {
+                polygons[s].push_back(vertex.position);
             }
         }
+    }
 
-        listOfVertices.push_back(cellVertices);
+    /*
+     * Building the indexed mesh: the vertices shared by several cells are
+     * stored once, then each cell is a fan of triangles around its centroid.
+     * The first index of each cell's vertices is kept, in the order of its
+     * polygon, to build the fans once the heights are known.
+     */
+    std::unordered_map<unsigned long long, unsigned int> sharedVertices;
+    sharedVertices.reserve(2*seedCount);
+    std::vector<unsigned int> polygonIndices;
+    std::vector<unsigned int> polygonOffsets(seedCount + 1, 0);
+    std::vector<unsigned int> centroidIndices(seedCount);
+
+    m_positions.clear();
+    for (int s = 0; s < seedCount; s++) {
+        polygonOffsets[s] = polygonIndices.size();
+        for (const glm::vec2& position : polygons[s]) {
+            auto inserted = sharedVertices.insert(
+                std::make_pair(vertexKey(position), (unsigned int) m_positions.size())
+            );
+            if (inserted.second) {
+                m_positions.push_back(glm::vec3(position, 0.0f));
+            }
+            polygonIndices.push_back(inserted.first->second);
+        }
+        centroidIndices[s] = m_positions.size();
+        m_positions.push_back(glm::vec3(
+            m_mapGenerator.seeds[s].getCentroidX(),
+            m_mapGenerator.seeds[s].getCentroidY(),
+            0.0f
+        ));
     }
+    polygonOffsets[seedCount] = polygonIndices.size();
 
     /*
-     * Iterating on each seed in order to fill the different buffers with the
-     * necessary data to render the map.
+     * The height of each vertex is computed once, however many triangles
+     * share it.
      */
-    auto seedsIt = m_mapGenerator.seeds.begin();
-    int count = 0;
-    for (
-        auto listIt = listOfVertices.begin();
-        listIt != listOfVertices.end();
-        listIt++, seedsIt++, count++
-    ) {
-        /*
-         * Getting the centroid and the biome of the cell, since all the 
-         * triangles will connect to the former, and be of the type of the
-         * latter.
-         */
-        glm::vec3 p1;
-        glm::vec3 p2;
-        float cX = seedsIt->getCentroidX();
-        float cY = seedsIt->getCentroidY();
-        glm::vec3 centroid(
-            cX,
-            cY,
-            m_mapGenerator.getHeight(cX, cY)
-        );
+    m_texCoords.resize(m_positions.size());
+    #pragma omp parallel for
+    for (int v = 0; v < (int) m_positions.size(); v++) {
+        glm::vec3& position = m_positions[v];
+        position.z = m_mapGenerator.getHeight(position.x, position.y);
+        m_texCoords[v] = glm::vec2(position)/m_mapGenerator.mapSize;
+    }
+
+    /*
+     * Iterating on each seed in order to fill the indices of the triangles.
+     */
+    m_indices.clear();
+    m_indices.reserve(3*polygonIndices.size());
+    m_lakesTriangles.assign(m_mapGenerator.getLakeComponentCount(), ConnexLake());
+    float lakesExtension = mapGenerator.m_mapParameters.getLakesExtension();
+    for (int count = 0; count < seedCount; count++) {
+        unsigned int first = polygonOffsets[count];
+        unsigned int last = polygonOffsets[count + 1];
+        if (last == first) {
+            continue;
+        }
+        unsigned int centroidIndex = centroidIndices[count];
+        const glm::vec3& centroid = m_positions[centroidIndex];
 
         /*
-         * In order to merge connexe lakes, we have to iterate over their
-         * neighbourhoods, and insert their triangles into shared vectors.
+         * The triangles of the Lake biomes are gathered by connexe lake.
          */
-        bool newLake = true;
         std::vector<glm::vec3>* lakeVector = NULL;
-        if (seedsIt->getBiome() == Lake) {
-            /*
-             * Iterating over the lake's neighbourhood.
-             */
-            std::vector<int> neighbours;
-            seedsIt->getCell()->neighbors(neighbours);
-
-            std::pair< 
-                std::vector<int>, 
-                std::vector<glm::vec3> 
-            >* insertPair;
-
-			for (
-				auto neighboursIt = neighbours.begin();
-				neighboursIt != neighbours.end();
-				neighboursIt++
-				)
-			{
-				/*
-				 * If one of its neighbour has already been inserted into the
-				 * lakes list, then the considered lake is connexe to its
-				 * neighbour.
-				 * If a connexe lake has already been found, then checking the 
-				 * other neighbours of the considered lake in order to detect 
-				 * secondary connexity.
-				 */
-				findList(m_lakesTriangles, *neighboursIt, &insertPair, newLake);
-			}
-            /*
-             * Otherwise, we have to insert the lake into the list of lakes.
-             */
-            if (newLake) {
-                m_lakesTriangles.push_back(
-                    std::pair< std::vector<int>, std::vector<glm::vec3> >()
-                );
-                insertPair = &(m_lakesTriangles.back());
-            }
-            insertPair->first.push_back(count);
-            lakeVector = &(insertPair->second);
+        int lakeComponent = m_mapGenerator.getLakeComponent(count);
+        if (lakeComponent >= 0) {
+            m_lakesTriangles[lakeComponent].seeds.push_back(count);
+            lakeVector = &(m_lakesTriangles[lakeComponent].triangles);
         }
 
-        auto current = (*listIt)->begin();
-        auto previous = current;
-        current++;
-
         /*
-         * Iterating on each vertex associated with the seed, that is to say
-         * the cell, and constructing the associated triangles.
-         * In other words, each pair of consecutive vertices is linked with the
-         * center of the cell to construct a triangle.
+         * Each pair of consecutive vertices of the cell, the last one being
+         * followed by the first one, is linked with the centroid of the cell
+         * to construct a triangle.
          */
-        while (current != (*listIt)->end()) {
-            /*
-             * Initialisation of the computing of the points.
-             */
-            p1.x = previous->first;
-            p1.y = previous->second; 
-            p1.z = m_mapGenerator.getHeight(p1.x, p1.y);
-            p2.x = current->first;
-            p2.y = current->second; 
-            p2.z = m_mapGenerator.getHeight(p2.x, p2.y);
+        for (unsigned int i = first; i < last; i++) {
+            unsigned int i1 = polygonIndices[i];
+            unsigned int i2 = polygonIndices[(i + 1 < last) ? i + 1 : first];
 
-            /*
-             * Pushing the information associated with the first point to the
-             * buffers.
-             */
-            m_positions.push_back(p1);
-            m_texCoords.push_back(glm::vec2(p1)/m_mapGenerator.mapSize);
-            /*
-             * Pushing the information associated with the second point to the
-             * buffers.
-             */
-            m_positions.push_back(p2);
-            m_texCoords.push_back(glm::vec2(p2)/m_mapGenerator.mapSize);
-
-            /*
-             * Pushing the information associated with the centroid to the
-             * buffers.
-             */
-            m_positions.push_back(centroid);
-            m_texCoords.push_back(glm::vec2(centroid)/m_mapGenerator.mapSize);
+            m_indices.push_back(i1);
+            m_indices.push_back(i2);
+            m_indices.push_back(centroidIndex);
 
             /*
              * Pushing the lakes' triangles, possibly extended or shrinked thanks to the dedicated
              * coefficient.
              */
             if (lakeVector != NULL) {
-                float coeff = mapGenerator.m_mapParameters.getLakesExtension();
-                lakeVector->push_back(glm::vec3(coeff*glm::vec2(p1-centroid)+glm::vec2(centroid), p1.z));
-                lakeVector->push_back(glm::vec3(coeff*glm::vec2(p2-centroid)+glm::vec2(centroid), p2.z));
+                const glm::vec3& p1 = m_positions[i1];
+                const glm::vec3& p2 = m_positions[i2];
+                lakeVector->push_back(glm::vec3(lakesExtension*glm::vec2(p1-centroid)+glm::vec2(centroid), p1.z));
+                lakeVector->push_back(glm::vec3(lakesExtension*glm::vec2(p2-centroid)+glm::vec2(centroid), p2.z));
                 lakeVector->push_back(centroid);
             }
-
-            previous = current;
-            current++;
         }
-
-        /*
-         * The last triangle between the last and first vertices, and the c
-         * entroid has to be created "manually", after the loop.
-         */
-        p1.x = (*listIt)->front().first;
-        p1.y = (*listIt)->front().second;
-        p1.z = m_mapGenerator.getHeight(p1.x, p1.y);
-        
-        m_positions.push_back(p2);
-        m_texCoords.push_back(glm::vec2(p2)/m_mapGenerator.mapSize);
-
-        m_positions.push_back(p1);
-        m_texCoords.push_back(glm::vec2(p1)/m_mapGenerator.mapSize);
-     
-        m_positions.push_back(centroid);
-        m_texCoords.push_back(glm::vec2(centroid)/m_mapGenerator.mapSize);
-
-        if (lakeVector != NULL) {
-            float coeff = mapGenerator.m_mapParameters.getLakesExtension();
-            lakeVector->push_back(glm::vec3(coeff*glm::vec2(p1-centroid)+glm::vec2(centroid), p1.z));
-            lakeVector->push_back(glm::vec3(coeff*glm::vec2(p2-centroid)+glm::vec2(centroid), p2.z));
-            lakeVector->push_back(centroid);
-        }
-    }
-
-
-    /*
-     * Deleting the dynamically allocated memory.
-     */
-    auto listIt = listOfVertices.begin();
-    auto previous = listIt;
-    listIt++;
-
-    while (listIt != listOfVertices.end()) {
-        (*previous)->clear();
-        delete (*previous);
-        previous = listIt;
-        listIt++;
     }
 
-    /*
-     * Last vector has to deallocated "manually" since the loop
-     * stops before deleting it ("listOfVertices.end()" is
-     * encountered before deletion of the vector pointed by
-     * "previous").
-     */
-    (*previous)->clear();
-    delete (*previous);
-
     /*
      * Creation of the buffers on the GPU, and storing their IDs.
      */
-    glGenBuffers(1, &m_positionsBufferID);
-    glGenBuffers(1, &m_texCoordsID);
+    glcheck(glGenBuffers(1, &m_positionsBufferID));
+    glcheck(glGenBuffers(1, &m_texCoordsID));
+    glcheck(glGenBuffers(1, &m_indicesBufferID));
 
     /*
      * Activating buffers and sending data.
@@ -745,6 +543,15 @@ void MapRenderable::sendVoronoiDiagram(MapGenerator& mapGenerator)
                 GL_STATIC_DRAW
             )
     );
+
+    glcheck(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_indicesBufferID));
+    glcheck(glBufferData(
+                GL_ELEMENT_ARRAY_BUFFER, 
+                m_indices.size()*sizeof(unsigned int), 
+                m_indices.data(), 
+                GL_STATIC_DRAW
+            )
+    );
 }
 
 
@@ -753,121 +560,246 @@ void MapRenderable::sendVoronoiDiagram(MapGenerator& mapGenerator)
 
 void MapRenderable::sendHeightMap() {
     /*
-     * Creating and computing the 2D texture representing the heightmap.
+     * Creating and computing the 2D textures representing the heightmap
+     * and its normals.
      */
     int heightmapScaling    = m_mapGenerator.m_mapParameters.getHeightmapScaling();
     int mapSize             = (int) m_mapGenerator.mapSize;
     int effMapSize          = mapSize*heightmapScaling;
     int effMapDimension     = effMapSize + 1;
-    float* heightMap        = new float [4*effMapDimension*effMapDimension];
+    std::vector<float> altitudes(effMapDimension*effMapDimension);
 
     /*
      * We sample the heightmap within the texture according to a 
      * (1 pixel = <heightMapScaling = 2> meters) scale.
      * On top of that, we have to retain the maximum and minimum altitudes
-     * so as to apply a scaling during the Tessellation step (which
-     * prevent us from using OpenMP to parallelize this loop).
+     * so as to apply a scaling during the Tessellation step.
+     * The loop is parallelized with OpenMP: each thread retains its own
+     * extremes, since OpenMP 2.0 (the version of MSVC) has no min and max
+     * reductions, and they are merged in a critical section.
      */
+    float minAltitude = m_minAltitude;
     float maxAltitude = 0.0;
-    for (int i = 0; i < effMapSize; i++) {
+    #pragma omp parallel
+    {
+        float threadMinAltitude = minAltitude;
+        float threadMaxAltitude = maxAltitude;
+        #pragma omp for
         for (int j = 0; j < effMapSize; j++) {
-            
-            float effI = (float)i / (float)heightmapScaling;
-            float effJ = (float)j / (float)heightmapScaling;
-            float altitude = m_mapGenerator.getHeight(effI, effJ);
-            if (altitude < m_minAltitude) {
-                m_minAltitude = altitude;
-            } else if (altitude > maxAltitude) {
-                maxAltitude = altitude;
+            for (int i = 0; i < effMapSize; i++) {
+                float effI = (float)i / (float)heightmapScaling;
+                float effJ = (float)j / (float)heightmapScaling;
+                float altitude = m_mapGenerator.getHeight(effI, effJ);
+                threadMinAltitude = std::min(threadMinAltitude, altitude);
+                threadMaxAltitude = std::max(threadMaxAltitude, altitude);
+                altitudes[i+j*effMapDimension] = altitude;
             }
-            // Computing the normal
-            float delta = 0.1f / (float)heightmapScaling;
-            float dzx   = (m_mapGenerator.getHeight(effI + delta, effJ) - altitude);
-            float dzy   = (m_mapGenerator.getHeight(effI, effJ + delta) - altitude);
-            // The normal
-            glm::vec3 normal = glm::normalize(glm::cross(glm::vec3(delta, 0.0f,  dzx),
-                                                         glm::vec3(0.0f,  delta, dzy)));
-            // Transforming the normal to fit in the texture
-            normal = (normal*0.5f) + glm::vec3(0.5f); 
-
-	    heightMap[(i+j*effMapDimension)*4]     = normal.x;
-            heightMap[(i+j*effMapDimension)*4 + 1] = normal.y;
-            heightMap[(i+j*effMapDimension)*4 + 2] = normal.z;
-            heightMap[(i+j*effMapDimension)*4 + 3] = altitude;
+        }
+        #pragma omp critical
+        {
+            minAltitude = std::min(minAltitude, threadMinAltitude);
+            maxAltitude = std::max(maxAltitude, threadMaxAltitude);
         }
     }
     // Special case : copying for the last row and column
     #pragma omp parallel for
     for (int i = 0; i < effMapDimension; i++) {
-        heightMap[(i+(effMapSize*effMapDimension))*4]     = heightMap[(i+((effMapSize-1)*effMapDimension))*4];
-        heightMap[(i+(effMapSize*effMapDimension))*4 + 1] = heightMap[(i+((effMapSize-1)*effMapDimension))*4 + 1];
-        heightMap[(i+(effMapSize*effMapDimension))*4 + 2] = heightMap[(i+((effMapSize-1)*effMapDimension))*4 + 2];
-        heightMap[(i+(effMapSize*effMapDimension))*4 + 3] = heightMap[(i+((effMapSize-1)*effMapDimension))*4 + 3];
+        altitudes[i+(effMapSize*effMapDimension)] = altitudes[i+((effMapSize-1)*effMapDimension)];
     }
     #pragma omp parallel for
     for (int j = 0; j < effMapDimension; j++) {
-        heightMap[(effMapSize+(effMapDimension*j))*4]     = heightMap[((effMapSize-1)+(effMapDimension*j))*4];
-        heightMap[(effMapSize+(effMapDimension*j))*4 + 1] = heightMap[((effMapSize-1)+(effMapDimension*j))*4 + 1];
-        heightMap[(effMapSize+(effMapDimension*j))*4 + 2] = heightMap[((effMapSize-1)+(effMapDimension*j))*4 + 2];
-        heightMap[(effMapSize+(effMapDimension*j))*4 + 3] = heightMap[((effMapSize-1)+(effMapDimension*j))*4 + 3];
+        altitudes[effMapSize+(effMapDimension*j)] = altitudes[(effMapSize-1)+(effMapDimension*j)];
     }
-    
+    m_minAltitude = minAltitude;
+
     /*
      * Normalizing the heightmap, since the OpenGL tessellation shaders need
      * texture coordinates between 0 and 1.
      * That is why the scaling is needed, in order to have a final map with
      * altitudes corresponding to the original heightmap's ones.
+     * The normalized heights are stored on 16 bits, and the normals are
+     * derived from the sampled heights by central differences. Since they
+     * point upwards, only their (x, y) components are stored, as half floats.
      */
     m_scaleAltitude = maxAltitude - m_minAltitude;
+    float invScale  = (m_scaleAltitude > 0.0f) ? 1.0f / m_scaleAltitude : 0.0f;
+    std::vector<GLushort> heights(effMapDimension*effMapDimension);
+    std::vector<GLuint> normals(effMapDimension*effMapDimension);
     #pragma omp parallel for
-    for (int i = 0; i < effMapDimension*effMapDimension; i++) {
-        heightMap[i*4 + 3] -= m_minAltitude;
-		heightMap[i*4 + 3] /= m_scaleAltitude;
+    for (int j = 0; j < effMapDimension; j++) {
+        int down = std::max(j - 1, 0);
+        int up   = std::min(j + 1, effMapDimension - 1);
+        for (int i = 0; i < effMapDimension; i++) {
+            int left  = std::max(i - 1, 0);
+            int right = std::min(i + 1, effMapDimension - 1);
+
+            float altitude = altitudes[i+j*effMapDimension];
+            heights[i+j*effMapDimension] = (GLushort)
+                (glm::clamp((altitude - m_minAltitude)*invScale, 0.0f, 1.0f)*65535.0f + 0.5f);
+
+            // The slopes, the texels being spaced by 1/heightmapScaling meters
+            float dzx = (altitudes[right+j*effMapDimension] - altitudes[left+j*effMapDimension])
+                      * (float)heightmapScaling / (float)(right - left);
+            float dzy = (altitudes[i+up*effMapDimension] - altitudes[i+down*effMapDimension])
+                      * (float)heightmapScaling / (float)(up - down);
+            glm::vec3 normal = glm::normalize(glm::vec3(-dzx, -dzy, 1.0f));
+            normals[i+j*effMapDimension] = glm::packHalf2x16(glm::vec2(normal));
+        }
     }
-    
-     /*
-     * Creating the texture on the GPU.
-     */
-    glGenTextures(1, &m_heightmapID);
 
     /*
-     * Binding the texture.
+     * Creating the textures on the GPU.
      */
-    glBindTexture(GL_TEXTURE_2D, m_heightmapID);
+    glcheck(glGenTextures(1, &m_heightmapID));
+    glcheck(glGenTextures(1, &m_normalMapID));
 
     /*
-     * Setting the texture's parameters.
+     * Sending the heights, as 16 bits normalized integers.
+     * The rows are not aligned on 4 bytes if the dimension is odd.
      */
+    glcheck(glBindTexture(GL_TEXTURE_2D, m_heightmapID));
     glcheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR));
     glcheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR));
     glcheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT));
     glcheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT));
+    glcheck(glTexStorage2D(GL_TEXTURE_2D, 1, GL_R16, effMapDimension, effMapDimension));
+    glcheck(glPixelStorei(GL_UNPACK_ALIGNMENT, 2));
+    glcheck(glTexSubImage2D(GL_TEXTURE_2D,
+                            0,
+                            0, 0,
+                            effMapDimension,
+                            effMapDimension,
+                            GL_RED,
+                            GL_UNSIGNED_SHORT,
+                            (const GLvoid*) heights.data()));
+    glcheck(glPixelStorei(GL_UNPACK_ALIGNMENT, 4));
 
     /*
-     * Sending the texture to the GPU.
+     * Sending the normals, as two half floats.
      */
-    glcheck(
-        glTexImage2D(
-            GL_TEXTURE_2D,
-            0,
-            GL_RGBA32F,
-            effMapDimension,
-            effMapDimension,
-            0,
-            GL_RGBA,
-            GL_FLOAT,
-            (const GLvoid*) heightMap
-        )
-    );
+    glcheck(glBindTexture(GL_TEXTURE_2D, m_normalMapID));
+    glcheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR));
+    glcheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR));
+    glcheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT));
+    glcheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT));
+    glcheck(glTexStorage2D(GL_TEXTURE_2D, 1, GL_RG16F, effMapDimension, effMapDimension));
+    glcheck(glTexSubImage2D(GL_TEXTURE_2D,
+                            0,
+                            0, 0,
+                            effMapDimension,
+                            effMapDimension,
+                            GL_RG,
+                            GL_HALF_FLOAT,
+                            (const GLvoid*) normals.data()));
 
     /*
      * Releasing the texture.
      */
-    glBindTexture(GL_TEXTURE_2D, 0);
-    delete [] heightMap;
+    glcheck(glBindTexture(GL_TEXTURE_2D, 0));
+
+    // The bounds of the patches, for the tessellation
+    sendPatchBounds(altitudes);
+}
+
+void MapRenderable::sendPatchBounds(const std::vector<float>& altitudes) {
+    int heightmapScaling    = m_mapGenerator.m_mapParameters.getHeightmapScaling();
+    int mapSize             = (int) m_mapGenerator.mapSize;
+    int effMapDimension     = mapSize*heightmapScaling + 1;
+    int patchCount          = (int) m_indices.size() / 3;
+    std::vector<glm::vec4> patchBounds(patchCount);
+
+    /*
+     * Each patch is a triangle of the Voronoi cells decomposition: the
+     * texels of its bounding rectangle are scanned, which over-estimates
+     * its bounds a little but never misses a peak. The roughness is the
+     * largest vertical distance between these texels and the plane of
+     * the triangle, i.e. the error of the patch drawn without tessellation.
+     */
+    #pragma omp parallel for schedule(dynamic, 64)
+    for (int p = 0; p < patchCount; p++) {
+        const glm::vec3& a = m_positions[m_indices[3*p]];
+        const glm::vec3& b = m_positions[m_indices[3*p + 1]];
+        const glm::vec3& c = m_positions[m_indices[3*p + 2]];
+        glm::vec3 normal = glm::cross(b - a, c - a);
+
+        float scaling = (float) heightmapScaling;
+        int iMin = glm::clamp((int) std::floor(std::min(a.x, std::min(b.x, c.x))*scaling), 0, effMapDimension - 1);
+        int iMax = glm::clamp((int) std::ceil (std::max(a.x, std::max(b.x, c.x))*scaling), 0, effMapDimension - 1);
+        int jMin = glm::clamp((int) std::floor(std::min(a.y, std::min(b.y, c.y))*scaling), 0, effMapDimension - 1);
+        int jMax = glm::clamp((int) std::ceil (std::max(a.y, std::max(b.y, c.y))*scaling), 0, effMapDimension - 1);
+
+        float minHeight = std::min(a.z, std::min(b.z, c.z));
+        float maxHeight = std::max(a.z, std::max(b.z, c.z));
+        float roughness = 0.0f;
+        float minNormalZ = 1.0f;
+        for (int j = jMin; j <= jMax; j++) {
+            int down = std::max(j - 1, 0);
+            int up   = std::min(j + 1, effMapDimension - 1);
+            for (int i = iMin; i <= iMax; i++) {
+                int left  = std::max(i - 1, 0);
+                int right = std::min(i + 1, effMapDimension - 1);
+
+                float altitude = altitudes[i+j*effMapDimension];
+                minHeight = std::min(minHeight, altitude);
+                maxHeight = std::max(maxHeight, altitude);
+
+                if (std::abs(normal.z) > 1e-6f) {
+                    float x = (float)i / scaling;
+                    float y = (float)j / scaling;
+                    float planeHeight = a.z - (normal.x*(x - a.x) + normal.y*(y - a.y))/normal.z;
+                    roughness = std::max(roughness, std::abs(altitude - planeHeight));
+                }
+
+                // Same slopes as the normal map
+                float dzx = (altitudes[right+j*effMapDimension] - altitudes[left+j*effMapDimension])
+                          * scaling / (float)std::max(right - left, 1);
+                float dzy = (altitudes[i+up*effMapDimension] - altitudes[i+down*effMapDimension])
+                          * scaling / (float)std::max(up - down, 1);
+                minNormalZ = std::min(minNormalZ, 1.0f / std::sqrt(1.0f + dzx*dzx + dzy*dzy));
+            }
+        }
+
+        patchBounds[p] = glm::vec4(minHeight, maxHeight, roughness, minNormalZ);
+    }
 
+    glcheck(glGenBuffers(1, &m_patchBoundsID));
+    glcheck(glBindBuffer(GL_TEXTURE_BUFFER, m_patchBoundsID));
+    glcheck(glBufferData(
+                GL_TEXTURE_BUFFER, 
+                patchBounds.size()*sizeof(glm::vec4), 
+                patchBounds.data(), 
+                GL_STATIC_DRAW
+            )
+    );
+    glcheck(glBindBuffer(GL_TEXTURE_BUFFER, 0));
+
+    glcheck(glGenTextures(1, &m_patchBoundsTextureID));
+    glcheck(glBindTexture(GL_TEXTURE_BUFFER, m_patchBoundsTextureID));
+    glcheck(glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, m_patchBoundsID));
+    glcheck(glBindTexture(GL_TEXTURE_BUFFER, 0));
 }
 
+/**
+ * @brief
+ * Get the layer of the masks associated with a biome, in the order
+ * (sea, sand, plains, lake, mountain, peak).
+ *
+ * @param biome The biome.
+ * @return The layer of the biome, -1 if the biome has no texture.
+ */
+static int biomeLayer(Biome biome)
+{
+    switch (biome) {
+    case Sea:        return 0;
+    case InnerBeach:
+    case OuterBeach: return 1;
+    case Plains:     return 2;
+    case Lake:       return 3;
+    case Mountain:   return 4;
+    case Peak:       return 5;
+    default:         return -1;
+    }
+}
 
 void MapRenderable::sendMasks() {
     
@@ -876,99 +808,85 @@ void MapRenderable::sendMasks() {
     int mapSize             = (int) m_mapGenerator.mapSize;
     int effMapSize          = mapSize*heightmapScaling;
     int effMapDimension     = effMapSize + 1;
+    MapParameters& parameters = m_mapGenerator.m_mapParameters;
     
-    // Allocating the masks
+    // Allocating the masks, as the two layers of a texture array
+    // storing 8 bits per coefficient
+    std::vector<GLubyte> masks(2*4*effMapDimension*effMapDimension, 0);
     // Sea-Sand-Plains-Lake
-    float* maskSSPL         = new float [4*effMapDimension*effMapDimension];
+    GLubyte* maskSSPL       = masks.data();
     // Mountain-Peak
-    float* maskMP           = new float [2*effMapDimension*effMapDimension];
-
+    GLubyte* maskMP         = masks.data() + 4*effMapDimension*effMapDimension;
 
-    // Variables to store the local neighbourhood
-    float seaNeighbour;
-    float sandNeighbour;
-    float plainsNeighbour;
-    float lakeNeighbour;
-    float mountainNeighbour;
-    float peakNeighbour;
+    /*
+     * The layer of each sample of the biome map is looked up once, instead
+     * of at each step of the sliding neighbourhood. Each sample counts for
+     * the texture extent of its biome.
+     */
+    const float extents[6] = {
+        parameters.getSeaTextureExtent(),    parameters.getSandTextureExtent(),
+        parameters.getPlainsTextureExtent(), parameters.getLakeTextureExtent(),
+        parameters.getMountainTextureExtent(), parameters.getPeakTextureExtent()
+    };
+    std::vector<signed char> layers(effMapSize*effMapSize);
+    bool unknownBiome = false;
+    #pragma omp parallel for reduction(||:unknownBiome)
+    for (int n = 0; n < effMapSize*effMapSize; n++) {
+        layers[n] = biomeLayer(m_mapGenerator.biomeMap[n]);
+        unknownBiome = unknownBiome || (layers[n] < 0);
+    }
+    if (unknownBiome) {
+        throw std::invalid_argument("Wrong biome (sendMasks)");
+    }
 
-    float increment;
-    
     int neighbourhoodWidth   = 5;
-    float neighbourhoodSize  = 1.0f;
 
-    // Computing
+    // Computing, each column sliding its own neighbourhood
+    #pragma omp parallel for
     for (int i = 0; i < effMapSize; i++) {
+        // The local neighbourhood (sea, sand, plains, lake, mountain, peak)
+        float neighbours[6] = { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f };
+        float neighbourhoodSize = 0.0f;
+        int niMin = MAX(0, i - neighbourhoodWidth);
+        int niMax = MIN(effMapSize, i + neighbourhoodWidth);
+
+        // Count (scale = 1) or forget (scale = -1) a row of the neighbourhood
+        auto countRow = [&](int nj, float scale) {
+            for (int ni = niMin; ni < niMax; ++ni) {
+                int layer = layers[ni+nj*effMapSize];
+                float increment = scale*extents[layer];
+                neighbours[layer] += increment;
+                neighbourhoodSize += increment;
+            }
+        };
+
+        // We start on a new column : counting the first rows
+        for (int nj = 0; nj < MIN(effMapSize, neighbourhoodWidth); ++nj) {
+            countRow(nj, 1.0f);
+        }
+
         for (int j = 0; j < effMapSize; j++) {
+            if (j > 0) {
+                // We are on the same column
+                if (j > neighbourhoodWidth) {
+                    // We are far enough in the column to start forgetting a row
+                    countRow(j - neighbourhoodWidth - 1, -1.0f);
+                }
+                if (j < effMapSize - neighbourhoodWidth) {
+                    // We are not close to the end of the column, we can add the next row
+                    countRow(j + neighbourhoodWidth, 1.0f);
+                }
+            }
 
-	    
-	    if (j == 0) {
-		// We start on a now column : reset of the neighbourhood
-		// Reset to 0
-		seaNeighbour      = 0.0f;
-		sandNeighbour     = 0.0f;
-		plainsNeighbour   = 0.0f;
-		lakeNeighbour     = 0.0f;
-		mountainNeighbour = 0.0f;
-		peakNeighbour     = 0.0f;
-		neighbourhoodSize = 0.0f;
-		// Counting the new neighbourhood
-		for (int ni = MAX(0, i - neighbourhoodWidth);
-		     ni < MIN(effMapSize, i + neighbourhoodWidth);
-		     ++ni) {
-		    for (int nj = MAX(0, j - neighbourhoodWidth);
-			 nj < MIN(effMapSize, j + neighbourhoodWidth);
-			 ++nj) {
-			increment = countBiome(m_mapGenerator.m_mapParameters,
-					       m_mapGenerator.biomeMap[ni+nj*effMapSize], 1,
-					       &seaNeighbour,      &sandNeighbour,
-					       &plainsNeighbour,   &lakeNeighbour,
-					       &mountainNeighbour, &peakNeighbour);
-			neighbourhoodSize += increment;
-		    }
-		}
-	    } else {
-		// We are on the same column
-		if (j > neighbourhoodWidth) {
-		    // We are far enough in the column to start forgetting a row
-		    int nj = j - neighbourhoodWidth - 1;
-		    for (int ni = MAX(0, i - neighbourhoodWidth);
-			 ni < MIN(effMapSize, i + neighbourhoodWidth);
-			 ++ni) {
-			increment = countBiome(m_mapGenerator.m_mapParameters,
-					       m_mapGenerator.biomeMap[ni+nj*effMapSize], -1,
-					       &seaNeighbour,      &sandNeighbour,
-					       &plainsNeighbour,   &lakeNeighbour,
-					       &mountainNeighbour, &peakNeighbour);
-			
-			neighbourhoodSize += increment;
-		    }
-		}
-		if (j < effMapSize - neighbourhoodWidth) {
-		    // We are not close to the end of the column, we can add the next row
-		    int nj = j + neighbourhoodWidth;
-		    for (int ni = MAX(0, i - neighbourhoodWidth);
-			 ni < MIN(effMapSize, i + neighbourhoodWidth);
-			 ++ni) {
-			increment = countBiome(m_mapGenerator.m_mapParameters,
-					       m_mapGenerator.biomeMap[ni+nj*effMapSize], 1,
-					       &seaNeighbour,      &sandNeighbour,
-					       &plainsNeighbour,   &lakeNeighbour,
-					       &mountainNeighbour, &peakNeighbour);
-			neighbourhoodSize += increment;
-		    }
-		}    
-	    }
-
-	    // First mask
-	    maskSSPL[(i+j*effMapDimension)*4]     = seaNeighbour      / neighbourhoodSize; 
-            maskSSPL[(i+j*effMapDimension)*4 + 1] = sandNeighbour     / neighbourhoodSize; 
-            maskSSPL[(i+j*effMapDimension)*4 + 2] = plainsNeighbour   / neighbourhoodSize; 
-            maskSSPL[(i+j*effMapDimension)*4 + 3] = lakeNeighbour     / neighbourhoodSize;
-	    // Second mask
-	    maskMP[(i+j*effMapDimension)*2]       = mountainNeighbour / neighbourhoodSize;
-	    maskMP[(i+j*effMapDimension)*2 + 1]   = peakNeighbour     / neighbourhoodSize;
-	}
+            // First mask
+            maskSSPL[(i+j*effMapDimension)*4]     = toUnorm8(neighbours[0] / neighbourhoodSize);
+            maskSSPL[(i+j*effMapDimension)*4 + 1] = toUnorm8(neighbours[1] / neighbourhoodSize);
+            maskSSPL[(i+j*effMapDimension)*4 + 2] = toUnorm8(neighbours[2] / neighbourhoodSize);
+            maskSSPL[(i+j*effMapDimension)*4 + 3] = toUnorm8(neighbours[3] / neighbourhoodSize);
+            // Second mask
+            maskMP[(i+j*effMapDimension)*4]       = toUnorm8(neighbours[4] / neighbourhoodSize);
+            maskMP[(i+j*effMapDimension)*4 + 1]   = toUnorm8(neighbours[5] / neighbourhoodSize);
+        }
     }
     // Copying the last row and columns
     #pragma omp parallel for
@@ -979,8 +897,8 @@ void MapRenderable::sendMasks() {
         maskSSPL[(i+(effMapSize*effMapDimension))*4 + 2] = maskSSPL[(i+((effMapSize-1)*effMapDimension))*4 + 2];
         maskSSPL[(i+(effMapSize*effMapDimension))*4 + 3] = maskSSPL[(i+((effMapSize-1)*effMapDimension))*4 + 3];
 	// Second mask
-	maskMP[(i+(effMapSize*effMapDimension))*2]       = maskMP[(i+((effMapSize-1)*effMapDimension))*2];
-        maskMP[(i+(effMapSize*effMapDimension))*2 + 1]   = maskMP[(i+((effMapSize-1)*effMapDimension))*2 + 1];
+	maskMP[(i+(effMapSize*effMapDimension))*4]       = maskMP[(i+((effMapSize-1)*effMapDimension))*4];
+        maskMP[(i+(effMapSize*effMapDimension))*4 + 1]   = maskMP[(i+((effMapSize-1)*effMapDimension))*4 + 1];
     }
 
     #pragma omp parallel for
@@ -991,69 +909,53 @@ void MapRenderable::sendMasks() {
         maskSSPL[(effMapSize+(effMapDimension*j))*4 + 2] = maskSSPL[((effMapSize-1)+(effMapDimension*j))*4 + 2];
         maskSSPL[(effMapSize+(effMapDimension*j))*4 + 3] = maskSSPL[((effMapSize-1)+(effMapDimension*j))*4 + 3];
 	// Second mask
-	maskMP[(effMapSize+(effMapDimension*j))*2]       = maskMP[((effMapSize-1)+(effMapDimension*j))*2];
-        maskMP[(effMapSize+(effMapDimension*j))*2 + 1]   = maskMP[((effMapSize-1)+(effMapDimension*j))*2 + 1];
+	maskMP[(effMapSize+(effMapDimension*j))*4]       = maskMP[((effMapSize-1)+(effMapDimension*j))*4];
+        maskMP[(effMapSize+(effMapDimension*j))*4 + 1]   = maskMP[((effMapSize-1)+(effMapDimension*j))*4 + 1];
     }
 
-    // Sending the two masks
-
-    // First mask
+    // Sending the two masks at once
     // Creation
-    glGenTextures(1, &m_seaSandPlainsLakeMaskId);
+    glGenTextures(1, &m_masksId);
     // Bind
-    glBindTexture(GL_TEXTURE_2D, m_seaSandPlainsLakeMaskId);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, m_masksId);
     // Parameters
-    glcheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR));
-    glcheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR));
-    glcheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT));
-    glcheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT));
+    glcheck(glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR));
+    glcheck(glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR));
+    glcheck(glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_REPEAT));
+    glcheck(glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_REPEAT));
     // Sending
-    glcheck(glTexImage2D(GL_TEXTURE_2D,
-			 0,
-			 GL_RGBA32F,
-			 effMapDimension,
-			 effMapDimension,
-			 0,
-			 GL_RGBA,
-			 GL_FLOAT,
-			 (const GLvoid*) maskSSPL));
-
-    // Second mask
-    // Creation
-    glGenTextures(1, &m_mountainPeakMaskId);
-    // Bind
-    glBindTexture(GL_TEXTURE_2D, m_mountainPeakMaskId);
-    // Parameters // Useless here ?
-    glcheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR));
-    glcheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR));
-    glcheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT));
-    glcheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT));
-    // Sending
-    glcheck(glTexImage2D(GL_TEXTURE_2D,
-			 0,
-			 GL_RG32F,      
-			 effMapDimension,
-			 effMapDimension,
-			 0,
-			 GL_RG,
-			 GL_FLOAT,
-			 (const GLvoid*) maskMP));
+    glcheck(glTexStorage3D(GL_TEXTURE_2D_ARRAY,
+			   1,
+			   GL_RGBA8,
+			   effMapDimension,
+			   effMapDimension,
+			   2));
+    glcheck(glTexSubImage3D(GL_TEXTURE_2D_ARRAY,
+			    0,
+			    0, 0, 0,
+			    effMapDimension,
+			    effMapDimension,
+			    2,
+			    GL_RGBA,
+			    GL_UNSIGNED_BYTE,
+			    (const GLvoid*) masks.data()));
 
     // Releasing the texture
-    glBindTexture(GL_TEXTURE_2D, 0);
-
-    // Freeing the masks
-    delete [] maskSSPL;
-    delete [] maskMP;
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
 
 }
 
-std::list< 
-    std::pair<
-        std::vector<int>, 
-        std::vector<glm::vec3> 
-    >
->& MapRenderable::getLakesTriangles()
+std::vector<ConnexLake>& MapRenderable::getLakesTriangles()
 {
     return m_lakesTriangles;
 }
+
+unsigned int MapRenderable::do_getTextureKey() const
+{
+    return m_biomesTexture->getId();
+}
+
+unsigned int MapRenderable::do_getMeshKey() const
+{
+    return m_positionsBufferID;
+}
@@ -9,17 +9,6 @@
 
 #include "../../include/terrain/MapUtils.hpp"
 #include "../../include/math/InterpolationFunctions.hpp"
-/**
- * @brief
- * Macro aiming at computing an image of the distance between two points.
- * 
- * @param x0 The abscissa of the first point.
- * @param y0 The ordinate of the first point.
- * @param x1 The abscissa of the second point.
- * @param y1 The ordinate of the second point.
- */
-#define DIST_2(x0,y0,x1,y1) ((x0)-(x1))*((x0)-(x1))+((y0)-(y1))*((y0)-(y1))
-
 /**
  * @brief Macro aiming to correct the negative values that approximate 0
  * returned by the interpolation functions
@@ -123,40 +112,58 @@ void findClosestCentroid(Vertex2D & pos,
     yCentroid = seeds[cellId].getCentroidY();
 }
 
-bool findClosestLake(
-		     std::vector<glm::vec2>& lakes,
-		     float x,
-		     float y,
-		     float& xLake,
-		     float& yLake
-		     )
+void computeClosestTexels(
+	const std::vector<char>& features,
+	int size,
+	std::vector<int>& closest
+)
 {
-    /*
-     * If the vector is empty, then, there is no lake on the map !
-     */
-    if (lakes.size() != 0) {
-	/*
-	 * Preparation of the loop on the Lake biome in order to determine which Lake
-	 * biome is the closest of the given coordinates.
-	 */
-	auto lakesIt = lakes.begin();
-	float minDist = DIST_2(x, y, lakesIt->x, lakesIt->y);
-	xLake = lakesIt->x;
-	yLake = lakesIt->y;
-	lakesIt++;
-
-	for (; lakesIt != lakes.end(); lakesIt++)
-	    {
-		float currentDist = DIST_2(x, y, lakesIt->x, lakesIt->y);
-		if (currentDist < minDist) {
-		    minDist = currentDist;
-		    xLake = lakesIt->x;
-		    yLake = lakesIt->y;
-		}
-	    }
-	return true;
-    } else {
-	return false;
+    int texelCount = size*size;
+    closest.assign(texelCount, -1);
+    for (int t = 0; t < texelCount; t++) {
+        if (features[t]) {
+            closest[t] = t;
+        }
+    }
+
+    auto distance2 = [size](int from, int to) {
+        int di = (from % size) - (to % size);
+        int dj = (from / size) - (to / size);
+        return di*di + dj*dj;
+    };
+    auto relax = [&](int i, int j, int ni, int nj) {
+        if (ni < 0 || nj < 0 || ni >= size || nj >= size) {
+            return;
+        }
+        int t = i + j*size;
+        int candidate = closest[ni + nj*size];
+        if (candidate >= 0 &&
+            (closest[t] < 0 || distance2(t, candidate) < distance2(t, closest[t]))) {
+            closest[t] = candidate;
+        }
+    };
+
+    for (int j = 0; j < size; j++) {
+        for (int i = 0; i < size; i++) {
+            relax(i, j, i - 1, j);
+            relax(i, j, i - 1, j - 1);
+            relax(i, j, i, j - 1);
+            relax(i, j, i + 1, j - 1);
+        }
+        for (int i = size - 1; i >= 0; i--) {
+            relax(i, j, i + 1, j);
+        }
+    }
+    for (int j = size - 1; j >= 0; j--) {
+        for (int i = size - 1; i >= 0; i--) {
+            relax(i, j, i + 1, j);
+            relax(i, j, i + 1, j + 1);
+            relax(i, j, i, j + 1);
+            relax(i, j, i - 1, j + 1);
+        }
+        for (int i = 0; i < size; i++) {
+            relax(i, j, i - 1, j);
+        }
     }
 }
 
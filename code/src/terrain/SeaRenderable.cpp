@@ -11,7 +11,7 @@
 #include "./../../include/log.hpp"
 #include "./../../include/Utils.hpp"
 #include "./../../include/terrain/MapUtils.hpp"
-#include "./../../include/texturing/TexUtils.hpp"
+#include "./../../include/AssetManager.hpp"
 
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
@@ -52,7 +52,7 @@ SeaRenderable::SeaRenderable(ShaderProgramPtr shaderProgram,
     for (int i = minRes; i <= maxRes; ++i) {
 	filenames.push_back(name + std::to_string(i) + extension);
     }
-    sendMipMapTextures(filenames, &m_textureId);
+    m_texture = AssetManager::getMipMapTexture(filenames);
 }
 
 
@@ -72,16 +72,16 @@ void SeaRenderable::do_draw()
      */
 
     // Position
-    int positionLocation        = m_shaderProgram->getAttributeLocation("coord");
+    int positionLocation        = m_shaderProgram->getAttributeLocation(SHADER_VARIABLE("coord"));
 
      // Model matrix
-    int modelLocation           = m_shaderProgram->getUniformLocation("modelMat");
+    int modelLocation           = m_shaderProgram->getUniformLocation(SHADER_VARIABLE("modelMat"));
 
     // The texture scale parameter
-    int scaleTextureLocation    = m_shaderProgram->getUniformLocation("scaleTexture");
+    int scaleTextureLocation    = m_shaderProgram->getUniformLocation(SHADER_VARIABLE("scaleTexture"));
 
     // Texture
-    int seaTextureLocation      = m_shaderProgram->getUniformLocation("seaTex"); 
+    int seaTextureLocation      = m_shaderProgram->getUniformLocation(SHADER_VARIABLE("seaTex")); 
 
 
     //Send material uniform to GPU
@@ -128,7 +128,7 @@ void SeaRenderable::do_draw()
     if (seaTextureLocation != ShaderProgram::null_location)
 	{
         glcheck(glActiveTexture(GL_TEXTURE0));
-        glcheck(glBindTexture(GL_TEXTURE_2D, m_textureId));
+        glcheck(glBindTexture(GL_TEXTURE_2D, m_texture->getId()));
         glcheck(glUniform1i(seaTextureLocation, 0)); 
 	}
     
@@ -155,3 +155,13 @@ void SeaRenderable::do_animate( float time )
 void SeaRenderable::setMaterial(const MaterialPtr& material) {
     m_material = material;
 }
+
+unsigned int SeaRenderable::do_getTextureKey() const
+{
+    return m_texture->getId();
+}
+
+unsigned int SeaRenderable::do_getMeshKey() const
+{
+    return m_pBuffer;
+}
@@ -0,0 +1,175 @@
+/**
+ * @file SteeringField.cpp
+ *
+ * @see SteeringField.hpp
+ */
+
+#include "../../include/terrain/SteeringField.hpp"
+#include "../../include/terrain/MapUtils.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+/**
+ * @brief
+ * The distance given to the positions without any obstacle of a kind.
+ */
+static const float FAR_AWAY = 1e6f;
+
+SteeringField::SteeringField()
+    : m_size(0)
+{}
+
+void SteeringField::build(
+    const Biome* biomeMap,
+    const float* heightMap,
+    int effMapSize,
+    int mapScaling,
+    float maxSlope
+)
+{
+    /*
+     * The field has a texel per unit of length, read from the sampled maps
+     * every mapScaling texels.
+     */
+    m_size = std::max(effMapSize / mapScaling, 1);
+    int texelCount = m_size*m_size;
+    std::vector<char> sea(texelCount), slope(texelCount), lake(texelCount);
+
+    #pragma omp parallel for
+    for (int j = 0; j < m_size; j++) {
+        int down = std::max(j - 1, 0);
+        int up   = std::min(j + 1, m_size - 1);
+        for (int i = 0; i < m_size; i++) {
+            int left  = std::max(i - 1, 0);
+            int right = std::min(i + 1, m_size - 1);
+            auto mapIndex = [effMapSize, mapScaling](int fi, int fj) {
+                return std::min(fi*mapScaling, effMapSize - 1)
+                     + std::min(fj*mapScaling, effMapSize - 1)*effMapSize;
+            };
+
+            Biome biome = biomeMap[mapIndex(i, j)];
+            float dzx = (heightMap[mapIndex(right, j)] - heightMap[mapIndex(left, j)])
+                      / (float) std::max(right - left, 1);
+            float dzy = (heightMap[mapIndex(i, up)] - heightMap[mapIndex(i, down)])
+                      / (float) std::max(up - down, 1);
+
+            int t = i + j*m_size;
+            sea[t] = (biome == Sea);
+            slope[t] = (biome == Mountain) || (biome == Peak) || (dzx*dzx + dzy*dzy > maxSlope*maxSlope);
+            lake[t] = (biome == Lake);
+        }
+    }
+
+    /*
+     * The three obstacles are independent.
+     */
+    std::vector<glm::vec2> seaEscapes, slopeEscapes, lakeEscapes;
+    std::vector<float> seaDistances, slopeDistances, lakeDistances;
+    #pragma omp parallel sections
+    {
+        #pragma omp section
+        computeObstacle(sea, seaEscapes, seaDistances);
+        #pragma omp section
+        computeObstacle(slope, slopeEscapes, slopeDistances);
+        #pragma omp section
+        computeObstacle(lake, lakeEscapes, lakeDistances);
+    }
+
+    m_samples.resize(texelCount);
+    for (int t = 0; t < texelCount; t++) {
+        SteeringSample& sample = m_samples[t];
+        sample.seaEscape     = seaEscapes[t];
+        sample.seaDistance   = seaDistances[t];
+        sample.slopeEscape   = slopeEscapes[t];
+        sample.slopeDistance = slopeDistances[t];
+        sample.lakeEscape    = lakeEscapes[t];
+        sample.lakeDistance  = lakeDistances[t];
+    }
+}
+
+void SteeringField::computeObstacle(
+    const std::vector<char>& mask,
+    std::vector<glm::vec2>& escapes,
+    std::vector<float>& distances
+) const
+{
+    int texelCount = m_size*m_size;
+    std::vector<char> walkable(texelCount);
+    for (int t = 0; t < texelCount; t++) {
+        walkable[t] = !mask[t];
+    }
+
+    /*
+     * Outside the obstacle, the closest texel of the obstacle is escaped.
+     * Inside, the closest walkable texel is reached.
+     */
+    std::vector<int> closestObstacle, closestWalkable;
+    computeClosestTexels(mask, m_size, closestObstacle);
+    computeClosestTexels(walkable, m_size, closestWalkable);
+
+    escapes.resize(texelCount);
+    distances.resize(texelCount);
+    for (int t = 0; t < texelCount; t++) {
+        glm::vec2 position(t % m_size, t / m_size);
+        int closest = mask[t] ? closestWalkable[t] : closestObstacle[t];
+        if (closest < 0) {
+            escapes[t] = glm::vec2(0.0f);
+            distances[t] = mask[t] ? -FAR_AWAY : FAR_AWAY;
+            continue;
+        }
+
+        glm::vec2 offset = position - glm::vec2(closest % m_size, closest / m_size);
+        float distance = glm::length(offset);
+        if (mask[t]) {
+            escapes[t] = -offset / distance;
+            distances[t] = -distance;
+        } else {
+            escapes[t] = offset / distance;
+            distances[t] = distance;
+        }
+    }
+}
+
+SteeringSample SteeringField::sample(float x, float y) const
+{
+    if (m_samples.empty()) {
+        SteeringSample far = { glm::vec2(0.0f), FAR_AWAY, glm::vec2(0.0f), FAR_AWAY, glm::vec2(0.0f), FAR_AWAY };
+        return far;
+    }
+
+    float fx = glm::clamp(x, 0.0f, (float) (m_size - 1));
+    float fy = glm::clamp(y, 0.0f, (float) (m_size - 1));
+    int i0 = std::min((int) fx, m_size - 1);
+    int j0 = std::min((int) fy, m_size - 1);
+    int i1 = std::min(i0 + 1, m_size - 1);
+    int j1 = std::min(j0 + 1, m_size - 1);
+    float u = fx - (float) i0;
+    float v = fy - (float) j0;
+
+    const SteeringSample& s00 = m_samples[i0 + j0*m_size];
+    const SteeringSample& s10 = m_samples[i1 + j0*m_size];
+    const SteeringSample& s01 = m_samples[i0 + j1*m_size];
+    const SteeringSample& s11 = m_samples[i1 + j1*m_size];
+    float w00 = (1.0f - u)*(1.0f - v);
+    float w10 = u*(1.0f - v);
+    float w01 = (1.0f - u)*v;
+    float w11 = u*v;
+
+    SteeringSample result;
+    result.seaEscape     = w00*s00.seaEscape     + w10*s10.seaEscape     + w01*s01.seaEscape     + w11*s11.seaEscape;
+    result.seaDistance   = w00*s00.seaDistance   + w10*s10.seaDistance   + w01*s01.seaDistance   + w11*s11.seaDistance;
+    result.slopeEscape   = w00*s00.slopeEscape   + w10*s10.slopeEscape   + w01*s01.slopeEscape   + w11*s11.slopeEscape;
+    result.slopeDistance = w00*s00.slopeDistance + w10*s10.slopeDistance + w01*s01.slopeDistance + w11*s11.slopeDistance;
+    result.lakeEscape    = w00*s00.lakeEscape    + w10*s10.lakeEscape    + w01*s01.lakeEscape    + w11*s11.lakeEscape;
+    result.lakeDistance  = w00*s00.lakeDistance  + w10*s10.lakeDistance  + w01*s01.lakeDistance  + w11*s11.lakeDistance;
+
+    // The interpolated directions are shorter at the turns
+    float seaLength = glm::length(result.seaEscape);
+    float slopeLength = glm::length(result.slopeEscape);
+    float lakeLength = glm::length(result.lakeEscape);
+    result.seaEscape   = (seaLength > 1e-6f) ? result.seaEscape / seaLength : glm::vec2(0.0f);
+    result.slopeEscape = (slopeLength > 1e-6f) ? result.slopeEscape / slopeLength : glm::vec2(0.0f);
+    result.lakeEscape  = (lakeLength > 1e-6f) ? result.lakeEscape / lakeLength : glm::vec2(0.0f);
+    return result;
+}
@@ -75,12 +75,12 @@ BillBoardPlaneRenderable::BillBoardPlaneRenderable(
 void BillBoardPlaneRenderable::do_draw()
 {
     //Location
-    int colorLocation = m_shaderProgram->getAttributeLocation("vColor");
-    int shiftLocation = m_shaderProgram->getAttributeLocation("vShift");
-    int modelLocation = m_shaderProgram->getUniformLocation("modelMat");
-    int texSampleLoc = m_shaderProgram->getUniformLocation("texSampler");
-    int billboardPositionLocation = m_shaderProgram->getUniformLocation("billboard_world_position");
-    int billboardDimensionsLocation = m_shaderProgram->getUniformLocation("billboard_world_dimensions");
+    int colorLocation = m_shaderProgram->getAttributeLocation(SHADER_VARIABLE("vColor"));
+    int shiftLocation = m_shaderProgram->getAttributeLocation(SHADER_VARIABLE("vShift"));
+    int modelLocation = m_shaderProgram->getUniformLocation(SHADER_VARIABLE("modelMat"));
+    int texSampleLoc = m_shaderProgram->getUniformLocation(SHADER_VARIABLE("texSampler"));
+    int billboardPositionLocation = m_shaderProgram->getUniformLocation(SHADER_VARIABLE("billboard_world_position"));
+    int billboardDimensionsLocation = m_shaderProgram->getUniformLocation(SHADER_VARIABLE("billboard_world_dimensions"));
 
     //Send material uniform to GPU
     Material::sendToGPU(m_shaderProgram, m_material);
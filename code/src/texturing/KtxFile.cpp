@@ -0,0 +1,254 @@
+#include "./../../include/texturing/KtxFile.hpp"
+#include "./../../include/log.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <cstdint>
+#include <GL/glew.h>
+
+static const unsigned char ktxIdentifier[12] = {
+    0xAB, 0x4B, 0x54, 0x58, 0x20, 0x31, 0x31, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A
+};
+
+static const uint32_t ktxEndianness = 0x04030201;
+static const uint32_t ktxSwappedEndianness = 0x01020304;
+
+/**
+ * @brief Fields of the KTX header following the identifier.
+ */
+struct KtxHeader
+{
+    uint32_t endianness;
+    uint32_t glType;
+    uint32_t glTypeSize;
+    uint32_t glFormat;
+    uint32_t glInternalFormat;
+    uint32_t glBaseInternalFormat;
+    uint32_t pixelWidth;
+    uint32_t pixelHeight;
+    uint32_t pixelDepth;
+    uint32_t numberOfArrayElements;
+    uint32_t numberOfFaces;
+    uint32_t numberOfMipmapLevels;
+    uint32_t bytesOfKeyValueData;
+};
+
+static uint32_t swapBytes(uint32_t value)
+{
+    return ((value & 0x000000FF) << 24) | ((value & 0x0000FF00) << 8)
+         | ((value & 0x00FF0000) >> 8)  | ((value & 0xFF000000) >> 24);
+}
+
+static void swapData(std::vector<unsigned char>& data, unsigned int typeSize)
+{
+    if (typeSize < 2) {
+        return;
+    }
+    for (std::size_t i = 0; i + typeSize <= data.size(); i += typeSize) {
+        std::reverse(data.begin() + i, data.begin() + i + typeSize);
+    }
+}
+
+static void writeUint32(std::ofstream& file, uint32_t value)
+{
+    file.write(reinterpret_cast<const char*>(&value), sizeof(uint32_t));
+}
+
+bool KtxTexture::isCompressed() const
+{
+    return glType == 0;
+}
+
+unsigned int KtxTexture::getLevelWidth(unsigned int level) const
+{
+    return std::max(1u, width >> level);
+}
+
+unsigned int KtxTexture::getLevelHeight(unsigned int level) const
+{
+    return std::max(1u, height >> level);
+}
+
+std::size_t KtxTexture::getLevelSize(unsigned int level) const
+{
+    const std::size_t width = getLevelWidth(level);
+    const std::size_t height = getLevelHeight(level);
+    const std::size_t layerCount = std::max(1u, layers);
+
+    if (isCompressed()) {
+        // Blocks of 4x4 texels, of 8 bytes (BC1) or 16 bytes (BC3, BC7)
+        std::size_t blockSize = 0;
+        switch (glInternalFormat) {
+        case GL_COMPRESSED_RGB_S3TC_DXT1_EXT:
+        case GL_COMPRESSED_RGBA_S3TC_DXT1_EXT:
+        case GL_COMPRESSED_SRGB_S3TC_DXT1_EXT:
+        case GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT:
+            blockSize = 8;
+            break;
+        case GL_COMPRESSED_RGBA_S3TC_DXT3_EXT:
+        case GL_COMPRESSED_RGBA_S3TC_DXT5_EXT:
+        case GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT3_EXT:
+        case GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT:
+        case GL_COMPRESSED_RGBA_BPTC_UNORM:
+        case GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM:
+            blockSize = 16;
+            break;
+        default:
+            return 0;
+        }
+        return ((width + 3) / 4) * ((height + 3) / 4) * blockSize * layerCount;
+    }
+
+    std::size_t components = 0;
+    switch (glFormat) {
+    case GL_RED:
+        components = 1;
+        break;
+    case GL_RG:
+        components = 2;
+        break;
+    case GL_RGB:
+    case GL_BGR:
+        components = 3;
+        break;
+    case GL_RGBA:
+    case GL_BGRA:
+        components = 4;
+        break;
+    default:
+        return 0;
+    }
+    const std::size_t rowSize = (width * components * glTypeSize + 3) / 4 * 4;
+    return rowSize * height * layerCount;
+}
+
+bool read_ktx(const std::string& filename, KtxTexture& texture)
+{
+    std::ifstream file(filename.c_str(), std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    file.seekg(0, std::ios::end);
+    const std::streamoff fileSize = file.tellg();
+    file.seekg(0, std::ios::beg);
+
+    unsigned char identifier[12];
+    KtxHeader header;
+    file.read(reinterpret_cast<char*>(identifier), sizeof(identifier));
+    file.read(reinterpret_cast<char*>(&header), sizeof(KtxHeader));
+    if (!file || std::memcmp(identifier, ktxIdentifier, sizeof(identifier)) != 0) {
+        LOG(error, filename << " is not a KTX file");
+        return false;
+    }
+
+    bool swapped = false;
+    if (header.endianness == ktxSwappedEndianness) {
+        swapped = true;
+        uint32_t* fields = reinterpret_cast<uint32_t*>(&header);
+        for (unsigned int i = 0; i < sizeof(KtxHeader) / sizeof(uint32_t); ++i) {
+            fields[i] = swapBytes(fields[i]);
+        }
+    } else if (header.endianness != ktxEndianness) {
+        LOG(error, filename << " has an invalid endianness");
+        return false;
+    }
+
+    if (header.pixelWidth == 0 || header.pixelHeight == 0 || header.pixelDepth > 1 || header.numberOfFaces != 1) {
+        LOG(error, filename << " is not a 2D texture or a 2D texture array");
+        return false;
+    }
+
+    texture.glType = header.glType;
+    texture.glTypeSize = header.glTypeSize;
+    texture.glFormat = header.glFormat;
+    texture.glInternalFormat = header.glInternalFormat;
+    texture.glBaseInternalFormat = header.glBaseInternalFormat;
+    texture.width = header.pixelWidth;
+    texture.height = header.pixelHeight;
+    texture.layers = header.numberOfArrayElements;
+    texture.generateMipMap = (header.numberOfMipmapLevels == 0);
+
+    // The key/value pairs (orientation, writer, ...) are not used
+    file.seekg(header.bytesOfKeyValueData, std::ios::cur);
+
+    const unsigned int levels = std::max(1u, header.numberOfMipmapLevels);
+    if (texture.getLevelSize(0) == 0) {
+        LOG(error, filename << " has an unsupported format");
+        return false;
+    }
+
+    texture.levels.resize(levels);
+    for (unsigned int i = 0; i < levels; ++i) {
+        uint32_t imageSize = 0;
+        file.read(reinterpret_cast<char*>(&imageSize), sizeof(uint32_t));
+        if (swapped) {
+            imageSize = swapBytes(imageSize);
+        }
+        if (!file || file.tellg() + std::streamoff(imageSize) > fileSize) {
+            LOG(error, filename << " is truncated");
+            return false;
+        }
+        // The upload reads the number of bytes implied by the size and the format
+        if (imageSize != texture.getLevelSize(i)) {
+            LOG(error, filename << " has a level " << i << " of " << imageSize
+                << " bytes instead of " << texture.getLevelSize(i));
+            return false;
+        }
+
+        texture.levels[i].resize(imageSize);
+        file.read(reinterpret_cast<char*>(texture.levels[i].data()), imageSize);
+        if (swapped) {
+            swapData(texture.levels[i], texture.glTypeSize);
+        }
+
+        // Each level is aligned on 4 bytes
+        file.seekg(3 - ((imageSize + 3) % 4), std::ios::cur);
+    }
+
+    return true;
+}
+
+bool write_ktx(const std::string& filename, const KtxTexture& texture)
+{
+    std::ofstream file(filename.c_str(), std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    // Tell the readers that the first row is the bottom one
+    static const char orientationKey[] = "KTXorientation";
+    static const char orientationValue[] = "S=r,T=u";
+    const uint32_t keyValueSize = sizeof(orientationKey) + sizeof(orientationValue);
+    const uint32_t keyValuePadding = 3 - ((keyValueSize + 3) % 4);
+    const char padding[4] = { 0, 0, 0, 0 };
+
+    file.write(reinterpret_cast<const char*>(ktxIdentifier), sizeof(ktxIdentifier));
+    writeUint32(file, ktxEndianness);
+    writeUint32(file, texture.glType);
+    writeUint32(file, texture.glTypeSize);
+    writeUint32(file, texture.glFormat);
+    writeUint32(file, texture.glInternalFormat);
+    writeUint32(file, texture.glBaseInternalFormat);
+    writeUint32(file, texture.width);
+    writeUint32(file, texture.height);
+    writeUint32(file, 0);
+    writeUint32(file, texture.layers);
+    writeUint32(file, 1);
+    writeUint32(file, texture.generateMipMap ? 0 : texture.levels.size());
+    writeUint32(file, sizeof(uint32_t) + keyValueSize + keyValuePadding);
+
+    writeUint32(file, keyValueSize);
+    file.write(orientationKey, sizeof(orientationKey));
+    file.write(orientationValue, sizeof(orientationValue));
+    file.write(padding, keyValuePadding);
+
+    for (const std::vector<unsigned char>& level : texture.levels) {
+        writeUint32(file, level.size());
+        file.write(reinterpret_cast<const char*>(level.data()), level.size());
+        file.write(padding, 3 - ((level.size() + 3) % 4));
+    }
+
+    return bool(file);
+}
@@ -77,13 +77,13 @@ MipMapCubeRenderable::MipMapCubeRenderable(ShaderProgramPtr shaderProgram, std::
 void MipMapCubeRenderable::do_draw()
 {
     //Location
-    int positionLocation = m_shaderProgram->getAttributeLocation("vPosition");
-    int colorLocation = m_shaderProgram->getAttributeLocation("vColor");
-    int normalLocation = m_shaderProgram->getAttributeLocation("vNormal");
-    int modelLocation = m_shaderProgram->getUniformLocation("modelMat");
-    int nitLocation = m_shaderProgram->getUniformLocation("NIT");
-    int textureLocation = m_shaderProgram->getAttributeLocation("vTexCoord");
-    int texSampleLoc = m_shaderProgram->getUniformLocation("texSampler");
+    int positionLocation = m_shaderProgram->getAttributeLocation(SHADER_VARIABLE("vPosition"));
+    int colorLocation = m_shaderProgram->getAttributeLocation(SHADER_VARIABLE("vColor"));
+    int normalLocation = m_shaderProgram->getAttributeLocation(SHADER_VARIABLE("vNormal"));
+    int modelLocation = m_shaderProgram->getUniformLocation(SHADER_VARIABLE("modelMat"));
+    int nitLocation = m_shaderProgram->getUniformLocation(SHADER_VARIABLE("NIT"));
+    int textureLocation = m_shaderProgram->getAttributeLocation(SHADER_VARIABLE("vTexCoord"));
+    int texSampleLoc = m_shaderProgram->getUniformLocation(SHADER_VARIABLE("texSampler"));
 
     //Send material uniform to GPU
     Material::sendToGPU(m_shaderProgram, m_material);
@@ -85,16 +85,16 @@ MultiTexturedCubeRenderable::MultiTexturedCubeRenderable(ShaderProgramPtr shader
 void MultiTexturedCubeRenderable::do_draw()
 {
     //Location
-    int positionLocation = m_shaderProgram->getAttributeLocation("vPosition");
-    int colorLocation = m_shaderProgram->getAttributeLocation("vColor");
-    int normalLocation = m_shaderProgram->getAttributeLocation("vNormal");
-    int modelLocation = m_shaderProgram->getUniformLocation("modelMat");
-    int nitLocation = m_shaderProgram->getUniformLocation("NIT");
-    int blendingCoeffLocation = m_shaderProgram->getUniformLocation("blendingCoeff");
-    int textureLocation1 = m_shaderProgram->getAttributeLocation("vTexCoord1");
-    int textureLocation2 = m_shaderProgram->getAttributeLocation("vTexCoord2");
-    int texSampleLoc1 = m_shaderProgram->getUniformLocation("texSampler1");
-    int texSampleLoc2 = m_shaderProgram->getUniformLocation("texSampler2");
+    int positionLocation = m_shaderProgram->getAttributeLocation(SHADER_VARIABLE("vPosition"));
+    int colorLocation = m_shaderProgram->getAttributeLocation(SHADER_VARIABLE("vColor"));
+    int normalLocation = m_shaderProgram->getAttributeLocation(SHADER_VARIABLE("vNormal"));
+    int modelLocation = m_shaderProgram->getUniformLocation(SHADER_VARIABLE("modelMat"));
+    int nitLocation = m_shaderProgram->getUniformLocation(SHADER_VARIABLE("NIT"));
+    int blendingCoeffLocation = m_shaderProgram->getUniformLocation(SHADER_VARIABLE("blendingCoeff"));
+    int textureLocation1 = m_shaderProgram->getAttributeLocation(SHADER_VARIABLE("vTexCoord1"));
+    int textureLocation2 = m_shaderProgram->getAttributeLocation(SHADER_VARIABLE("vTexCoord2"));
+    int texSampleLoc1 = m_shaderProgram->getUniformLocation(SHADER_VARIABLE("texSampler1"));
+    int texSampleLoc2 = m_shaderProgram->getUniformLocation(SHADER_VARIABLE("texSampler2"));
 
     //Send material uniform to GPU
     Material::sendToGPU(m_shaderProgram, m_material);
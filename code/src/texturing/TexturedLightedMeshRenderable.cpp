@@ -1,7 +1,7 @@
 #include "./../../include/texturing/TexturedLightedMeshRenderable.hpp"
 #include "./../../include/gl_helper.hpp"
 #include "./../../include/log.hpp"
-#include "./../../include/Io.hpp"
+#include "./../../include/AssetManager.hpp"
 #include "./../../include/Utils.hpp"
 
 #include <glm/gtc/type_ptr.hpp>
@@ -14,15 +14,20 @@ TexturedLightedMeshRenderable::~TexturedLightedMeshRenderable()
     glcheck(glDeleteBuffers(1, &m_nBuffer));
     glcheck(glDeleteBuffers(1, &m_iBuffer));
     glcheck(glDeleteBuffers(1, &m_tBuffer));
-    glcheck(glDeleteTextures(1, &m_texId));
 }
 
 TexturedLightedMeshRenderable::TexturedLightedMeshRenderable(
     ShaderProgramPtr shaderProgram, const std::string& mesh_filename, const std::string& texture_filename ) :
     HierarchicalRenderable(shaderProgram),
-    m_pBuffer(0), m_cBuffer(0), m_nBuffer(0), m_iBuffer(0), m_tBuffer(0), m_texId( 0 )
+    m_pBuffer(0), m_cBuffer(0), m_nBuffer(0), m_iBuffer(0), m_tBuffer(0)
 {
-    read_obj(mesh_filename, m_positions, m_indices, m_normals, m_texCoords);
+    MeshDataPtr mesh = AssetManager::getMesh(mesh_filename);
+    if (mesh) {
+        m_positions = mesh->positions;
+        m_indices = mesh->indices;
+        m_normals = mesh->normals;
+        m_texCoords = mesh->texCoords;
+    }
     m_colors.resize( m_positions.size(), glm::vec4(1.0,1.0,1.0,1.0) );
 
     //Create buffers
@@ -44,34 +49,21 @@ TexturedLightedMeshRenderable::TexturedLightedMeshRenderable(
     glcheck(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_iBuffer));
     glcheck(glBufferData(GL_ELEMENT_ARRAY_BUFFER, m_indices.size()*sizeof(unsigned int), m_indices.data(), GL_STATIC_DRAW));
 
-    // create and setup the texture
-    glcheck(glGenTextures(1, &m_texId));
-    glcheck(glBindTexture(GL_TEXTURE_2D, m_texId));
-    glcheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST));
-    glcheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST));
-    glcheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE));
-    glcheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE));
-
-    // load the texture
-    sf::Image image;
-    image.loadFromFile(texture_filename);
-    image.flipVertically(); // sfml inverts the v axis... put the image in OpenGL convention: lower left corner is (0,0)
-    glcheck(glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA32F, image.getSize().x, image.getSize().y, 0, GL_RGBA, GL_UNSIGNED_BYTE, (const GLvoid*)image.getPixelsPtr()));
-
-    //Release the texture
-    glcheck(glBindTexture(GL_TEXTURE_2D, 0));
+    // get the texture, shared with the other renderables using the same file
+    // (nearest filtering, the texture may be an atlas, like the one of the skybox)
+    m_texture = AssetManager::getTexture(texture_filename, false, NEAREST_FILTERING);
 }
 
 void TexturedLightedMeshRenderable::do_draw()
 {
     //Location
-    int positionLocation = m_shaderProgram->getAttributeLocation("vPosition");
-    int colorLocation = m_shaderProgram->getAttributeLocation("vColor");
-    int normalLocation = m_shaderProgram->getAttributeLocation("vNormal");
-    int texcoordLocation = m_shaderProgram->getAttributeLocation("vTexCoord");
-    int modelLocation = m_shaderProgram->getUniformLocation("modelMat");
-    int nitLocation = m_shaderProgram->getUniformLocation("NIT");
-    int texsamplerLocation = m_shaderProgram->getUniformLocation("texSampler");
+    int positionLocation = m_shaderProgram->getAttributeLocation(SHADER_VARIABLE("vPosition"));
+    int colorLocation = m_shaderProgram->getAttributeLocation(SHADER_VARIABLE("vColor"));
+    int normalLocation = m_shaderProgram->getAttributeLocation(SHADER_VARIABLE("vNormal"));
+    int texcoordLocation = m_shaderProgram->getAttributeLocation(SHADER_VARIABLE("vTexCoord"));
+    int modelLocation = m_shaderProgram->getUniformLocation(SHADER_VARIABLE("modelMat"));
+    int nitLocation = m_shaderProgram->getUniformLocation(SHADER_VARIABLE("NIT"));
+    int texsamplerLocation = m_shaderProgram->getUniformLocation(SHADER_VARIABLE("texSampler"));
 
     //Send material uniform to GPU
     Material::sendToGPU(m_shaderProgram, m_material);
@@ -116,7 +108,7 @@ void TexturedLightedMeshRenderable::do_draw()
     if(texcoordLocation != ShaderProgram::null_location)
     {
         glcheck(glActiveTexture(GL_TEXTURE0));
-        glcheck(glBindTexture(GL_TEXTURE_2D, m_texId));
+        glcheck(glBindTexture(GL_TEXTURE_2D, m_texture ? m_texture->getId() : 0));
         //Send "texSampler" to Textured Unit 0
         glcheck(glUniform1i(texsamplerLocation, 0));
         glcheck(glEnableVertexAttribArray(texcoordLocation));
@@ -155,3 +147,13 @@ void TexturedLightedMeshRenderable::setMaterial(const MaterialPtr& material)
 {
     m_material = material;
 }
+
+unsigned int TexturedLightedMeshRenderable::do_getTextureKey() const
+{
+    return m_texture->getId();
+}
+
+unsigned int TexturedLightedMeshRenderable::do_getMeshKey() const
+{
+    return m_pBuffer;
+}
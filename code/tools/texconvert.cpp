@@ -0,0 +1,404 @@
+/**@file
+ * @brief Offline converter from images to KTX texture containers.
+ *
+ * Usage:
+ * \code
+ * texconvert [--format rgba8|bc1|bc3] [--srgb] [--levels n] [--mipmaps n] [--array] output.ktx input...
+ * \endcode
+ *
+ * Without --array, a single image is expected and a 2D texture is written.
+ * With --array, each input image becomes a layer of a 2D texture array: all
+ * of them must have the same size. The mip map levels are computed by box
+ * filtering the input images, down to 1x1 unless --levels is given.
+ *
+ * With --mipmaps n, the levels are not computed: each image (or each layer)
+ * is given as its n first mip map levels, from the base one, and they are
+ * packed as they are. This keeps the chains "name2.png", ..., "name8.png"
+ * of the textures directory, which are also loaded when no container exists.
+ *
+ * The bc1 format (GL_COMPRESSED_RGB_S3TC_DXT1_EXT, 4 bits per texel) ignores
+ * the alpha channel, the bc3 one (GL_COMPRESSED_RGBA_S3TC_DXT5_EXT, 8 bits
+ * per texel) keeps it. BC7 containers produced by other tools can be read by
+ * the application but are not written by this one.
+ */
+
+#include "./../include/texturing/KtxFile.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <GL/glew.h>
+#include <SFML/Graphics/Image.hpp>
+
+/**
+ * @brief Image with floating point channels, used to compute the mip maps.
+ */
+struct FloatImage
+{
+    unsigned int width;
+    unsigned int height;
+    std::vector<float> texels; // 4 channels per texel, linear colors
+};
+
+static float toLinear(unsigned char value, bool sRGB)
+{
+    float c = value / 255.0f;
+    if (!sRGB) {
+        return c;
+    }
+    return c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+}
+
+static unsigned char fromLinear(float c, bool sRGB)
+{
+    c = std::min(1.0f, std::max(0.0f, c));
+    if (sRGB) {
+        c = c <= 0.0031308f ? c * 12.92f : 1.055f * std::pow(c, 1.0f / 2.4f) - 0.055f;
+    }
+    return (unsigned char) (c * 255.0f + 0.5f);
+}
+
+static FloatImage toFloatImage(const sf::Image& image, bool sRGB)
+{
+    FloatImage result;
+    result.width = image.getSize().x;
+    result.height = image.getSize().y;
+    result.texels.resize(4 * result.width * result.height);
+    const unsigned char* pixels = image.getPixelsPtr();
+    for (std::size_t i = 0; i < result.texels.size(); ++i) {
+        // The alpha channel is never sRGB encoded
+        result.texels[i] = toLinear(pixels[i], sRGB && (i % 4) != 3);
+    }
+    return result;
+}
+
+static std::vector<unsigned char> toBytes(const FloatImage& image, bool sRGB)
+{
+    std::vector<unsigned char> result(image.texels.size());
+    for (std::size_t i = 0; i < result.size(); ++i) {
+        result[i] = fromLinear(image.texels[i], sRGB && (i % 4) != 3);
+    }
+    return result;
+}
+
+static FloatImage downsample(const FloatImage& image)
+{
+    FloatImage result;
+    result.width = std::max(1u, image.width / 2);
+    result.height = std::max(1u, image.height / 2);
+    result.texels.resize(4 * result.width * result.height);
+    for (unsigned int y = 0; y < result.height; ++y) {
+        for (unsigned int x = 0; x < result.width; ++x) {
+            // The 2x2 footprint is clamped for the dimensions already reduced to 1
+            const unsigned int x0 = std::min(2 * x, image.width - 1), x1 = std::min(2 * x + 1, image.width - 1);
+            const unsigned int y0 = std::min(2 * y, image.height - 1), y1 = std::min(2 * y + 1, image.height - 1);
+            for (unsigned int c = 0; c < 4; ++c) {
+                result.texels[4 * (y * result.width + x) + c] = 0.25f * (
+                    image.texels[4 * (y0 * image.width + x0) + c] + image.texels[4 * (y0 * image.width + x1) + c] +
+                    image.texels[4 * (y1 * image.width + x0) + c] + image.texels[4 * (y1 * image.width + x1) + c]);
+            }
+        }
+    }
+    return result;
+}
+
+static uint16_t to565(const float color[3])
+{
+    const unsigned int r = std::min(31, std::max(0, int(color[0] * 31.0f / 255.0f + 0.5f)));
+    const unsigned int g = std::min(63, std::max(0, int(color[1] * 63.0f / 255.0f + 0.5f)));
+    const unsigned int b = std::min(31, std::max(0, int(color[2] * 31.0f / 255.0f + 0.5f)));
+    return (r << 11) | (g << 5) | b;
+}
+
+static void from565(uint16_t value, float color[3])
+{
+    color[0] = ((value >> 11) & 31) * 255.0f / 31.0f;
+    color[1] = ((value >> 5) & 63) * 255.0f / 63.0f;
+    color[2] = (value & 31) * 255.0f / 31.0f;
+}
+
+/**
+ * @brief Encode the colors of a 4x4 block in the 4 colors mode of BC1.
+ *
+ * The end points are the extreme colors along the principal axis of the
+ * block, slightly moved inward to reduce the mean error.
+ */
+static void encodeColorBlock(const unsigned char block[64], unsigned char* output)
+{
+    float mean[3] = { 0, 0, 0 };
+    for (unsigned int i = 0; i < 16; ++i) {
+        for (unsigned int c = 0; c < 3; ++c) {
+            mean[c] += block[4 * i + c] / 16.0f;
+        }
+    }
+
+    float covariance[6] = { 0, 0, 0, 0, 0, 0 };
+    for (unsigned int i = 0; i < 16; ++i) {
+        const float r = block[4 * i] - mean[0], g = block[4 * i + 1] - mean[1], b = block[4 * i + 2] - mean[2];
+        covariance[0] += r * r; covariance[1] += r * g; covariance[2] += r * b;
+        covariance[3] += g * g; covariance[4] += g * b; covariance[5] += b * b;
+    }
+
+    // Principal axis by power iteration
+    float axis[3] = { 1, 1, 1 };
+    for (unsigned int iteration = 0; iteration < 8; ++iteration) {
+        const float x = covariance[0] * axis[0] + covariance[1] * axis[1] + covariance[2] * axis[2];
+        const float y = covariance[1] * axis[0] + covariance[3] * axis[1] + covariance[4] * axis[2];
+        const float z = covariance[2] * axis[0] + covariance[4] * axis[1] + covariance[5] * axis[2];
+        const float norm = std::max(std::max(std::fabs(x), std::fabs(y)), std::fabs(z));
+        if (norm < 1e-6f) {
+            break;
+        }
+        axis[0] = x / norm; axis[1] = y / norm; axis[2] = z / norm;
+    }
+
+    float minProjection = 1e30f, maxProjection = -1e30f;
+    for (unsigned int i = 0; i < 16; ++i) {
+        const float projection = (block[4 * i] - mean[0]) * axis[0]
+                               + (block[4 * i + 1] - mean[1]) * axis[1]
+                               + (block[4 * i + 2] - mean[2]) * axis[2];
+        minProjection = std::min(minProjection, projection);
+        maxProjection = std::max(maxProjection, projection);
+    }
+    const float axisLength2 = axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2];
+    const float inset = (maxProjection - minProjection) / 16.0f;
+    float maxColor[3], minColor[3];
+    for (unsigned int c = 0; c < 3; ++c) {
+        maxColor[c] = mean[c] + axis[c] * (maxProjection - inset) / axisLength2;
+        minColor[c] = mean[c] + axis[c] * (minProjection + inset) / axisLength2;
+    }
+
+    uint16_t color0 = to565(maxColor);
+    uint16_t color1 = to565(minColor);
+    if (color0 < color1) {
+        std::swap(color0, color1);
+    }
+
+    float palette[4][3];
+    from565(color0, palette[0]);
+    from565(color1, palette[1]);
+    for (unsigned int c = 0; c < 3; ++c) {
+        palette[2][c] = (2.0f * palette[0][c] + palette[1][c]) / 3.0f;
+        palette[3][c] = (palette[0][c] + 2.0f * palette[1][c]) / 3.0f;
+    }
+
+    uint32_t indices = 0;
+    if (color0 != color1) {
+        for (unsigned int i = 0; i < 16; ++i) {
+            unsigned int best = 0;
+            float bestDistance = 1e30f;
+            for (unsigned int p = 0; p < 4; ++p) {
+                float distance = 0;
+                for (unsigned int c = 0; c < 3; ++c) {
+                    const float d = block[4 * i + c] - palette[p][c];
+                    distance += d * d;
+                }
+                if (distance < bestDistance) {
+                    bestDistance = distance;
+                    best = p;
+                }
+            }
+            indices |= best << (2 * i);
+        }
+    }
+
+    output[0] = color0 & 0xFF; output[1] = color0 >> 8;
+    output[2] = color1 & 0xFF; output[3] = color1 >> 8;
+    for (unsigned int i = 0; i < 4; ++i) {
+        output[4 + i] = (indices >> (8 * i)) & 0xFF;
+    }
+}
+
+/**
+ * @brief Encode the alpha channel of a 4x4 block in the 8 values mode of BC3.
+ */
+static void encodeAlphaBlock(const unsigned char block[64], unsigned char* output)
+{
+    unsigned char alpha0 = 0, alpha1 = 255;
+    for (unsigned int i = 0; i < 16; ++i) {
+        alpha0 = std::max(alpha0, block[4 * i + 3]);
+        alpha1 = std::min(alpha1, block[4 * i + 3]);
+    }
+
+    float palette[8];
+    palette[0] = alpha0;
+    palette[1] = alpha1;
+    for (unsigned int p = 1; p < 7; ++p) {
+        palette[p + 1] = ((7 - p) * alpha0 + p * alpha1) / 7.0f;
+    }
+
+    uint64_t indices = 0;
+    if (alpha0 != alpha1) {
+        for (unsigned int i = 0; i < 16; ++i) {
+            unsigned int best = 0;
+            for (unsigned int p = 1; p < 8; ++p) {
+                if (std::fabs(block[4 * i + 3] - palette[p]) < std::fabs(block[4 * i + 3] - palette[best])) {
+                    best = p;
+                }
+            }
+            indices |= uint64_t(best) << (3 * i);
+        }
+    }
+
+    output[0] = alpha0;
+    output[1] = alpha1;
+    for (unsigned int i = 0; i < 6; ++i) {
+        output[2 + i] = (indices >> (8 * i)) & 0xFF;
+    }
+}
+
+/**
+ * @brief Compress an RGBA8 image in BC1 or BC3 blocks.
+ *
+ * The texels of the incomplete blocks on the borders are clamped.
+ */
+static std::vector<unsigned char> compress(const std::vector<unsigned char>& texels,
+                                           unsigned int width, unsigned int height, bool alpha)
+{
+    const unsigned int blockSize = alpha ? 16 : 8;
+    const unsigned int blocksX = (width + 3) / 4, blocksY = (height + 3) / 4;
+    std::vector<unsigned char> result(blocksX * blocksY * blockSize);
+
+    unsigned char block[64];
+    for (unsigned int by = 0; by < blocksY; ++by) {
+        for (unsigned int bx = 0; bx < blocksX; ++bx) {
+            for (unsigned int i = 0; i < 16; ++i) {
+                const unsigned int x = std::min(4 * bx + i % 4, width - 1);
+                const unsigned int y = std::min(4 * by + i / 4, height - 1);
+                std::memcpy(block + 4 * i, &texels[4 * (y * width + x)], 4);
+            }
+            unsigned char* output = &result[(by * blocksX + bx) * blockSize];
+            if (alpha) {
+                encodeAlphaBlock(block, output);
+                output += 8;
+            }
+            encodeColorBlock(block, output);
+        }
+    }
+    return result;
+}
+
+static void usage()
+{
+    std::cerr << "Usage: texconvert [--format rgba8|bc1|bc3] [--srgb] [--levels n] [--mipmaps n] [--array] output.ktx input..." << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    std::string format = "rgba8";
+    bool sRGB = false;
+    bool array = false;
+    unsigned int maxLevels = 0;
+    unsigned int givenLevels = 0;
+    std::vector<std::string> files;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string argument = argv[i];
+        if (argument == "--format" && i + 1 < argc) {
+            format = argv[++i];
+        } else if (argument == "--srgb") {
+            sRGB = true;
+        } else if (argument == "--array") {
+            array = true;
+        } else if (argument == "--levels" && i + 1 < argc) {
+            maxLevels = std::atoi(argv[++i]);
+        } else if (argument == "--mipmaps" && i + 1 < argc) {
+            givenLevels = std::atoi(argv[++i]);
+        } else {
+            files.push_back(argument);
+        }
+    }
+
+    // Number of images per layer: its base level, or all its levels with --mipmaps
+    const unsigned int imagesPerLayer = givenLevels ? givenLevels : 1;
+    const unsigned int inputs = files.size() > 1 ? files.size() - 1 : 0;
+    if (inputs == 0 || inputs % imagesPerLayer != 0 || (!array && inputs != imagesPerLayer)
+        || (format != "rgba8" && format != "bc1" && format != "bc3")) {
+        usage();
+        return EXIT_FAILURE;
+    }
+
+    KtxTexture texture;
+    if (format == "rgba8") {
+        texture.glType = GL_UNSIGNED_BYTE;
+        texture.glTypeSize = 1;
+        texture.glFormat = GL_RGBA;
+        texture.glInternalFormat = sRGB ? GL_SRGB8_ALPHA8 : GL_RGBA8;
+        texture.glBaseInternalFormat = GL_RGBA;
+    } else {
+        texture.glType = 0;
+        texture.glTypeSize = 1;
+        texture.glFormat = 0;
+        if (format == "bc1") {
+            texture.glInternalFormat = sRGB ? GL_COMPRESSED_SRGB_S3TC_DXT1_EXT : GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+            texture.glBaseInternalFormat = GL_RGB;
+        } else {
+            texture.glInternalFormat = sRGB ? GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT : GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+            texture.glBaseInternalFormat = GL_RGBA;
+        }
+    }
+    texture.layers = array ? inputs / imagesPerLayer : 0;
+    texture.generateMipMap = false;
+
+    // The levels of each layer, read or computed
+    std::vector< std::vector<FloatImage> > layers(inputs / imagesPerLayer);
+    for (unsigned int i = 0; i < inputs; ++i) {
+        const std::string& file = files[i + 1];
+        sf::Image image;
+        if (!image.loadFromFile(file)) {
+            return EXIT_FAILURE;
+        }
+        image.flipVertically(); // put the image in OpenGL convention: lower left corner is (0,0)
+
+        std::vector<FloatImage>& levels = layers[i / imagesPerLayer];
+        levels.push_back(toFloatImage(image, sRGB));
+
+        const FloatImage& base = layers.front().front();
+        const unsigned int level = levels.size() - 1;
+        if (levels.back().width != std::max(1u, base.width >> level) || levels.back().height != std::max(1u, base.height >> level)) {
+            std::cerr << file << " does not have the size of the level " << level << " of " << files[1] << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+    texture.width = layers.front().front().width;
+    texture.height = layers.front().front().height;
+
+    unsigned int levels = givenLevels;
+    if (!levels) {
+        levels = 1;
+        for (unsigned int size = std::max(texture.width, texture.height); size > 1; size /= 2) {
+            ++levels;
+        }
+        if (maxLevels) {
+            levels = std::min(levels, maxLevels);
+        }
+        for (std::vector<FloatImage>& layer : layers) {
+            while (layer.size() < levels) {
+                layer.push_back(downsample(layer.back()));
+            }
+        }
+    }
+
+    texture.levels.resize(levels);
+    for (unsigned int level = 0; level < levels; ++level) {
+        for (const std::vector<FloatImage>& layer : layers) {
+            const FloatImage& image = layer[level];
+            std::vector<unsigned char> texels = toBytes(image, sRGB);
+            if (format != "rgba8") {
+                texels = compress(texels, image.width, image.height, format == "bc3");
+            }
+            texture.levels[level].insert(texture.levels[level].end(), texels.begin(), texels.end());
+        }
+    }
+
+    if (!write_ktx(files[0], texture)) {
+        std::cerr << "cannot write " << files[0] << std::endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,60 @@
+#!/bin/bash
+
+# Script to pack the mip mapped textures of the terrain
+# into KTX containers, with the texconvert tool.
+#
+# Each chain "name2.png", ..., "name8.png" loaded by the application is
+# replaced by a single "name.ktx" file, holding the same mip map levels in
+# BC1 blocks. The six biome chains are also packed into the texture array
+# "shutter_texture_biomes.ktx", in the order used by the map renderable:
+# sea, sand, plains, lake, mountain, peak.
+#
+# Parameters :
+#     $1 : Path to the texconvert executable
+#     $2 : Path to the textures directory (default : ../code/textures)
+#     $3 : Format of the containers (default : bc1)
+
+
+# Testing the command line
+if [ "$#" -eq 0 -o "$#" -ge 4 ]; then
+    echo "Wrong number of arguments"
+    echo "Expected : texconvert [textures=../code/textures] [format=bc1]"
+    exit 1
+fi
+
+# Testing the converter
+if [ ! -x "$1" ]; then
+    echo "texconvert not found"
+    exit 1
+fi
+
+TEXCONVERT=$(readlink -f "$1")
+TEXTURES="${2:-../code/textures}"
+FORMAT="${3:-bc1}"
+
+# Levels of the chains loaded by the renderables
+LEVELS=$(seq 2 8)
+
+# Converting each chain, its levels being packed as they are
+for CHAIN in sand_sea sand_beach grass lake mountain snow water water_lake
+do
+    FILES=""
+    for i in $LEVELS
+    do
+	FILES="$FILES $TEXTURES/shutter_texture_$CHAIN$i.png"
+    done
+    "$TEXCONVERT" --format "$FORMAT" --mipmaps 7 \
+    	"$TEXTURES"/shutter_texture_"$CHAIN".ktx $FILES || exit 1
+done
+
+# Packing the biomes, each layer being given by its chain
+FILES=""
+for CHAIN in sand_sea sand_beach grass lake mountain snow
+do
+    for i in $LEVELS
+    do
+	FILES="$FILES $TEXTURES/shutter_texture_$CHAIN$i.png"
+    done
+done
+"$TEXCONVERT" --format "$FORMAT" --mipmaps 7 --array \
+    "$TEXTURES"/shutter_texture_biomes.ktx $FILES || exit 1